@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -117,6 +118,68 @@ static void BM_ArenaFuseBalanced(benchmark::State& state) {
 }
 BENCHMARK(BM_ArenaFuseBalanced)->Range(2, 128);
 
+// A long-lived arena that every thread fuses its short-lived arenas into, as
+// the Python and Rust bindings do.  It is replaced periodically so that the
+// fused group (which only shrinks when the whole group is freed) stays small.
+struct SharedFuseTarget {
+  std::mutex mu;
+  upb_Arena* arena = nullptr;
+
+  upb_Arena* Acquire(const void* owner) {
+    std::lock_guard<std::mutex> lock(mu);
+    if (!arena) arena = upb_Arena_New();
+    upb_Arena_IncRefFor(arena, owner);
+    return arena;
+  }
+
+  void Replace() {
+    upb_Arena* fresh = upb_Arena_New();
+    upb_Arena* old;
+    {
+      std::lock_guard<std::mutex> lock(mu);
+      old = arena;
+      arena = fresh;
+    }
+    if (old) upb_Arena_Free(old);
+  }
+};
+
+static SharedFuseTarget shared_fuse_target;
+
+static void BM_ArenaFuseMultiThreaded(benchmark::State& state) {
+  const void* owner = &state;
+  upb_Arena* shared = shared_fuse_target.Acquire(owner);
+  size_t i = 0;
+  for (auto _ : state) {
+    upb_Arena* arena = upb_Arena_New();
+    upb_Arena_Malloc(arena, 16);
+    upb_Arena_Fuse(shared, arena);
+    upb_Arena_Free(arena);
+    if (++i % 1024 == 0) {
+      if (state.thread_index() == 0) shared_fuse_target.Replace();
+      upb_Arena_DecRefFor(shared, owner);
+      shared = shared_fuse_target.Acquire(owner);
+    }
+  }
+  upb_Arena_DecRefFor(shared, owner);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ArenaFuseMultiThreaded)->ThreadRange(1, 16)->UseRealTime();
+
+// Many threads taking and dropping refs on the same fused group, which is what
+// every message wrapper object in the bindings does.
+static void BM_ArenaRefMultiThreaded(benchmark::State& state) {
+  const void* owner = &state;
+  upb_Arena* shared = shared_fuse_target.Acquire(owner);
+  for (auto _ : state) {
+    upb_Arena_IncRefFor(shared, owner);
+    upb_Arena_DecRefFor(shared, owner);
+  }
+  upb_Arena_DecRefFor(shared, owner);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ArenaRefMultiThreaded)->ThreadRange(1, 16)->UseRealTime();
+
 enum LoadDescriptorMode {
   NoLayout,
   WithLayout,
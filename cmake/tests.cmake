@@ -195,6 +195,38 @@ add_test(NAME lazily-build-dependencies-test
   COMMAND lazily-build-dependencies-test ${protobuf_GTEST_ARGS}
   WORKING_DIRECTORY ${protobuf_SOURCE_DIR})
 
+# These protos are generated with a split map, so that the message tests also
+# run against split messages.
+set(split_message_test_map
+  ${protobuf_SOURCE_DIR}/src/google/protobuf/unittest_split_map.txt)
+protobuf_generate(
+  PROTOS ${split_message_test_protos_files}
+  LANGUAGE cpp
+  OUT_VAR split_message_test_proto_files
+  IMPORT_DIRS ${protobuf_SOURCE_DIR}/src
+  PLUGIN_OPTIONS split_map_file=${split_message_test_map}
+  DEPENDENCIES ${split_message_test_map}
+)
+
+add_executable(split-message-test
+  ${split_message_test_files}
+  ${split_message_test_proto_files}
+  ${common_test_files}
+)
+target_link_libraries(split-message-test
+  libtest_common
+  libtest_common_lite
+  ${protobuf_LIB_PROTOC}
+  ${protobuf_LIB_PROTOBUF}
+  ${protobuf_ABSL_USED_TARGETS}
+  ${protobuf_ABSL_USED_TEST_TARGETS}
+  GTest::gmock_main
+)
+
+add_test(NAME split-message-test
+  COMMAND split-message-test ${protobuf_GTEST_ARGS}
+  WORKING_DIRECTORY ${protobuf_SOURCE_DIR})
+
 if (protobuf_BUILD_LIBUPB)
   set(upb_test_proto_genfiles)
   foreach(proto_file ${upb_test_protos_files} ${descriptor_proto_proto_srcs})
@@ -302,6 +302,19 @@ class PROTOBUF_EXPORT Any final : public ::google::protobuf::Message
   ::std::string* PROTOBUF_NONNULL _internal_mutable_value();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.type_url())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Any::clear_type_url>(
+          msg, "type_url", msg.type_url(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_BYTES,
+                                 ::google::protobuf::internal::kVisitSingular, &Any::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Any)
  private:
   class _Internal;
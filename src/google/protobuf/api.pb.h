@@ -254,6 +254,19 @@ class PROTOBUF_EXPORT Mixin final : public ::google::protobuf::Message
   ::std::string* PROTOBUF_NONNULL _internal_mutable_root();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Mixin::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.root())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Mixin::clear_root>(
+          msg, "root", msg.root(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Mixin)
  private:
   class _Internal;
@@ -552,6 +565,49 @@ class PROTOBUF_EXPORT Method final : public ::google::protobuf::Message
   void _internal_set_syntax(::google::protobuf::Syntax value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.request_type_url())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_request_type_url>(
+          msg, "request_type_url", msg.request_type_url(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.request_streaming())) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_request_streaming>(
+          msg, "request_streaming", msg.request_streaming(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.response_type_url())) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_response_type_url>(
+          msg, "response_type_url", msg.response_type_url(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.response_streaming())) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_response_streaming>(
+          msg, "response_streaming", msg.response_streaming(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Method::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.syntax())) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_syntax>(
+          msg, "syntax", msg.syntax(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.edition())) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Method::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Method)
  private:
   class _Internal;
@@ -873,6 +929,49 @@ class PROTOBUF_EXPORT Api final : public ::google::protobuf::Message
   void _internal_set_syntax(::google::protobuf::Syntax value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Api::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.methods_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Api::clear_methods>(
+          msg, "methods", msg.methods(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Api::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.version())) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Api::clear_version>(
+          msg, "version", msg.version(), visitor);
+    }
+    if (msg.has_source_context()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &Api::clear_source_context>(
+          msg, "source_context", msg.source_context(), visitor);
+    }
+    if (msg.mixins_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Api::clear_mixins>(
+          msg, "mixins", msg.mixins(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.syntax())) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Api::clear_syntax>(
+          msg, "syntax", msg.syntax(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.edition())) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Api::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Api)
  private:
   class _Internal;
@@ -104,9 +104,9 @@ TaggedStringPtr TaggedStringPtr::ForceCopy(Arena* arena) const {
 
 void ArenaStringPtr::Set(absl::string_view value, Arena* arena) {
   ScopedCheckPtrInvariants check(&tagged_ptr_);
-  if (IsDefault()) {
+  if (!tagged_ptr_.IsMutable()) {
     // If we're not on an arena, skip straight to a true string to avoid
-    // possible copy cost later.
+    // possible copy cost later. Shared values are replaced, not assigned.
     tagged_ptr_ = arena != nullptr ? CreateArenaString(*arena, value)
                                    : CreateString(value);
   } else {
@@ -129,9 +129,9 @@ void ArenaStringPtr::Set(absl::string_view value, Arena* arena) {
 template <>
 void ArenaStringPtr::Set(const std::string& value, Arena* arena) {
   ScopedCheckPtrInvariants check(&tagged_ptr_);
-  if (IsDefault()) {
+  if (!tagged_ptr_.IsMutable()) {
     // If we're not on an arena, skip straight to a true string to avoid
-    // possible copy cost later.
+    // possible copy cost later. Shared values are replaced, not assigned.
     tagged_ptr_ = arena != nullptr ? CreateArenaString(*arena, value)
                                    : CreateString(value);
   } else {
@@ -153,14 +153,9 @@ void ArenaStringPtr::Set(const std::string& value, Arena* arena) {
 
 void ArenaStringPtr::Set(std::string&& value, Arena* arena) {
   ScopedCheckPtrInvariants check(&tagged_ptr_);
-  if (IsDefault()) {
+  if (!tagged_ptr_.IsMutable()) {
     NewString(arena, std::move(value));
-  } else if (IsFixedSizeArena()) {
-    std::string* current = tagged_ptr_.Get();
-    auto* s = new (current) std::string(std::move(value));
-    arena->OwnDestructor(s);
-    tagged_ptr_.SetMutableArena(s);
-  } else /* !IsFixedSizeArena() */ {
+  } else {
     *UnsafeMutablePointer() = std::move(value);
   }
 }
@@ -189,7 +184,7 @@ std::string* ArenaStringPtr::MutableNoCopy(Arena* arena) {
   if (tagged_ptr_.IsMutable()) {
     return tagged_ptr_.Get();
   } else {
-    ABSL_DCHECK(IsDefault());
+    ABSL_DCHECK(IsDefault() || IsShared());
     // Allocate empty. The contents are not relevant.
     return NewString(arena);
   }
@@ -198,6 +193,10 @@ std::string* ArenaStringPtr::MutableNoCopy(Arena* arena) {
 template <typename... Lazy>
 std::string* ArenaStringPtr::MutableSlow(::google::protobuf::Arena* arena,
                                          const Lazy&... lazy_default) {
+  if (IsShared()) {
+    // Copy on write: the shared value is left untouched.
+    return NewString(arena, Get());
+  }
   ABSL_DCHECK(IsDefault());
 
   // For empty defaults, this ends up calling the default constructor which is
@@ -245,6 +244,9 @@ void ArenaStringPtr::ClearToEmpty() {
   ScopedCheckPtrInvariants check(&tagged_ptr_);
   if (IsDefault()) {
     // Already set to default -- do nothing.
+  } else if (IsShared()) {
+    // Stop sharing rather than clearing the shared value.
+    InitDefault();
   } else {
     // Unconditionally mask away the tag.
     //
@@ -261,6 +263,8 @@ void ArenaStringPtr::ClearToDefault(const LazyString& default_value,
   (void)arena;
   if (IsDefault()) {
     // Already set to default -- do nothing.
+  } else if (IsShared()) {
+    InitDefault();
   } else {
     UnsafeMutablePointer()->assign(default_value.get());
   }
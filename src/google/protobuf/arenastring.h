@@ -100,6 +100,13 @@ class PROTOBUF_EXPORT TaggedStringPtr {
     // updates to the content that fit inside the existing capacity.
     // Fixed size arena strings must never be deleted or destroyed.
     kFixedSizeArena = kArenaBit,
+
+    // Shared strings are immutable and not owned: the string instance belongs
+    // to another ArenaStringPtr on the same arena, which must outlive this
+    // instance and must not modify the value while it is shared. Shared
+    // strings are copied on their first mutation and are never deleted or
+    // destroyed, which is why they share the fixed size arena representation.
+    kShared = kFixedSizeArena,
   };
 
   TaggedStringPtr() = default;
@@ -126,6 +133,13 @@ class PROTOBUF_EXPORT TaggedStringPtr {
     return TagAs(kFixedSizeArena, p);
   }
 
+  // Sets the value to `p`, tagging the value as a shared string.
+  // See documentation for kShared for more info.
+  // `p` must not be null
+  inline const std::string* SetShared(const std::string* p) {
+    return TagAs(kShared, const_cast<std::string*>(p));
+  }
+
   // Sets the value to `p`, tagging the value as a mutable arena string.
   // See documentation for kMutableArena for more info.
   // `p` must not be null
@@ -159,6 +173,9 @@ class PROTOBUF_EXPORT TaggedStringPtr {
     return (as_int() & kMask) == kFixedSizeArena;
   }
 
+  // Returns true if the current string is shared with another instance.
+  inline bool IsShared() const { return (as_int() & kMask) == kShared; }
+
   // Returns the contained string pointer.
   inline std::string* Get() const {
     return reinterpret_cast<std::string*>(as_int() & ~kMask);
@@ -295,6 +312,12 @@ struct PROTOBUF_EXPORT ArenaStringPtr {
   // instance known to not carry any heap allocated value.
   inline void InitAllocated(std::string* str, Arena* arena);
 
+  // Resets the value of this instance to share the value of `rhs` without
+  // copying it. The value is copied on the first mutation of this instance.
+  // `rhs` must be on the same arena as this instance and must not be modified
+  // for as long as the value is shared. Disregards the initial value of ptr_.
+  inline void InitShared(const ArenaStringPtr& rhs);
+
   void Set(absl::string_view value, Arena* arena);
   void Set(std::string&& value, Arena* arena);
   template <typename... OverloadDisambiguator>
@@ -391,6 +414,9 @@ struct PROTOBUF_EXPORT ArenaStringPtr {
   // Returns true if this instances holds an immutable default value.
   inline bool IsDefault() const { return tagged_ptr_.IsDefault(); }
 
+  // Returns true if this instance shares its value with another instance.
+  inline bool IsShared() const { return tagged_ptr_.IsShared(); }
+
  private:
   template <typename... Args>
   inline std::string* NewString(Arena* arena, Args&&... args) {
@@ -405,8 +431,6 @@ struct PROTOBUF_EXPORT ArenaStringPtr {
 
   TaggedStringPtr tagged_ptr_;
 
-  bool IsFixedSizeArena() const { return false; }
-
   // Swaps tagged pointer without debug hardening. This is to allow python
   // protobuf to maintain pointer stability even in DEBUG builds.
   PROTOBUF_NDEBUG_INLINE static void UnsafeShallowSwap(ArenaStringPtr* rhs,
@@ -419,7 +443,7 @@ struct PROTOBUF_EXPORT ArenaStringPtr {
 
   // Slow paths.
 
-  // MutableSlow requires that !IsString() || IsDefault
+  // MutableSlow requires that !IsString() || IsDefault || IsShared
   // Variadic to support 0 args for empty default and 1 arg for LazyString.
   template <typename... Lazy>
   std::string* MutableSlow(::google::protobuf::Arena* arena, const Lazy&... lazy_default);
@@ -465,6 +489,14 @@ inline void ArenaStringPtr::InitAllocated(std::string* str, Arena* arena) {
   }
 }
 
+inline void ArenaStringPtr::InitShared(const ArenaStringPtr& rhs) {
+  if (rhs.IsDefault()) {
+    tagged_ptr_ = rhs.tagged_ptr_;
+  } else {
+    tagged_ptr_.SetShared(rhs.tagged_ptr_.Get());
+  }
+}
+
 inline void ArenaStringPtr::Set(const char* s, Arena* arena) {
   ABSL_DCHECK(s != nullptr);
   Set(absl::string_view{s}, arena);
@@ -510,7 +542,7 @@ PROTOBUF_NDEBUG_INLINE void ArenaStringPtr::InternalSwap(ArenaStringPtr* rhs,
       if (p->IsDefault()) continue;
       std::string* old_value = p->tagged_ptr_.Get();
       std::string* new_value =
-          p->IsFixedSizeArena()
+          !p->tagged_ptr_.IsMutable()
               ? Arena::Create<std::string>(arena, *old_value)
               : Arena::Create<std::string>(arena, std::move(*old_value));
       if (arena == nullptr) {
@@ -526,6 +558,10 @@ PROTOBUF_NDEBUG_INLINE void ArenaStringPtr::InternalSwap(ArenaStringPtr* rhs,
 inline void ArenaStringPtr::ClearNonDefaultToEmpty() {
   // Unconditionally mask away the tag.
   ABSL_DCHECK(!tagged_ptr_.IsDefault());
+  if (ABSL_PREDICT_FALSE(tagged_ptr_.IsShared())) {
+    InitDefault();
+    return;
+  }
   tagged_ptr_.Get()->clear();
 }
 
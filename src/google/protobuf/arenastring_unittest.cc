@@ -204,6 +204,75 @@ TEST_P(SingleArena, CopyConstructLong) {
   field.Destroy();
 }
 
+TEST(ArenaStringPtrTest, SharedCopyOnWrite) {
+  Arena arena;
+  ArenaStringPtr src;
+  src.InitDefault();
+  src.Set("A string long enough to not be inlined", &arena);
+
+  ArenaStringPtr shared;
+  shared.InitShared(src);
+  EXPECT_TRUE(shared.IsShared());
+  EXPECT_FALSE(shared.IsDefault());
+  EXPECT_EQ(&shared.Get(), &src.Get());
+
+  std::string* mut = shared.Mutable(&arena);
+  EXPECT_FALSE(shared.IsShared());
+  EXPECT_NE(mut, &src.Get());
+  EXPECT_EQ(*mut, "A string long enough to not be inlined");
+  mut->append("!");
+  EXPECT_EQ(shared.Get(), "A string long enough to not be inlined!");
+  EXPECT_EQ(src.Get(), "A string long enough to not be inlined");
+
+  shared.InitShared(src);
+  shared.Set("other", &arena);
+  EXPECT_EQ(shared.Get(), "other");
+  EXPECT_EQ(src.Get(), "A string long enough to not be inlined");
+
+  shared.InitShared(src);
+  shared.Set(std::string("moved"), &arena);
+  EXPECT_EQ(shared.Get(), "moved");
+  EXPECT_EQ(src.Get(), "A string long enough to not be inlined");
+}
+
+TEST(ArenaStringPtrTest, SharedClear) {
+  Arena arena;
+  ArenaStringPtr src;
+  src.InitDefault();
+  src.Set("value", &arena);
+
+  ArenaStringPtr shared;
+  shared.InitShared(src);
+  shared.ClearNonDefaultToEmpty();
+  EXPECT_EQ(shared.Get(), "");
+  EXPECT_EQ(src.Get(), "value");
+
+  shared.InitShared(src);
+  shared.ClearToEmpty();
+  EXPECT_EQ(shared.Get(), "");
+
+  shared.InitShared(src);
+  shared.ClearToDefault(nonempty_default, &arena);
+  EXPECT_TRUE(shared.IsDefault());
+  EXPECT_EQ(src.Get(), "value");
+
+  shared.InitShared(src);
+  std::unique_ptr<std::string> released(shared.Release());
+  EXPECT_EQ(*released, "value");
+  EXPECT_NE(released.get(), &src.Get());
+  EXPECT_EQ(src.Get(), "value");
+}
+
+TEST(ArenaStringPtrTest, SharedDefault) {
+  ArenaStringPtr src;
+  src.InitDefault();
+
+  ArenaStringPtr shared;
+  shared.InitShared(src);
+  EXPECT_TRUE(shared.IsDefault());
+  EXPECT_FALSE(shared.IsShared());
+}
+
 
 }  // namespace protobuf
 }  // namespace google
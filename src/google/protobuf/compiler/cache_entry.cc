@@ -0,0 +1,160 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/compiler/cache_entry.h"
+
+#ifdef _MSC_VER
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/runtime_version.h"
+
+#ifdef _WIN32
+#include "google/protobuf/io/io_win32.h"
+#endif
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace internal {
+
+#ifdef _WIN32
+// DO NOT include <io.h>, instead create functions in io_win32.{h,cc} and import
+// them like we do below.
+using google::protobuf::io::win32::open;
+#endif
+
+#ifndef O_BINARY
+#ifdef _O_BINARY
+#define O_BINARY _O_BINARY
+#else
+#define O_BINARY 0  // If this isn't defined, the platform doesn't need it.
+#endif
+#endif
+
+namespace {
+
+// 64-bit FNV-1a.  Unlike absl::Hash, the result is the same in every process.
+uint64_t StableHash(uint64_t hash, absl::string_view data) {
+  for (char c : data) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3;
+  }
+  return hash;
+}
+
+int ProcessId() {
+#ifdef _MSC_VER
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+}  // namespace
+
+std::string CacheEntryName(absl::string_view directory,
+                           absl::Span<const absl::string_view> key) {
+  // The sizes are hashed too, so that moving bytes from one part of the key to
+  // the next changes the name.
+  uint64_t hash = 0xcbf29ce484222325;
+  for (absl::string_view part : key) {
+    hash = StableHash(hash, absl::AlphaNum(part.size()).Piece());
+    hash = StableHash(hash, part);
+  }
+  return absl::StrFormat("%s/%016x.pb", directory, hash);
+}
+
+bool ReadCacheEntry(const std::string& filename,
+                    absl::Span<const absl::string_view> key,
+                    std::string* value) {
+  int fd;
+  do {
+    fd = open(filename.c_str(), O_RDONLY | O_BINARY);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    return false;
+  }
+  io::FileInputStream input(fd);
+  input.SetCloseOnDelete(true);
+  io::CodedInputStream coded_input(&input);
+
+  uint32_t version;
+  if (!coded_input.ReadVarint32(&version) || version != PROTOBUF_VERSION) {
+    return false;
+  }
+  uint64_t size;
+  std::string cached_part;
+  for (absl::string_view part : key) {
+    if (!coded_input.ReadVarint64(&size) || size != part.size() ||
+        !coded_input.ReadString(&cached_part, static_cast<int>(size)) ||
+        cached_part != part) {
+      return false;
+    }
+  }
+  return coded_input.ReadVarint64(&size) &&
+         coded_input.ReadString(value, static_cast<int>(size));
+}
+
+void WriteCacheEntry(const std::string& filename,
+                     absl::Span<const absl::string_view> key,
+                     absl::string_view value) {
+  static std::atomic<int> counter{0};
+  std::string temp_filename = absl::StrCat(filename, ".", ProcessId(), ".",
+                                           counter.fetch_add(1), ".tmp");
+  int fd;
+  do {
+    fd = open(temp_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY,
+              0666);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    return;
+  }
+  bool written;
+  {
+    io::FileOutputStream output(fd);
+    io::CodedOutputStream coded_output(&output);
+    coded_output.WriteVarint32(PROTOBUF_VERSION);
+    for (absl::string_view part : key) {
+      coded_output.WriteVarint64(part.size());
+      coded_output.WriteRaw(part.data(), static_cast<int>(part.size()));
+    }
+    coded_output.WriteVarint64(value.size());
+    coded_output.WriteRaw(value.data(), static_cast<int>(value.size()));
+    coded_output.Trim();
+    written = !coded_output.HadError() && output.Close();
+  }
+  if (!written || std::rename(temp_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(temp_filename.c_str());
+  }
+}
+
+}  // namespace internal
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,56 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// Entries of the on-disk caches shared by protoc processes, that is the
+// generator output cache of --cache_dir and the parse cache of
+// SourceTreeDescriptorDatabase.  This is an internal header.
+
+#ifndef GOOGLE_PROTOBUF_COMPILER_CACHE_ENTRY_H__
+#define GOOGLE_PROTOBUF_COMPILER_CACHE_ENTRY_H__
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace internal {
+
+// Returns the file name of the entry for the given key in the given directory.
+// The name is a hash of the key which is the same in every process, so it
+// only picks the file; the key itself is stored in the entry.
+PROTOBUF_EXPORT std::string CacheEntryName(
+    absl::string_view directory, absl::Span<const absl::string_view> key);
+
+// Reads the value of the entry in the given file.  An entry holds the protobuf
+// version, every part of the key and the value, and the version and the key
+// are compared in full, so a hash collision in the file name can't return the
+// value of another key.  Returns false if there is no matching entry.
+PROTOBUF_EXPORT bool ReadCacheEntry(const std::string& filename,
+                                    absl::Span<const absl::string_view> key,
+                                    std::string* value);
+
+// Writes the entry to a temporary file which is then renamed, so that
+// processes sharing the cache never see a partial entry.  Errors are ignored;
+// the value is simply not cached.
+PROTOBUF_EXPORT void WriteCacheEntry(const std::string& filename,
+                                     absl::Span<const absl::string_view> key,
+                                     absl::string_view value);
+
+}  // namespace internal
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_COMPILER_CACHE_ENTRY_H__
@@ -26,6 +26,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -62,14 +63,17 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
+#include "google/protobuf/compiler/cache_entry.h"
 #include "google/protobuf/compiler/code_generator.h"
 #include "google/protobuf/compiler/importer.h"
 #include "google/protobuf/compiler/plugin.pb.h"
@@ -187,6 +191,14 @@ bool VerifyDirectoryExists(const std::string& path) {
   }
 }
 
+bool CreateDirectoryIfMissing(const std::string& path) {
+  if (mkdir(path.c_str(), 0777) != 0 && errno != EEXIST) {
+    std::cerr << path << ": " << strerror(errno) << std::endl;
+    return false;
+  }
+  return true;
+}
+
 // Try to create the parent directory of the given file, creating the parent's
 // parent if necessary, and so on.  The full file name is actually
 // (prefix + filename), but we assume |prefix| already exists and only create
@@ -247,6 +259,16 @@ bool GetProtocAbsolutePath(std::string* path) {
   }
 }
 
+// Returns a string that changes whenever the executable at `path` is replaced,
+// or an empty string if the file can't be found.
+std::string ExecutableVersion(const std::string& path) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    return "";
+  }
+  return absl::StrCat(path, ":", info.st_size, ":", info.st_mtime);
+}
+
 // Whether a path is where google/protobuf/descriptor.proto and other well-known
 // type protos are installed.
 bool IsInstalledProtoPath(absl::string_view path) {
@@ -1334,6 +1356,10 @@ int CommandLineInterface::Run(int argc, const char* const argv[]) {
         raw_databases_per_descriptor_set);
   }
 
+  if (!cache_dir_.empty() && !CreateDirectoryIfMissing(cache_dir_)) {
+    return 1;
+  }
+
   if (proto_path_.empty()) {
     // If there are no --proto_path flags, then just look in the specified
     // --descriptor_set_in files.  But first, verify that the input files are
@@ -1359,6 +1385,19 @@ int CommandLineInterface::Run(int argc, const char* const argv[]) {
         disk_source_tree.get(), descriptor_set_in_database.get());
     source_tree_database->RecordErrorsTo(error_collector.get());
 
+    // Imported files are cached, but the input files, which are the ones
+    // being edited, are always parsed.
+    if (!cache_dir_.empty()) {
+      std::string parse_cache_dir = absl::StrCat(cache_dir_, "/parsed");
+      if (!CreateDirectoryIfMissing(parse_cache_dir)) {
+        return 1;
+      }
+      source_tree_database->SetParseCacheDirectory(parse_cache_dir);
+      for (const std::string& input_file : input_files_) {
+        source_tree_database->DisableParseCacheFor(input_file);
+      }
+    }
+
     descriptor_pool = std::make_unique<DescriptorPool>(
         source_tree_database.get(),
         source_tree_database->GetValidationErrorCollector());
@@ -1454,25 +1493,8 @@ int CommandLineInterface::Run(int argc, const char* const argv[]) {
 
   // Generate output.
   if (mode_ == MODE_COMPILE) {
-    for (size_t i = 0; i < output_directives_.size(); ++i) {
-      std::string output_location = output_directives_[i].output_location;
-      if (!absl::EndsWith(output_location, ".zip") &&
-          !absl::EndsWith(output_location, ".jar") &&
-          !absl::EndsWith(output_location, ".srcjar")) {
-        AddTrailingSlash(&output_location);
-      }
-
-      auto& generator = output_directories[output_location];
-
-      if (!generator) {
-        // First time we've seen this output location.
-        generator = std::make_unique<GeneratorContextImpl>(parsed_files);
-      }
-
-      if (!GenerateOutput(parsed_files, output_directives_[i],
-                          generator.get())) {
-        return 1;
-      }
+    if (!GenerateOutputs(parsed_files, output_directories)) {
+      return 1;
     }
   }
 
@@ -1508,6 +1530,12 @@ int CommandLineInterface::Run(int argc, const char* const argv[]) {
     }
   }
 
+  if (!descriptor_index_out_name_.empty()) {
+    if (!WriteDescriptorIndex(parsed_files)) {
+      return 1;
+    }
+  }
+
   if (!edition_defaults_out_name_.empty()) {
     if (!WriteEditionDefaults(*descriptor_pool)) {
       return 1;
@@ -1801,6 +1829,7 @@ void CommandLineInterface::Clear() {
   codec_type_.clear();
   descriptor_set_in_names_.clear();
   descriptor_set_out_name_.clear();
+  descriptor_index_out_name_.clear();
   dependency_out_name_.clear();
 
   experimental_editions_ = false;
@@ -1816,6 +1845,8 @@ void CommandLineInterface::Clear() {
   disallow_services_ = false;
   direct_dependencies_explicitly_set_ = false;
   deterministic_output_ = false;
+  jobs_ = 1;
+  cache_dir_.clear();
 }
 
 bool CommandLineInterface::MakeProtoProtoPathRelative(
@@ -2062,7 +2093,8 @@ CommandLineInterface::ParseArgumentStatus CommandLineInterface::ParseArguments(
     return PARSE_ARGUMENT_FAIL;
   }
   if (mode_ == MODE_COMPILE && output_directives_.empty() &&
-      descriptor_set_out_name_.empty() && edition_defaults_out_name_.empty()) {
+      descriptor_set_out_name_.empty() && descriptor_index_out_name_.empty() &&
+      edition_defaults_out_name_.empty()) {
     std::cerr << "Missing output directives." << std::endl;
     return PARSE_ARGUMENT_FAIL;
   }
@@ -2082,17 +2114,20 @@ CommandLineInterface::ParseArgumentStatus CommandLineInterface::ParseArguments(
         << std::endl;
     return PARSE_ARGUMENT_FAIL;
   }
-  if (imports_in_descriptor_set_ && descriptor_set_out_name_.empty()) {
+  if (imports_in_descriptor_set_ && descriptor_set_out_name_.empty() &&
+      descriptor_index_out_name_.empty()) {
     std::cerr << "--include_imports only makes sense when combined with "
                  "--descriptor_set_out."
               << std::endl;
   }
-  if (source_info_in_descriptor_set_ && descriptor_set_out_name_.empty()) {
+  if (source_info_in_descriptor_set_ && descriptor_set_out_name_.empty() &&
+      descriptor_index_out_name_.empty()) {
     std::cerr << "--include_source_info only makes sense when combined with "
                  "--descriptor_set_out."
               << std::endl;
   }
-  if (retain_options_in_descriptor_set_ && descriptor_set_out_name_.empty()) {
+  if (retain_options_in_descriptor_set_ && descriptor_set_out_name_.empty() &&
+      descriptor_index_out_name_.empty()) {
     std::cerr << "--retain_options only makes sense when combined with "
                  "--descriptor_set_out."
               << std::endl;
@@ -2336,6 +2371,24 @@ CommandLineInterface::InterpretArgument(const std::string& name,
     }
     descriptor_set_out_name_ = value;
 
+  } else if (name == "--descriptor_index_out") {
+    if (!descriptor_index_out_name_.empty()) {
+      std::cerr << name << " may only be passed once." << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
+    if (value.empty()) {
+      std::cerr << name << " requires a non-empty value." << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
+    if (mode_ != MODE_COMPILE) {
+      std::cerr
+          << "Cannot use --encode or --decode and generate descriptors at the "
+             "same time."
+          << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
+    descriptor_index_out_name_ = value;
+
   } else if (name == "--dependency_out") {
     if (!dependency_out_name_.empty()) {
       std::cerr << name << " may only be passed once." << std::endl;
@@ -2398,7 +2451,8 @@ CommandLineInterface::InterpretArgument(const std::string& name,
                 << std::endl;
       return PARSE_ARGUMENT_FAIL;
     }
-    if (!output_directives_.empty() || !descriptor_set_out_name_.empty()) {
+    if (!output_directives_.empty() || !descriptor_set_out_name_.empty() ||
+        !descriptor_index_out_name_.empty()) {
       std::cerr << "Cannot use " << name
                 << " and generate code or descriptors at the same time."
                 << std::endl;
@@ -2440,6 +2494,22 @@ CommandLineInterface::InterpretArgument(const std::string& name,
       return PARSE_ARGUMENT_FAIL;
     }
     fatal_warnings_ = true;
+  } else if (name == "--cache_dir") {
+    if (!cache_dir_.empty()) {
+      std::cerr << name << " may only be passed once." << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
+    if (value.empty()) {
+      std::cerr << name << " requires a non-empty value." << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
+    cache_dir_ = value;
+  } else if (name == "--jobs") {
+    if (!absl::SimpleAtoi(value, &jobs_) || jobs_ < 1) {
+      std::cerr << name << " requires a positive number of jobs, got: "
+                << value << std::endl;
+      return PARSE_ARGUMENT_FAIL;
+    }
   } else if (name == "--plugin") {
     if (plugin_prefix_.empty()) {
       std::cerr << "This compiler does not support plugins." << std::endl;
@@ -2473,7 +2543,8 @@ CommandLineInterface::InterpretArgument(const std::string& name,
                 << "other info at the same time." << std::endl;
       return PARSE_ARGUMENT_FAIL;
     }
-    if (!output_directives_.empty() || !descriptor_set_out_name_.empty()) {
+    if (!output_directives_.empty() || !descriptor_set_out_name_.empty() ||
+        !descriptor_index_out_name_.empty()) {
       std::cerr << "Cannot use " << name
                 << " and generate code or descriptors at the same time."
                 << std::endl;
@@ -2646,6 +2717,10 @@ Parse PROTO_FILES and generate output based on the options given:
   -oFILE,                     Writes a FileDescriptorSet (a protocol buffer,
     --descriptor_set_out=FILE defined in descriptor.proto) containing all of
                               the input files to FILE.
+  --descriptor_index_out=FILE Writes the files --descriptor_set_out would
+                              write to FILE as an indexed bundle, which
+                              EncodedDescriptorDatabase::AddIndexedBundle()
+                              can load or mmap without parsing.
   --include_imports           When using --descriptor_set_out, also include
                               all dependencies of the input files in the
                               set, so that the set is self-contained.
@@ -2670,6 +2745,17 @@ Parse PROTO_FILES and generate output based on the options given:
                               gcc). This flag will make protoc return
                               with a non-zero exit code if any warnings
                               are generated.
+  --jobs=N                    Run up to N code generators and plugins at
+                              once, one per output directive (e.g.
+                              --cpp_out and --python_out). The output is
+                              the same as with the default of 1.
+  --cache_dir=DIR             Cache the output of code generators in DIR,
+                              keyed by the contents of the input files and
+                              their imports, the generator and its
+                              parameters. Unchanged inputs are not
+                              regenerated. Plugins are only cached when
+                              their path is given with --plugin. Imported
+                              files are also cached after parsing.
   --print_free_field_numbers  Print the free field numbers of the messages
                               defined in the given proto files. Extension ranges
                               are counted as occupied fields numbers.
@@ -2817,38 +2903,161 @@ bool CommandLineInterface::EnforceProtocEditionsSupport(
   return true;
 }
 
-bool CommandLineInterface::GenerateOutput(
-    const std::vector<const FileDescriptor*>& parsed_files,
-    const OutputDirective& output_directive,
-    GeneratorContext* generator_context) {
-  // Call the generator.
+// The state of one output directive's code generator while protoc runs the
+// generators.  Running a generator only produces a CodeGeneratorResponse, so
+// that generators can run concurrently; the responses are written to their
+// output locations afterwards, in the order of the directives.
+struct CommandLineInterface::GeneratorRun {
+  // Empty for built-in generators.
+  std::string plugin_name;
+  std::string parameters;
+  bool bootstrap = false;
+
+  CodeGeneratorResponse response;
+  bool success = false;
   std::string error;
+};
+
+bool CommandLineInterface::GenerateOutputs(
+    const std::vector<const FileDescriptor*>& parsed_files,
+    GeneratorContextMap& output_directories) {
+  const size_t num_directives = output_directives_.size();
+  std::vector<GeneratorRun> runs(num_directives);
+
+  auto fail = [&](size_t i) {
+    std::cerr << output_directives_[i].name << ": " << runs[i].error
+              << std::endl;
+    return false;
+  };
+  auto write = [&](size_t i) {
+    std::string output_location = output_directives_[i].output_location;
+    if (!absl::EndsWith(output_location, ".zip") &&
+        !absl::EndsWith(output_location, ".jar") &&
+        !absl::EndsWith(output_location, ".srcjar")) {
+      AddTrailingSlash(&output_location);
+    }
+
+    auto& generator = output_directories[output_location];
+
+    if (!generator) {
+      // First time we've seen this output location.
+      generator = std::make_unique<GeneratorContextImpl>(parsed_files);
+    }
+
+    return WriteGeneratorResponse(parsed_files, output_directives_[i],
+                                  &runs[i], generator.get());
+  };
+
+  if (jobs_ <= 1 || num_directives <= 1) {
+    for (size_t i = 0; i < num_directives; ++i) {
+      if (!PrepareGeneratorRun(parsed_files, output_directives_[i],
+                               &runs[i]) ||
+          !RunGenerator(parsed_files, output_directives_[i], &runs[i]) ||
+          !write(i)) {
+        return fail(i);
+      }
+    }
+    return true;
+  }
+
+  for (size_t i = 0; i < num_directives; ++i) {
+    if (!PrepareGeneratorRun(parsed_files, output_directives_[i], &runs[i])) {
+      return fail(i);
+    }
+  }
+
+  // Worker threads take the directives in order, and the responses are
+  // written as soon as the generators of all earlier directives are done.
+  absl::Mutex mutex;
+  absl::CondVar finished;
+  size_t next = 0;
+  bool cancelled = false;
+  std::vector<bool> done(num_directives, false);
+  auto work = [&] {
+    while (true) {
+      size_t i;
+      {
+        absl::MutexLock lock(&mutex);
+        if (cancelled || next == num_directives) return;
+        i = next++;
+      }
+      runs[i].success =
+          RunGenerator(parsed_files, output_directives_[i], &runs[i]);
+      absl::MutexLock lock(&mutex);
+      done[i] = true;
+      finished.SignalAll();
+    }
+  };
+  std::vector<std::thread> workers;
+  const size_t num_workers =
+      std::min(static_cast<size_t>(jobs_), num_directives);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers.emplace_back(work);
+  }
+
+  bool success = true;
+  for (size_t i = 0; success && i < num_directives; ++i) {
+    {
+      absl::MutexLock lock(&mutex);
+      while (!done[i]) finished.Wait(&mutex);
+    }
+    if (!runs[i].success || !write(i)) {
+      success = fail(i);
+    }
+  }
+
+  // After a failure, generators which have already started still run to
+  // completion, but no new ones are started.
+  {
+    absl::MutexLock lock(&mutex);
+    cancelled = true;
+  }
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return success;
+}
+
+bool CommandLineInterface::PrepareGeneratorRun(
+    const std::vector<const FileDescriptor*>& parsed_files,
+    const OutputDirective& output_directive, GeneratorRun* run) {
+  run->parameters = output_directive.parameter;
   if (output_directive.generator == nullptr) {
     // This is a plugin.
     ABSL_CHECK(absl::StartsWith(output_directive.name, "--") &&
                absl::EndsWith(output_directive.name, "_out"))
         << "Bad name for plugin generator: " << output_directive.name;
 
-    std::string plugin_name = PluginName(plugin_prefix_, output_directive.name);
-    std::string parameters = output_directive.parameter;
-    if (!plugin_parameters_[plugin_name].empty()) {
-      if (!parameters.empty()) {
-        parameters.append(",");
+    run->plugin_name = PluginName(plugin_prefix_, output_directive.name);
+    if (!plugin_parameters_[run->plugin_name].empty()) {
+      if (!run->parameters.empty()) {
+        run->parameters.append(",");
       }
-      parameters.append(plugin_parameters_[plugin_name]);
+      run->parameters.append(plugin_parameters_[run->plugin_name]);
     }
-    if (!GeneratePluginOutput(parsed_files, plugin_name, parameters,
-                              generator_context, &error)) {
-      std::cerr << output_directive.name << ": " << error << std::endl;
-      return false;
-    }
-  } else {
-    // Regular generator.
-    if (!GenerateBuiltInOutput(parsed_files, output_directive,
-                               generator_context, &error)) {
-      std::cerr << output_directive.name << ": " << error << std::endl;
-      return false;
+    run->bootstrap = GetBootstrapParam(run->parameters);
+    return true;
+  }
+
+  // Regular generator.
+  if (!generator_parameters_[output_directive.name].empty()) {
+    if (!run->parameters.empty()) {
+      run->parameters.append(",");
     }
+    run->parameters.append(generator_parameters_[output_directive.name]);
+  }
+  if (!EnforceProto3OptionalSupport(
+          output_directive.name,
+          output_directive.generator->GetSupportedFeatures(), parsed_files)) {
+    return false;
+  }
+
+  if (!EnforceEditionsSupport(
+          output_directive.name,
+          output_directive.generator->GetSupportedFeatures(),
+          output_directive.generator->GetMinimumEdition(),
+          output_directive.generator->GetMaximumEdition(), parsed_files)) {
+    return false;
   }
 
   return true;
@@ -2885,6 +3094,10 @@ bool CommandLineInterface::GenerateDependencyManifestFile(
     output_filenames.push_back(descriptor_set_out_name_);
   }
 
+  if (!descriptor_index_out_name_.empty()) {
+    output_filenames.push_back(descriptor_index_out_name_);
+  }
+
   if (!edition_defaults_out_name_.empty()) {
     output_filenames.push_back(edition_defaults_out_name_);
   }
@@ -3029,50 +3242,120 @@ bool CommandLineInterface::GenerateCodeFromResponse(
   return true;
 }
 
-bool CommandLineInterface::GeneratePluginOutput(
+bool CommandLineInterface::RunGenerator(
     const std::vector<const FileDescriptor*>& parsed_files,
-    const std::string& plugin_name, const std::string& parameter,
-    GeneratorContext* generator_context, std::string* error) {
+    const OutputDirective& output_directive, GeneratorRun* run) const {
   // TODO Remove these special-cases and send json names to all
   // plugins.
   static const auto builtin_plugins = new absl::flat_hash_set<std::string>(
       {"protoc-gen-cpp", "protoc-gen-java", "protoc-gen-mutable_java",
        "protoc-gen-python"});
 
-  bool bootstrap = GetBootstrapParam(parameter);
-  CodeGeneratorRequest request = CreateCodeGeneratorRequest(
-      parsed_files, parameter,
-      // The built-in code generators didn't use the json names.
-      /*copy_json_name=*/!builtin_plugins->contains(plugin_name), bootstrap);
-  CodeGeneratorResponse response;
-
-  // Invoke the plugin.
-  Subprocess subprocess;
+  CodeGeneratorRequest request =
+      run->plugin_name.empty()
+          ? CreateCodeGeneratorRequest(parsed_files, run->parameters)
+          : CreateCodeGeneratorRequest(
+                parsed_files, run->parameters,
+                // The built-in code generators didn't use the json names.
+                /*copy_json_name=*/
+                !builtin_plugins->contains(run->plugin_name), run->bootstrap);
+
+  // Built-in generators are identified by protoc's own binary, and plugins by
+  // theirs.  Plugins found on the PATH are not cached, since it is not known
+  // which binary will run.
+  auto plugin = plugins_.find(run->plugin_name);
+  std::string cache_file;
+  std::string cache_generator;
+  std::string serialized_request;
+  if (!cache_dir_.empty()) {
+    std::string executable;
+    if (run->plugin_name.empty()) {
+      GetProtocAbsolutePath(&executable);
+    } else if (plugin != plugins_.end()) {
+      executable = plugin->second;
+    }
+    std::string version =
+        executable.empty() ? "" : ExecutableVersion(executable);
+    if (!version.empty()) {
+      cache_generator = absl::StrCat(output_directive.name, "\n", version);
+      {
+        io::StringOutputStream output(&serialized_request);
+        io::CodedOutputStream coded_output(&output);
+        coded_output.SetSerializationDeterministic(true);
+        request.SerializeToCodedStream(&coded_output);
+      }
+      cache_file = internal::CacheEntryName(
+          cache_dir_, {cache_generator, serialized_request});
+      std::string serialized_response;
+      if (internal::ReadCacheEntry(cache_file,
+                                   {cache_generator, serialized_request},
+                                   &serialized_response) &&
+          run->response.ParseFromString(serialized_response)) {
+        return true;
+      }
+      run->response.Clear();
+    }
+  }
 
-  if (plugins_.count(plugin_name) > 0) {
-    subprocess.Start(plugins_[plugin_name], Subprocess::EXACT_NAME);
+  if (run->plugin_name.empty()) {
+    if (!GenerateCode(request, *output_directive.generator, &run->response,
+                      &run->error)) {
+      return false;
+    }
   } else {
-    subprocess.Start(plugin_name, Subprocess::SEARCH_PATH);
+    // Invoke the plugin.
+    Subprocess subprocess;
+
+    if (plugin != plugins_.end()) {
+      subprocess.Start(plugin->second, Subprocess::EXACT_NAME);
+    } else {
+      subprocess.Start(run->plugin_name, Subprocess::SEARCH_PATH);
+    }
+
+    std::string communicate_error;
+    if (!subprocess.Communicate(request, &run->response, &communicate_error)) {
+      run->error =
+          absl::Substitute("$0: $1", run->plugin_name, communicate_error);
+      return false;
+    }
   }
 
-  std::string communicate_error;
-  if (!subprocess.Communicate(request, &response, &communicate_error)) {
-    *error = absl::Substitute("$0: $1", plugin_name, communicate_error);
-    return false;
+  // Failed generations are not cached, so that the error is reported again.
+  if (!cache_file.empty() && run->response.error().empty()) {
+    internal::WriteCacheEntry(cache_file, {cache_generator, serialized_request},
+                              run->response.SerializeAsString());
   }
+  return true;
+}
 
-  if (!GenerateCodeFromResponse(response, generator_context, bootstrap,
-                                plugin_name, error)) {
+bool CommandLineInterface::WriteGeneratorResponse(
+    const std::vector<const FileDescriptor*>& parsed_files,
+    const OutputDirective& output_directive, GeneratorRun* run,
+    GeneratorContext* generator_context) {
+  const CodeGeneratorResponse& response = run->response;
+  if (run->plugin_name.empty()) {
+    if (response.has_error()) {
+      run->error = response.error();
+      return false;
+    }
+    return GenerateCodeFromResponse(response, generator_context,
+                                    /*bootstrap=*/false, output_directive.name,
+                                    &run->error);
+  }
+
+  if (!GenerateCodeFromResponse(response, generator_context, run->bootstrap,
+                                run->plugin_name, &run->error)) {
     return false;
   }
 
   // Check for errors.
   bool success = true;
-  if (!EnforceProto3OptionalSupport(plugin_name, response.supported_features(),
+  if (!EnforceProto3OptionalSupport(run->plugin_name,
+                                    response.supported_features(),
                                     parsed_files)) {
     success = false;
   }
-  if (!EnforceEditionsSupport(plugin_name, response.supported_features(),
+  if (!EnforceEditionsSupport(run->plugin_name, response.supported_features(),
                               static_cast<Edition>(response.minimum_edition()),
                               static_cast<Edition>(response.maximum_edition()),
                               parsed_files)) {
@@ -3080,58 +3363,13 @@ bool CommandLineInterface::GeneratePluginOutput(
   }
   if (!response.error().empty()) {
     // Generator returned an error.
-    *error = response.error();
+    run->error = response.error();
     success = false;
   }
 
   return success;
 }
 
-bool CommandLineInterface::GenerateBuiltInOutput(
-    const std::vector<const FileDescriptor*>& parsed_files,
-    const OutputDirective& output_directive,
-    GeneratorContext* generator_context, std::string* error) {
-  std::string parameters = output_directive.parameter;
-  if (!generator_parameters_[output_directive.name].empty()) {
-    if (!parameters.empty()) {
-      parameters.append(",");
-    }
-    parameters.append(generator_parameters_[output_directive.name]);
-  }
-  if (!EnforceProto3OptionalSupport(
-          output_directive.name,
-          output_directive.generator->GetSupportedFeatures(), parsed_files)) {
-    return false;
-  }
-
-  if (!EnforceEditionsSupport(
-          output_directive.name,
-          output_directive.generator->GetSupportedFeatures(),
-          output_directive.generator->GetMinimumEdition(),
-          output_directive.generator->GetMaximumEdition(), parsed_files)) {
-    return false;
-  }
-
-  CodeGeneratorRequest request =
-      CreateCodeGeneratorRequest(parsed_files, parameters);
-  CodeGeneratorResponse response;
-  if (!GenerateCode(request, *output_directive.generator, &response, error)) {
-    return false;
-  }
-  if (response.has_error()) {
-    *error = response.error();
-    return false;
-  }
-
-  if (!GenerateCodeFromResponse(response, generator_context,
-                                /*bootstrap=*/false, output_directive.name,
-                                error)) {
-    return false;
-  }
-
-  return true;
-}
-
 bool CommandLineInterface::EncodeOrDecode(const DescriptorPool* pool) {
   // Look up the type.
   const Descriptor* type = pool->FindMessageTypeByName(codec_type_);
@@ -3197,10 +3435,9 @@ bool CommandLineInterface::EncodeOrDecode(const DescriptorPool* pool) {
   return true;
 }
 
-bool CommandLineInterface::WriteDescriptorSet(
-    const std::vector<const FileDescriptor*>& parsed_files) {
-  FileDescriptorSet file_set;
-
+void CommandLineInterface::GetDescriptorSet(
+    const std::vector<const FileDescriptor*>& parsed_files,
+    FileDescriptorSet* file_set) {
   absl::flat_hash_set<const FileDescriptor*> already_seen;
   if (!imports_in_descriptor_set_) {
     // Since we don't want to output transitive dependencies, but we do want
@@ -3235,8 +3472,14 @@ bool CommandLineInterface::WriteDescriptorSet(
   options.retain_options = retain_options_in_descriptor_set_;
   for (size_t i = 0; i < parsed_files.size(); ++i) {
     GetTransitiveDependencies(parsed_files[i], &already_seen,
-                              file_set.mutable_file(), options);
+                              file_set->mutable_file(), options);
   }
+}
+
+bool CommandLineInterface::WriteDescriptorSet(
+    const std::vector<const FileDescriptor*>& parsed_files) {
+  FileDescriptorSet file_set;
+  GetDescriptorSet(parsed_files, &file_set);
 
   int fd;
   do {
@@ -3273,6 +3516,61 @@ bool CommandLineInterface::WriteDescriptorSet(
   return true;
 }
 
+bool CommandLineInterface::WriteDescriptorIndex(
+    const std::vector<const FileDescriptor*>& parsed_files) {
+  FileDescriptorSet file_set;
+  GetDescriptorSet(parsed_files, &file_set);
+
+  EncodedDescriptorDatabase database;
+  for (const FileDescriptorProto& file : file_set.file()) {
+    std::string data;
+    {
+      io::StringOutputStream string_out(&data);
+      io::CodedOutputStream coded_out(&string_out);
+      // Determinism is useful here because build outputs are sometimes
+      // checked into version control.
+      coded_out.SetSerializationDeterministic(true);
+      file.SerializeToCodedStream(&coded_out);
+    }
+    if (!database.AddCopy(data.data(), static_cast<int>(data.size()))) {
+      std::cerr << descriptor_index_out_name_ << ": Could not index "
+                << file.name() << std::endl;
+      return false;
+    }
+  }
+  std::string bundle;
+  if (!database.SerializeIndexedBundle(&bundle)) {
+    std::cerr << descriptor_index_out_name_ << ": Could not write index."
+              << std::endl;
+    return false;
+  }
+
+  int fd;
+  do {
+    fd = open(descriptor_index_out_name_.c_str(),
+              O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0666);
+  } while (fd < 0 && errno == EINTR);
+
+  if (fd < 0) {
+    perror(descriptor_index_out_name_.c_str());
+    return false;
+  }
+
+  io::FileOutputStream out(fd);
+  {
+    io::CodedOutputStream coded_out(&out);
+    coded_out.WriteString(bundle);
+  }
+
+  if (!out.Close()) {
+    std::cerr << descriptor_index_out_name_ << ": "
+              << strerror(out.GetErrno()) << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
 bool CommandLineInterface::WriteEditionDefaults(const DescriptorPool& pool) {
   const Descriptor* feature_set;
   if (opensource_runtime_) {
@@ -278,19 +278,26 @@ class PROTOC_EXPORT CommandLineInterface {
 
   bool SetupFeatureResolution(DescriptorPool& pool);
 
-  // Generate the given output file from the given input.
+  // Generate the output files of every output directive from the given input.
+  // With --jobs, the code generators of several directives run concurrently.
   struct OutputDirective;  // see below
-  bool GenerateOutput(const std::vector<const FileDescriptor*>& parsed_files,
-                      const OutputDirective& output_directive,
-                      GeneratorContext* generator_context);
-  bool GeneratePluginOutput(
+  struct GeneratorRun;     // defined in the .cc file
+  bool GenerateOutputs(const std::vector<const FileDescriptor*>& parsed_files,
+                       GeneratorContextMap& output_directories);
+  // Computes the parameters for the directive's code generator and checks
+  // that a built-in generator supports the input.
+  bool PrepareGeneratorRun(
       const std::vector<const FileDescriptor*>& parsed_files,
-      const std::string& plugin_name, const std::string& parameter,
-      GeneratorContext* generator_context, std::string* error);
-  bool GenerateBuiltInOutput(
+      const OutputDirective& output_directive, GeneratorRun* run);
+  // Invokes the code generator or plugin.  May be called from any thread.
+  bool RunGenerator(const std::vector<const FileDescriptor*>& parsed_files,
+                    const OutputDirective& output_directive,
+                    GeneratorRun* run) const;
+  // Writes the generator's response to the output location.
+  bool WriteGeneratorResponse(
       const std::vector<const FileDescriptor*>& parsed_files,
-      const OutputDirective& output_directive,
-      GeneratorContext* generator_context, std::string* error);
+      const OutputDirective& output_directive, GeneratorRun* run,
+      GeneratorContext* generator_context);
 
   // Common code for both plugins and built-in generators.
   CodeGeneratorRequest CreateCodeGeneratorRequest(
@@ -315,10 +322,20 @@ class PROTOC_EXPORT CommandLineInterface {
   // Implements --encode and --decode.
   bool EncodeOrDecode(const DescriptorPool* pool);
 
+  // Collects the files written by --descriptor_set_out and
+  // --descriptor_index_out, honoring --include_imports, --include_source_info
+  // and --retain_options.
+  void GetDescriptorSet(const std::vector<const FileDescriptor*>& parsed_files,
+                        FileDescriptorSet* file_set);
+
   // Implements the --descriptor_set_out option.
   bool WriteDescriptorSet(
       const std::vector<const FileDescriptor*>& parsed_files);
 
+  // Implements the --descriptor_index_out option.
+  bool WriteDescriptorIndex(
+      const std::vector<const FileDescriptor*>& parsed_files);
+
   // Implements the --edition_defaults_out option.
   bool WriteEditionDefaults(const DescriptorPool& pool);
 
@@ -426,6 +443,13 @@ class PROTOC_EXPORT CommandLineInterface {
   // True if we should treat warnings as errors that fail the compilation.
   bool fatal_warnings_ = false;
 
+  // The maximum number of code generators to run at once (--jobs).
+  int jobs_ = 1;
+
+  // If --cache_dir was given, the directory in which the responses of code
+  // generators are cached.  Otherwise, empty.
+  std::string cache_dir_;
+
   std::vector<std::pair<std::string, std::string>>
       proto_path_;                        // Search path for proto files.
   std::vector<std::string> input_files_;  // Names of the input proto files.
@@ -471,6 +495,10 @@ class PROTOC_EXPORT CommandLineInterface {
   // FileDescriptorSet should be written.  Otherwise, empty.
   std::string descriptor_set_out_name_;
 
+  // If --descriptor_index_out was given, this is the filename to which the
+  // indexed descriptor bundle should be written.  Otherwise, empty.
+  std::string descriptor_index_out_name_;
+
   std::string edition_defaults_out_name_;
   Edition edition_defaults_minimum_;
   Edition edition_defaults_maximum_;
@@ -39,6 +39,7 @@
 #include "google/protobuf/testing/file.h"
 #include "google/protobuf/any.pb.h"
 #include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/descriptor_database.h"
 #include "google/protobuf/testing/googletest.h"
 #include <gtest/gtest.h>
 #include "absl/strings/str_split.h"
@@ -1301,6 +1302,49 @@ TEST_F(CommandLineInterfaceTest, Insert) {
                                 "Foo");
 }
 
+TEST_F(CommandLineInterfaceTest, CacheDir) {
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "message Foo {}\n");
+
+  Run("protocol_compiler --cache_dir=$tmpdir/cache "
+      "--test_out=TestParameter:$tmpdir --plug_out=TestPluginParameter:$tmpdir "
+      "--test_out=insert=test_generator,test_plugin:$tmpdir "
+      "--plug_out=insert=test_generator,test_plugin:$tmpdir "
+      "--proto_path=$tmpdir foo.proto");
+  ExpectNoErrors();
+  EXPECT_TRUE(File::Exists(absl::StrCat(temp_directory(), "/cache")));
+
+  // The second run writes the cached output without calling the generator or
+  // the plugin, which would now fail.
+  SetMockGeneratorTestCase("fail_if_called");
+  Run("protocol_compiler --cache_dir=$tmpdir/cache "
+      "--test_out=TestParameter:$tmpdir --plug_out=TestPluginParameter:$tmpdir "
+      "--test_out=insert=test_generator,test_plugin:$tmpdir "
+      "--plug_out=insert=test_generator,test_plugin:$tmpdir "
+      "--proto_path=$tmpdir foo.proto");
+  ExpectNoErrors();
+  ExpectGeneratedWithInsertions("test_generator", "TestParameter",
+                                "test_generator,test_plugin", "foo.proto",
+                                "Foo");
+  ExpectGeneratedWithInsertions("test_plugin", "TestPluginParameter",
+                                "test_generator,test_plugin", "foo.proto",
+                                "Foo");
+}
+
+TEST_F(CommandLineInterfaceTest, CacheDirDoesNotCacheErrors) {
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "message MockCodeGenerator_Error {}\n");
+
+  for (int i = 0; i < 2; ++i) {
+    Run("protocol_compiler --cache_dir=$tmpdir/cache --test_out=$tmpdir "
+        "--proto_path=$tmpdir foo.proto");
+    ExpectErrorSubstring(
+        "--test_out: foo.proto: Saw message type MockCodeGenerator_Error.");
+  }
+}
+
 TEST_F(CommandLineInterfaceTest, InsertWithAnnotationFixup) {
   // Check that annotation spans are updated after insertions.
 
@@ -1320,6 +1364,30 @@ TEST_F(CommandLineInterfaceTest, InsertWithAnnotationFixup) {
   CheckGeneratedAnnotations("test_plugin", "foo.proto");
 }
 
+TEST_F(CommandLineInterfaceTest, InsertWithJobs) {
+  // Test that running generators in parallel still applies insertions in the
+  // order of the output directives.
+
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "message Foo {}\n");
+
+  Run("protocol_compiler --jobs=4 "
+      "--test_out=TestParameter:$tmpdir "
+      "--plug_out=TestPluginParameter:$tmpdir "
+      "--test_out=insert=test_generator,test_plugin:$tmpdir "
+      "--plug_out=insert=test_generator,test_plugin:$tmpdir "
+      "--proto_path=$tmpdir foo.proto");
+
+  ExpectNoErrors();
+  ExpectGeneratedWithInsertions("test_generator", "TestParameter",
+                                "test_generator,test_plugin", "foo.proto",
+                                "Foo");
+  ExpectGeneratedWithInsertions("test_plugin", "TestPluginParameter",
+                                "test_generator,test_plugin", "foo.proto",
+                                "Foo");
+}
+
 #if defined(_WIN32)
 
 TEST_F(CommandLineInterfaceTest, WindowsOutputPath) {
@@ -3060,6 +3128,43 @@ TEST_F(CommandLineInterfaceTest, WriteDescriptorSet) {
   EXPECT_TRUE(descriptor_set.file(0).message_type(0).field(0).has_json_name());
 }
 
+TEST_F(CommandLineInterfaceTest, WriteDescriptorIndex) {
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "package foo;\n"
+                 "message Foo {\n"
+                 "  extensions 100 to 199;\n"
+                 "}\n");
+  CreateTempFile("bar.proto",
+                 "syntax = \"proto2\";\n"
+                 "import \"foo.proto\";\n"
+                 "message Bar {}\n"
+                 "extend foo.Foo {\n"
+                 "  optional int32 bar = 100;\n"
+                 "}\n");
+
+  Run("protocol_compiler --descriptor_index_out=$tmpdir/descriptor_index "
+      "--include_imports --proto_path=$tmpdir bar.proto");
+
+  ExpectNoErrors();
+
+  std::string bundle = ReadFile("descriptor_index");
+  EncodedDescriptorDatabase database;
+  ASSERT_TRUE(database.AddIndexedBundle(bundle.data(), bundle.size()));
+
+  std::vector<std::string> file_names;
+  EXPECT_TRUE(database.FindAllFileNames(&file_names));
+  EXPECT_THAT(file_names, testing::ElementsAre("bar.proto", "foo.proto"));
+
+  FileDescriptorProto file;
+  EXPECT_TRUE(database.FindFileContainingSymbol("foo.Foo", &file));
+  EXPECT_EQ("foo.proto", file.name());
+  file.Clear();
+  EXPECT_TRUE(database.FindFileContainingExtension("foo.Foo", 100, &file));
+  EXPECT_EQ("bar.proto", file.name());
+  EXPECT_FALSE(file.has_source_code_info());
+}
+
 TEST_F(CommandLineInterfaceTest, ImportOption_DescriptorSetOut) {
   CreateTempFile("google/protobuf/descriptor.proto",
                  google::protobuf::DescriptorProto::descriptor()->file()->DebugString());
@@ -4118,6 +4223,18 @@ TEST_F(CommandLineInterfaceTest, GeneratorError) {
       "--test_out: foo.proto: Saw message type MockCodeGenerator_Error.");
 }
 
+TEST_F(CommandLineInterfaceTest, GeneratorErrorWithJobs) {
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "message MockCodeGenerator_Error {}\n");
+
+  Run("protocol_compiler --jobs=2 --test_out=$tmpdir --plug_out=$tmpdir "
+      "--proto_path=$tmpdir foo.proto");
+
+  ExpectErrorSubstring(
+      "--test_out: foo.proto: Saw message type MockCodeGenerator_Error.");
+}
+
 TEST_F(CommandLineInterfaceTest, GeneratorPluginError) {
   // Test a generator plugin that returns an error.
 
@@ -4304,6 +4421,17 @@ TEST_F(CommandLineInterfaceTest, InvalidErrorFormat) {
   ExpectErrorText("Unknown error format: invalid\n");
 }
 
+TEST_F(CommandLineInterfaceTest, InvalidJobs) {
+  CreateTempFile("foo.proto",
+                 "syntax = \"proto2\";\n"
+                 "message Foo {}\n");
+
+  Run("protocol_compiler --test_out=$tmpdir "
+      "--proto_path=$tmpdir --jobs=0 foo.proto");
+
+  ExpectErrorText("--jobs requires a positive number of jobs, got: 0\n");
+}
+
 TEST_F(CommandLineInterfaceTest, Warnings) {
   // Test --fatal_warnings.
 
@@ -137,6 +137,12 @@ class SingularMessage : public FieldGeneratorBase {
  private:
   friend class OneofMessage;
 
+  // Whether to call the serializer of the field's type directly.  Requires the
+  // static type of the member to be the field's type.
+  virtual bool devirtualize() const {
+    return opts_->devirtualize_submessages && !is_weak();
+  }
+
   const Options* opts_;
   bool has_required_;
   bool has_hasbit_;
@@ -386,12 +392,18 @@ void SingularMessage::GenerateCopyConstructorCode(io::Printer* p) const {
 
 void SingularMessage::GenerateSerializeWithCachedSizesToArray(
     io::Printer* p) const {
+  auto v = p->WithVars({{"NoVirtual", devirtualize() ? "NoVirtual" : ""}});
   if (!is_group()) {
     p->Emit(R"cc(
-      target = $pbi$::WireFormatLite::InternalWrite$declared_type$(
+      target = $pbi$::WireFormatLite::InternalWrite$declared_type$$NoVirtual$(
           $number$, *this_.$field_$, this_.$field_$->GetCachedSize(), target,
           stream);
     )cc");
+  } else if (devirtualize()) {
+    p->Emit(R"cc(
+      target = $pbi$::WireFormatLite::InternalWrite$declared_type$NoVirtual(
+          $number$, *this_.$field_$, target, stream);
+    )cc");
   } else {
     p->Emit(R"cc(
       target = stream->EnsureSpace(target);
@@ -496,6 +508,10 @@ class OneofMessage : public SingularMessage {
     return Vars(field_, *opts_, is_weak(), use_base_class());
   }
 
+  bool devirtualize() const override {
+    return SingularMessage::devirtualize() && !use_base_class();
+  }
+
   void GenerateInlineAccessorDefinitions(io::Printer* p) const override;
   void GenerateNonInlineAccessorDefinitions(io::Printer* p) const override;
   void GenerateClearingCode(io::Printer* p) const override;
@@ -980,14 +996,16 @@ void RepeatedMessage::GenerateSerializeWithCachedSizesToArray(
               }
             )cc");
   } else {
-    p->Emit({{"serialize_field",
+    p->Emit({{"NoVirtual",
+              opts_->devirtualize_submessages ? "NoVirtual" : ""},
+             {"serialize_field",
               [&] {
                 if (field_->type() == FieldDescriptor::TYPE_MESSAGE) {
                   p->Emit(
                       R"cc(
                         const auto& repfield = this_._internal_$name$().Get(i);
                         target =
-                            $pbi$::WireFormatLite::InternalWrite$declared_type$(
+                            $pbi$::WireFormatLite::InternalWrite$declared_type$$NoVirtual$(
                                 $number$, repfield, repfield.GetCachedSize(),
                                 target, stream);
                       )cc");
@@ -996,7 +1014,7 @@ void RepeatedMessage::GenerateSerializeWithCachedSizesToArray(
                       R"cc(
                         target = stream->EnsureSpace(target);
                         target =
-                            $pbi$::WireFormatLite::InternalWrite$declared_type$(
+                            $pbi$::WireFormatLite::InternalWrite$declared_type$$NoVirtual$(
                                 $number$, this_._internal_$name$().Get(i),
                                 target, stream);
                       )cc");
@@ -1670,6 +1670,13 @@ void FileGenerator::GenerateLibraryIncludes(io::Printer* p) {
   if (IsStringInliningEnabled(options_)) {
     IncludeFile("third_party/protobuf/inlined_string_field.h", p);
   }
+  for (const auto& message : message_generators_) {
+    // Split repeated fields are held through a RawPtr.
+    if (ShouldSplit(message->descriptor(), options_)) {
+      IncludeFile("third_party/protobuf/raw_ptr.h", p);
+      break;
+    }
+  }
   if (HasSimpleBaseClasses(file_, options_)) {
     IncludeFile("third_party/protobuf/generated_message_bases.h", p);
   }
@@ -22,6 +22,7 @@
 #include "absl/log/absl_check.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
@@ -31,6 +32,7 @@
 #include "google/protobuf/compiler/cpp/file.h"
 #include "google/protobuf/compiler/cpp/helpers.h"
 #include "google/protobuf/compiler/cpp/options.h"
+#include "google/protobuf/compiler/split_map.h"
 #include "google/protobuf/cpp_features.pb.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/descriptor.pb.h"
@@ -338,12 +340,23 @@ bool CppGenerator::GenerateAll(const std::vector<const FileDescriptor*>& files,
   //
   // If the lite option is passed to the compiler, we will generate the
   // current files and all transitive dependencies using the LITE runtime.
+  //
+  // If the split_map_file option is passed to the compiler, the fields listed
+  // in the given file are moved out of the message objects into a separately
+  // allocated struct.  See split_map.h for the file format.
+  //
+  // If the experimental_devirtualize_submessages option is passed to the
+  // compiler, message fields are serialized by calling the generated
+  // serializer of the field's type directly, instead of through MessageLite.
+  // This makes the calls direct (and inlinable with link-time optimization)
+  // at the cost of some code size.
   Options common_file_options;
 
   common_file_options.opensource_runtime = opensource_runtime_;
   common_file_options.runtime_include_base = runtime_include_base_;
 
   std::vector<std::string> protos_for_field_listener_events;
+  SplitMap split_map;
 
   for (const auto& option : options) {
     const auto& key = option.first;
@@ -406,6 +419,16 @@ bool CppGenerator::GenerateAll(const std::vector<const FileDescriptor*>& files,
       common_file_options.strip_nonfunctional_codegen = true;
     } else if (key == "experimental_cpp_micro_string") {
       common_file_options.experimental_use_micro_string = true;
+    } else if (key == "experimental_devirtualize_submessages") {
+      common_file_options.devirtualize_submessages = true;
+    } else if (key == "split_map_file") {
+      absl::StatusOr<SplitMap> parsed = SplitMap::ReadFromFile(value);
+      if (!parsed.ok()) {
+        *error = std::string(parsed.status().message());
+        return false;
+      }
+      split_map = *std::move(parsed);
+      common_file_options.split_map = &split_map;
     } else {
       *error = absl::StrCat("Unknown generator option: ", key);
       return false;
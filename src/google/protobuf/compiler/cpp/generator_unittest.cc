@@ -50,6 +50,73 @@ TEST_F(CppGeneratorTest, Basic) {
   ExpectNoErrors();
 }
 
+TEST_F(CppGeneratorTest, DevirtualizeSubmessages) {
+  CreateTempFile("foo.proto",
+                 R"schema(
+    syntax = "proto2";
+    message Bar {
+      optional int32 baz = 1;
+    }
+    message Foo {
+      optional Bar bar = 1;
+      repeated Bar bars = 2;
+      optional group Qux = 3 {
+        optional int32 quux = 4;
+      }
+    })schema");
+
+  RunProtoc("protocol_compiler --proto_path=$tmpdir --cpp_out=$tmpdir "
+            "foo.proto");
+  ExpectNoErrors();
+  ExpectFileContentNotContainsSubstring("foo.pb.cc", "NoVirtual");
+
+  RunProtoc("protocol_compiler --proto_path=$tmpdir --cpp_out=$tmpdir "
+            "--cpp_opt=experimental_devirtualize_submessages foo.proto");
+  ExpectNoErrors();
+  ExpectFileContentContainsSubstring("foo.pb.cc",
+                                     "InternalWriteMessageNoVirtual(");
+  ExpectFileContentContainsSubstring("foo.pb.cc",
+                                     "InternalWriteGroupNoVirtual(");
+  ExpectFileContentNotContainsSubstring("foo.pb.cc",
+                                        "InternalWriteMessage(");
+}
+
+TEST_F(CppGeneratorTest, FixedLayoutParser) {
+  CreateTempFile("foo.proto",
+                 R"schema(
+    syntax = "proto2";
+    message Point {
+      optional double x = 1;
+      optional double y = 2;
+      optional sint32 z = 3;
+    }
+    message Named {
+      optional double x = 1;
+      optional string name = 2;
+    })schema");
+
+  RunProtoc("protocol_compiler --proto_path=$tmpdir --cpp_out=$tmpdir "
+            "foo.proto");
+  ExpectNoErrors();
+  // Has-bit indices depend on the field layout, so they are not checked.
+  ExpectFileContentContainsSubstring(
+      "foo.pb.cc",
+      "::_pbi::TcParser::FastFixedLayout<::_pbi::TcParser::FixedLayoutField("
+      "::_pbi::TcParser::kFixedLayoutF64, 9, ");
+  ExpectFileContentContainsSubstring("foo.pb.cc",
+                                     "offsetof(Point, _impl_.x_)), "
+                                     "::_pbi::TcParser::FixedLayoutField("
+                                     "::_pbi::TcParser::kFixedLayoutF64, 17, ");
+  ExpectFileContentContainsSubstring("foo.pb.cc",
+                                     "offsetof(Point, _impl_.y_)), "
+                                     "::_pbi::TcParser::FixedLayoutField("
+                                     "::_pbi::TcParser::kFixedLayoutZ32, 24, ");
+  ExpectFileContentContainsSubstring("foo.pb.cc",
+                                     "offsetof(Point, _impl_.z_))>");
+  ExpectFileContentNotContainsSubstring("foo.pb.cc",
+                                        "offsetof(Named, _impl_.x_)");
+}
+
 TEST_F(CppGeneratorTest, BasicError) {
   CreateTempFile("foo.proto",
                  R"schema(
@@ -48,6 +48,7 @@
 #include "google/protobuf/compiler/cpp/names.h"
 #include "google/protobuf/compiler/cpp/options.h"
 #include "google/protobuf/compiler/scc.h"
+#include "google/protobuf/compiler/split_map.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/descriptor.pb.h"
 #include "google/protobuf/dynamic_message.h"
@@ -1216,8 +1217,47 @@ VerifySimpleType ShouldVerifySimple(const Descriptor* descriptor) {
   return VerifySimpleType::kCustom;
 }
 
-bool ShouldSplit(const Descriptor*, const Options&) { return false; }
-bool ShouldSplit(const FieldDescriptor*, const Options&) { return false; }
+namespace {
+
+// Whether the message may have split fields at all.  The split struct is
+// created through reflection, so splitting requires the full runtime.
+bool CanSplit(const Descriptor* desc, const Options& options) {
+  if (options.split_map == nullptr && !options.force_split) return false;
+  return HasDescriptorMethods(desc->file(), options) &&
+         GetOptimizeFor(desc->file(), options) == FileOptions::SPEED &&
+         !desc->options().map_entry() && !HasSimpleBaseClass(desc, options);
+}
+
+// Whether the field is requested to be split and its storage can be moved
+// out of the message object.  Does not check the containing message.  The
+// split struct must be trivially copyable, so map fields and singular cord
+// fields, which are held by value, stay in the message.
+bool ShouldSplitField(const FieldDescriptor* field, const Options& options) {
+  if (field->is_extension() || field->real_containing_oneof() != nullptr ||
+      IsWeak(field, options) || IsStringInlined(field, options) ||
+      field->options().lazy() || field->options().unverified_lazy() ||
+      field->is_map() || (!field->is_repeated() && IsCord(field))) {
+    return false;
+  }
+  return options.force_split ||
+         (options.split_map != nullptr && options.split_map->Contains(field));
+}
+
+}  // namespace
+
+bool ShouldSplit(const Descriptor* desc, const Options& options) {
+  if (!CanSplit(desc, options)) return false;
+  for (const FieldDescriptor* field : FieldRange(desc)) {
+    if (ShouldSplitField(field, options)) return true;
+  }
+  return false;
+}
+
+bool ShouldSplit(const FieldDescriptor* field, const Options& options) {
+  return !field->is_extension() &&
+         CanSplit(field->containing_type(), options) &&
+         ShouldSplitField(field, options);
+}
 
 bool ShouldForceAllocationOnConstruction(const Descriptor* desc,
                                          const Options& options) {
@@ -780,6 +780,51 @@ void MessageGenerator::AddGenerators(
   }
 }
 
+void MessageGenerator::GenerateVisitField(io::Printer* p,
+                                          const FieldDescriptor* field) const {
+  std::vector<absl::string_view> flags;
+  if (field->is_repeated()) flags.push_back("kVisitRepeated");
+  if (field->is_map()) flags.push_back("kVisitMap");
+  if (field->real_containing_oneof() != nullptr) {
+    flags.push_back("kVisitOneof");
+  }
+  if (flags.empty()) flags.push_back("kVisitSingular");
+
+  p->Emit(
+      {{"name", FieldName(field)},
+       {"proto_name", field->name()},
+       {"number", field->number()},
+       {"type", absl::AsciiStrToUpper(FieldDescriptor::TypeName(
+                    field->is_map() ? FieldDescriptor::TYPE_MESSAGE
+                                    : field->type()))},
+       io::Printer::Sub("flags",
+                        [&] {
+                          for (size_t i = 0; i < flags.size(); ++i) {
+                            p->Emit({{"flag", flags[i]},
+                                     {"sep", i == 0 ? "" : " | "}},
+                                    "$sep$$pbi$::$flag$");
+                          }
+                        })
+           .WithSuffix(""),
+       {"is_present",
+        [&] {
+          if (field->is_repeated()) {
+            p->Emit("msg.$name$_size() > 0");
+          } else if (field->has_presence()) {
+            p->Emit("msg.has_$name$()");
+          } else {
+            p->Emit("$pbi$::IsImplicitPresenceFieldSet(msg.$name$())");
+          }
+        }}},
+      R"cc(
+        if ($is_present$) {
+          $pbi$::VisitGeneratedField<$number$, $pbi$::WireFormatLite::TYPE_$type$,
+                                     $flags$, &$classname$::clear_$name$>(
+              msg, "$proto_name$", msg.$name$(), visitor);
+        }
+      )cc");
+}
+
 void MessageGenerator::GenerateFieldAccessorDeclarations(io::Printer* p) {
   auto v = p->WithVars(MessageVars(descriptor_));
 
@@ -2209,6 +2254,27 @@ void MessageGenerator::GenerateClassDefinition(io::Printer* p) {
        {"proto2_message_sets",
         [&] {
         }},
+       {"decl_visit_fields",
+        [&] {
+          p->Emit(
+              {{"visit_fields",
+                [&] {
+                  for (auto field : FieldRange(descriptor_)) {
+                    // Weak fields are not supported, like in
+                    // ReflectionVisit::VisitFields.
+                    if (IsWeak(field, options_)) continue;
+                    GenerateVisitField(p, field);
+                  }
+                }}},
+              R"cc(
+                //~ Expands to direct calls of the accessors of all fields, in
+                //~ declaration order. See google/protobuf/visit_fields.h.
+                template <typename MessageT, typename VisitorT>
+                static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+                  $visit_fields$;
+                }
+              )cc");
+        }},
        {"decl_set_has",
         [&] {
           for (auto field : FieldRange(descriptor_)) {
@@ -2383,6 +2449,7 @@ void MessageGenerator::GenerateClassDefinition(io::Printer* p) {
           $decl_field_accessors$;
           $decl_extension_ids$;
           $proto2_message_sets$;
+          $decl_visit_fields$;
           // @@protoc_insertion_point(class_scope:$full_name$)
           //~ Generate private members.
          private:
@@ -94,6 +94,10 @@ class MessageGenerator {
   void GenerateFieldAccessorDeclarations(io::Printer* p);
   void GenerateFieldAccessorDefinitions(io::Printer* p);
 
+  // Generate the call of the google::protobuf::VisitFields() visitor for
+  // `field` in _InternalVisitFields().
+  void GenerateVisitField(io::Printer* p, const FieldDescriptor* field) const;
+
   // Generate constructors and destructor.
   void GenerateStructors(io::Printer* p);
 
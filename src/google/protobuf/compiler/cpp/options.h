@@ -62,6 +62,7 @@ struct Options {
   bool opensource_runtime = false;
   bool annotate_accessor = false;
   bool force_split = false;
+  bool devirtualize_submessages = false;
   bool force_eagerly_verified_lazy =
       google::protobuf::internal::ForceEagerlyVerifiedLazyInProtoc();
   bool force_inline_string = google::protobuf::internal::ForceInlineStringInProtoc();
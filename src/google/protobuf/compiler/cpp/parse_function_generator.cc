@@ -10,8 +10,10 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -19,6 +21,7 @@
 #include "absl/log/absl_log.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "google/protobuf/compiler/cpp/helpers.h"
@@ -591,7 +594,61 @@ $classname$::_table_ = {
   );
 }
 
+std::string ParseFunctionGenerator::FixedLayoutParseFunction() const {
+  // Messages with more fields are rarely sent with all of them present, and
+  // each field adds to the size of the specialized parse function.
+  constexpr int kMaxFixedLayoutFields = 8;
+  if (GetOptimizeFor(descriptor_->file(), options_) != FileOptions::SPEED ||
+      descriptor_->field_count() < 2 ||
+      descriptor_->field_count() > kMaxFixedLayoutFields ||
+      descriptor_->extension_range_count() > 0 ||
+      descriptor_->real_oneof_decl_count() > 0 ||
+      descriptor_->options().map_entry() ||
+      ShouldSplit(descriptor_, options_)) {
+    return "";
+  }
+
+  absl::flat_hash_map<const FieldDescriptor*,
+                      const TailCallTableInfo::FastFieldInfo::Field*>
+      fast_fields;
+  for (const auto& info : tc_table_info_->fast_path_fields) {
+    if (auto* as_field = info.AsField()) {
+      fast_fields[as_field->field] = as_field;
+    }
+  }
+
+  // All fields must be parsed by one of these functions, which implies they
+  // are singular numeric fields with a 1-byte tag and a cached has-bit.
+  static constexpr std::pair<absl::string_view, absl::string_view> kKinds[] = {
+      {"FastV8S1", "kFixedLayoutV8"},   {"FastV32S1", "kFixedLayoutV32"},
+      {"FastV64S1", "kFixedLayoutV64"}, {"FastZ32S1", "kFixedLayoutZ32"},
+      {"FastZ64S1", "kFixedLayoutZ64"}, {"FastF32S1", "kFixedLayoutF32"},
+      {"FastF64S1", "kFixedLayoutF64"},
+  };
+  std::vector<std::string> layout_fields;
+  for (const FieldDescriptor* field : ordered_fields_) {
+    auto it = fast_fields.find(field);
+    if (it == fast_fields.end()) return "";
+    const TailCallTableInfo::FastFieldInfo::Field& fast_field = *it->second;
+    const std::string func_name = TcParseFunctionName(fast_field.func);
+    const auto* kind = std::find_if(
+        std::begin(kKinds), std::end(kKinds),
+        [&](const auto& k) { return absl::EndsWith(func_name, k.first); });
+    if (kind == std::end(kKinds)) return "";
+    layout_fields.push_back(absl::StrCat(
+        "::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::", kind->second,
+        ", ", fast_field.coded_tag, ", ", fast_field.hasbit_idx, ", offsetof(",
+        ClassName(descriptor_), ", ",
+        FieldMemberName(field, /*split=*/false), "))"));
+  }
+  return absl::StrCat("::_pbi::TcParser::FastFixedLayout<",
+                      absl::StrJoin(layout_fields, ", "), ">");
+}
+
 void ParseFunctionGenerator::GenerateFastFieldEntries(io::Printer* p) {
+  // The parse function of a fixed-layout message is placed in the entry of the
+  // first field, which is serialized first.
+  const std::string fixed_layout_func = FixedLayoutParseFunction();
   for (const auto& info : tc_table_info_->fast_path_fields) {
     if (auto* nonfield = info.AsNonField()) {
       // Fast slot that is not associated with a field. Eg end group tags.
@@ -610,8 +667,11 @@ void ParseFunctionGenerator::GenerateFastFieldEntries(io::Printer* p) {
       ABSL_CHECK(!ShouldSplit(as_field->field, options_));
 
       std::string func_name = TcParseFunctionName(as_field->func);
-      if (GetOptimizeFor(as_field->field->file(), options_) ==
-          FileOptions::SPEED) {
+      if (!fixed_layout_func.empty() &&
+          as_field->field == ordered_fields_.front()) {
+        func_name = fixed_layout_func;
+      } else if (GetOptimizeFor(as_field->field->file(), options_) ==
+                 FileOptions::SPEED) {
         // For 1-byte tags we have a more optimized version of the varint parser
         // that can hardcode the offset and has bit.
         if (absl::EndsWith(func_name, "V8S1") ||
@@ -72,6 +72,9 @@ class ParseFunctionGenerator {
   // Generates the tail-call table definition.
   void GenerateTailCallTable(io::Printer* printer);
   void GenerateFastFieldEntries(io::Printer* printer);
+  // Returns the TcParser::FastFixedLayout specialization that parses all the
+  // fields of the message, or an empty string if the message isn't eligible.
+  std::string FixedLayoutParseFunction() const;
   void GenerateFieldEntries(io::Printer* p);
   void GenerateFieldNames(Formatter& format);
 
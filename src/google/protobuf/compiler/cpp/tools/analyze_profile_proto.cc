@@ -448,7 +448,9 @@ static absl::StatusOr<Stats> AnalyzeProfileProto(
   }
   PDProtoAnalyzer analyzer(*access_info);
 
-  if (options.print_unused_threshold) {
+  if (options.print_split_map) {
+    stream << "# Fields to split according to " << proto_profile << "\n";
+  } else if (options.print_unused_threshold) {
     stream << "Unlikely Used Threshold = " << analyzer.UnlikelyUsedThreshold()
            << "\n"
            << "See http://go/pdlazy for more information\n"
@@ -456,6 +458,7 @@ static absl::StatusOr<Stats> AnalyzeProfileProto(
   }
 
   Stats stats;
+  SplitMap split_map;
   for (const MessageAccessInfo* message : SortMessages(*access_info)) {
     if (RE2::PartialMatch(message->name(), regex)) {
       const Descriptor* descriptor =
@@ -471,6 +474,12 @@ static absl::StatusOr<Stats> AnalyzeProfileProto(
           PDProtoAnalysis analysis = analyzer.AnalyzeField(field);
           PDProtoOptimization optimized = analyzer.OptimizeField(field);
           Aggregate(field, analysis, optimized, stats);
+          if (options.print_split_map) {
+            if (optimized == PDProtoOptimization::kSplit) {
+              split_map.AddField(field->full_name());
+            }
+            continue;
+          }
           if (options.print_all_fields || options.print_analysis ||
               (options.print_optimized &&
                (optimized != PDProtoOptimization::kNone))) {
@@ -512,7 +521,9 @@ static absl::StatusOr<Stats> AnalyzeProfileProto(
       }
     }
   }
-  if (options.print_analysis) {
+  if (options.print_split_map) {
+    stream << split_map.Serialize();
+  } else if (options.print_analysis) {
     stream << stats;
   }
   return stats;
@@ -30,6 +30,11 @@ struct AnalyzeProfileProtoOptions {
   // true to include presence probability info
   bool print_analysis_all = false;
 
+  // true to print a split map instead of the analysis: the fields that would
+  // be optimized as SPLIT, in the format of the C++ generator's
+  // `split_map_file` option.
+  bool print_split_map = false;
+
   // Descriptor pool to use. Must not be null.
   const DescriptorPool* pool = nullptr;
 
@@ -12,6 +12,9 @@
 // It can also take a directory as input and print out the aggregated analysis
 // for all the PDProto profiles under the directory. This is useful when we want
 // to get some statistics for the fleet.
+//
+// With --split_map, it instead prints the fields that it would split, in the
+// format accepted by the C++ generator's split_map_file option.
 
 #include <unistd.h>
 
@@ -45,6 +48,10 @@ ABSL_FLAG(bool, print_unused_threshold, true,
 ABSL_FLAG(bool, print_optimized, true,
           "Print the PDProto optimizations that would be applied to the "
           "field.");
+ABSL_FLAG(bool, split_map, false,
+          "Print a split map listing the fields to split instead of the "
+          "analysis. The output can be passed to protoc with "
+          "--cpp_opt=split_map_file=<file>.");
 ABSL_FLAG(bool, aggregate_analysis, false,
           "If set, will recursively find proto.profile in the given dir and "
           "print the aggregated analysis.");
@@ -128,12 +135,16 @@ int main(int argc, char* argv[]) {
       << error_file;
   google::protobuf::compiler::tools::ErrorSink error_sink(error_file);
   google::protobuf::DescriptorPool pool(google::protobuf::util::globaldb::global(), &error_sink);
+  ABSL_QCHECK(!absl::GetFlag(FLAGS_split_map) ||
+              !absl::GetFlag(FLAGS_aggregate_analysis))
+      << "--split_map can't be combined with --aggregate_analysis";
   const AnalyzeProfileProtoOptions options = {
       .print_unused_threshold = absl::GetFlag(FLAGS_print_unused_threshold),
       .print_optimized = absl::GetFlag(FLAGS_print_optimized),
       .print_all_fields = absl::GetFlag(FLAGS_all),
       .print_analysis = absl::GetFlag(FLAGS_analysis),
       .print_analysis_all = absl::GetFlag(FLAGS_analysis_all),
+      .print_split_map = absl::GetFlag(FLAGS_split_map),
       .pool = &pool,
       .message_filter = absl::GetFlag(FLAGS_message_filter),
       .sort_output_by_file_name = absl::GetFlag(FLAGS_sort_output_by_file_name),
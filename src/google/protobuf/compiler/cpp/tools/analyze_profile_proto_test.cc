@@ -23,6 +23,7 @@ namespace tools {
 namespace {
 
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 std::string AnalyzeToText(const AccessInfo& info,
                           AnalyzeProfileProtoOptions options) {
@@ -131,6 +132,41 @@ TEST(AnalyzeProfileProtoTest, UnlikelyPresent) {
                "  Nested nested: SPLIT\n");
 }
 
+TEST(AnalyzeProfileProtoTest, PrintSplitMap) {
+  if (google::protobuf::internal::ForceInlineStringInProtoc()) {
+    GTEST_SKIP() << "Forced layout invalidates the test.";
+  }
+  AccessInfo info = ParseTextOrDie(R"pb(
+    language: "cpp"
+    message {
+      name: "google::protobuf::compiler::tools::AnalyzeThis"
+      count: 100
+      field { name: "id" getters_count: 0 }
+      field { name: "optional_string" getters_count: 0 }
+      field { name: "optional_child" getters_count: 100 }
+      field { name: "repeated_string" getters_count: 0 }
+      field { name: "repeated_child" getters_count: 0 }
+      field { name: "nested" getters_count: 0 }
+    }
+  )pb");
+  AnalyzeProfileProtoOptions options;
+  options.print_split_map = true;
+  options.pool = DescriptorPool::generated_pool();
+  std::string text = AnalyzeToText(info, options);
+  EXPECT_THAT(text, HasSubstr("# Fields to split according to "));
+  EXPECT_THAT(text, HasSubstr("\n"
+                              "google.protobuf.compiler.tools.AnalyzeThis.id\n"
+                              "google.protobuf.compiler.tools.AnalyzeThis"
+                              ".nested\n"
+                              "google.protobuf.compiler.tools.AnalyzeThis"
+                              ".optional_string\n"
+                              "google.protobuf.compiler.tools.AnalyzeThis"
+                              ".repeated_child\n"
+                              "google.protobuf.compiler.tools.AnalyzeThis"
+                              ".repeated_string\n"));
+  EXPECT_THAT(text, Not(HasSubstr("optional_child")));
+}
+
 TEST(AnalyzeProfileProtoTest, ChildLikelyPresentAndRarelyUsed) {
   if (google::protobuf::internal::ForceInlineStringInProtoc()) {
     GTEST_SKIP() << "Forced layout invalidates the test.";
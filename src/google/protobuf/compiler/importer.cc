@@ -24,6 +24,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/match.h"
@@ -31,10 +32,14 @@
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
+#include "google/protobuf/compiler/cache_entry.h"
 #include "google/protobuf/compiler/parser.h"
+#include "google/protobuf/descriptor.h"
 #include "google/protobuf/descriptor.pb.h"
 #include "google/protobuf/io/tokenizer.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/message.h"
 #include "google/protobuf/text_format.h"
 
 #ifdef _WIN32
@@ -86,6 +91,7 @@ class SourceTreeDescriptorDatabase::SingleFileErrorCollector
   ~SingleFileErrorCollector() override = default;
 
   bool had_errors() { return had_errors_; }
+  bool had_warnings() { return had_warnings_; }
 
   // implements ErrorCollector ---------------------------------------
   void RecordError(int line, int column, absl::string_view message) override {
@@ -101,14 +107,49 @@ class SourceTreeDescriptorDatabase::SingleFileErrorCollector
       multi_file_error_collector_->RecordWarning(filename_, line, column,
                                                  message);
     }
+    had_warnings_ = true;
   }
 
  private:
   std::string filename_;
   MultiFileErrorCollector* multi_file_error_collector_;
   bool had_errors_;
+  bool had_warnings_ = false;
 };
 
+namespace {
+
+void ReadContents(io::ZeroCopyInputStream* input, std::string* contents) {
+  const void* data;
+  int size;
+  while (input->Next(&data, &size)) {
+    contents->append(static_cast<const char*>(data), size);
+  }
+}
+
+// Appends `message` and all of its submessages to `submessages`, in an order
+// which only depends on the contents of `message`.
+void CollectSubmessages(const Message& message,
+                        std::vector<const Message*>* submessages) {
+  submessages->push_back(&message);
+  const Reflection* reflection = message.GetReflection();
+  const Descriptor* descriptor = message.GetDescriptor();
+  for (int i = 0; i < descriptor->field_count(); ++i) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) continue;
+    if (field->is_repeated()) {
+      for (int j = 0; j < reflection->FieldSize(message, field); ++j) {
+        CollectSubmessages(reflection->GetRepeatedMessage(message, field, j),
+                           submessages);
+      }
+    } else if (reflection->HasField(message, field)) {
+      CollectSubmessages(reflection->GetMessage(message, field), submessages);
+    }
+  }
+}
+
+}  // namespace
+
 // ===================================================================
 
 SourceTreeDescriptorDatabase::SourceTreeDescriptorDatabase(
@@ -144,9 +185,34 @@ bool SourceTreeDescriptorDatabase::FindFileByName(StringViewArg filename,
     return false;
   }
 
+  // The whole file is read up front, so that the tokenizer works on a single
+  // buffer and so that the contents can be compared with the parse cache.
+  std::string contents;
+  ReadContents(input.get(), &contents);
+  input.reset();
+
+  const std::string cache_file = ParseCacheFileName(filename, contents);
+  std::string serialized;
+  if (!cache_file.empty() &&
+      internal::ReadCacheEntry(cache_file, {filename, contents}, &serialized) &&
+      output->ParseFromString(serialized)) {
+    if (using_validation_error_collector_) {
+      // The pool deletes `output` once it is done with it, so only the
+      // addresses are kept, to be compared with those of reported errors.
+      std::vector<const Message*>& submessages = cached_files_[filename];
+      submessages.clear();
+      CollectSubmessages(*output, &submessages);
+    }
+    return ReadExtensionDeclarations(filename, output);
+  }
+  output->Clear();
+  cached_files_.erase(filename);
+
   // Set up the tokenizer and parser.
   SingleFileErrorCollector file_error_collector(filename, error_collector_);
-  io::Tokenizer tokenizer(input.get(), &file_error_collector);
+  io::ArrayInputStream contents_input(contents.data(),
+                                      static_cast<int>(contents.size()));
+  io::Tokenizer tokenizer(&contents_input, &file_error_collector);
 
   Parser parser;
   if (error_collector_ != nullptr) {
@@ -158,9 +224,79 @@ bool SourceTreeDescriptorDatabase::FindFileByName(StringViewArg filename,
 
   // Parse it.
   output->set_name(filename);
-  return parser.Parse(&tokenizer, output) &&
-         !file_error_collector.had_errors() &&
-         ReadExtensionDeclarations(filename, output);
+  if (!parser.Parse(&tokenizer, output) || file_error_collector.had_errors()) {
+    return false;
+  }
+  if (!cache_file.empty() && !file_error_collector.had_warnings()) {
+    internal::WriteCacheEntry(cache_file, {filename, contents},
+                              output->SerializeAsString());
+  }
+  return ReadExtensionDeclarations(filename, output);
+}
+
+std::string SourceTreeDescriptorDatabase::ParseCacheFileName(
+    absl::string_view filename, absl::string_view contents) const {
+  if (parse_cache_directory_.empty() || uncached_files_.contains(filename)) {
+    return "";
+  }
+  return internal::CacheEntryName(parse_cache_directory_, {filename, contents});
+}
+
+void SourceTreeDescriptorDatabase::FindErrorLocation(
+    absl::string_view filename, absl::string_view element_name,
+    const Message* descriptor,
+    DescriptorPool::ErrorCollector::ErrorLocation location, int* line,
+    int* column) {
+  const auto find = [&] {
+    if (location == DescriptorPool::ErrorCollector::IMPORT) {
+      return source_locations_.FindImport(descriptor, element_name, line,
+                                          column);
+    }
+    return source_locations_.Find(descriptor, location, line, column);
+  };
+  if (find()) return;
+
+  auto it = cached_files_.find(filename);
+  if (it == cached_files_.end()) return;
+  const std::vector<const Message*> cached = std::move(it->second);
+  cached_files_.erase(it);
+
+  std::unique_ptr<io::ZeroCopyInputStream> input(source_tree_->Open(filename));
+  if (input == nullptr) return;
+  SingleFileErrorCollector file_error_collector(std::string(filename), nullptr);
+  io::Tokenizer tokenizer(input.get(), &file_error_collector);
+  Parser parser;
+  SourceLocationTable locations;
+  parser.RecordSourceLocationsTo(&locations);
+  FileDescriptorProto parsed;
+  if (!parser.Parse(&tokenizer, &parsed)) return;
+
+  // The file was cached with the same contents, so its submessages line up
+  // with those of the cached FileDescriptorProto, which are only compared.
+  std::vector<const Message*> submessages;
+  CollectSubmessages(parsed, &submessages);
+  if (submessages.size() != cached.size()) return;
+  for (size_t i = 0; i < cached.size(); ++i) {
+    for (int j = 0; j <= DescriptorPool::ErrorCollector::OTHER; ++j) {
+      auto error_location =
+          static_cast<DescriptorPool::ErrorCollector::ErrorLocation>(j);
+      int error_line, error_column;
+      if (locations.Find(submessages[i], error_location, &error_line,
+                         &error_column)) {
+        source_locations_.Add(cached[i], error_location, error_line,
+                              error_column);
+      }
+    }
+  }
+  for (const std::string& dependency : parsed.dependency()) {
+    int import_line, import_column;
+    if (locations.FindImport(&parsed, dependency, &import_line,
+                             &import_column)) {
+      source_locations_.AddImport(cached[0], dependency, import_line,
+                                  import_column);
+    }
+  }
+  find();
 }
 
 bool SourceTreeDescriptorDatabase::FindFileContainingSymbol(
@@ -272,12 +408,8 @@ void SourceTreeDescriptorDatabase::ValidationErrorCollector::RecordError(
   if (owner_->error_collector_ == nullptr) return;
 
   int line, column;
-  if (location == DescriptorPool::ErrorCollector::IMPORT) {
-    owner_->source_locations_.FindImport(descriptor, element_name, &line,
-                                         &column);
-  } else {
-    owner_->source_locations_.Find(descriptor, location, &line, &column);
-  }
+  owner_->FindErrorLocation(filename, element_name, descriptor, location, &line,
+                            &column);
   owner_->error_collector_->RecordError(filename, line, column, message);
 }
 
@@ -288,12 +420,8 @@ void SourceTreeDescriptorDatabase::ValidationErrorCollector::RecordWarning(
   if (owner_->error_collector_ == nullptr) return;
 
   int line, column;
-  if (location == DescriptorPool::ErrorCollector::IMPORT) {
-    owner_->source_locations_.FindImport(descriptor, element_name, &line,
-                                         &column);
-  } else {
-    owner_->source_locations_.Find(descriptor, location, &line, &column);
-  }
+  owner_->FindErrorLocation(filename, element_name, descriptor, location, &line,
+                            &column);
   owner_->error_collector_->RecordWarning(filename, line, column, message);
 }
 
@@ -18,6 +18,8 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/string_view.h"
 #include "google/protobuf/compiler/parser.h"
 #include "google/protobuf/descriptor.h"
@@ -100,6 +102,24 @@ class PROTOBUF_EXPORT SourceTreeDescriptorDatabase : public DescriptorDatabase {
                                                       declarations_file_name);
   }
 
+  // Caches the FileDescriptorProtos parsed from the source tree in the given
+  // directory, which must exist.  When a file with the same name and contents
+  // is requested again, even by another process, it is loaded from the cache
+  // instead of being parsed, which saves most of the time spent on large
+  // imports that rarely change.  Files which produced parse warnings are not
+  // cached, so that the warnings are reported every time.  If the
+  // DescriptorPool reports an error in a cached file, the file is parsed again
+  // to find the line and column numbers.
+  void SetParseCacheDirectory(absl::string_view directory) {
+    parse_cache_directory_ = std::string(directory);
+  }
+
+  // Always parses the given file, even if SetParseCacheDirectory() was
+  // called.
+  void DisableParseCacheFor(absl::string_view filename) {
+    uncached_files_.emplace(filename);
+  }
+
   // implements DescriptorDatabase -----------------------------------
   bool FindFileByName(StringViewArg filename,
                       FileDescriptorProto* output) override;
@@ -113,6 +133,20 @@ class PROTOBUF_EXPORT SourceTreeDescriptorDatabase : public DescriptorDatabase {
   bool ReadExtensionDeclarations(absl::string_view filename,
                                  FileDescriptorProto* output) const;
 
+  // Returns the name of the parse cache entry for the given file, or an empty
+  // string if the file is not cached.
+  std::string ParseCacheFileName(absl::string_view filename,
+                                 absl::string_view contents) const;
+
+  // Finds the location of a validation error.  Files loaded from the parse
+  // cache have no recorded locations, so they are parsed again the first time
+  // one of their errors is reported.
+  void FindErrorLocation(absl::string_view filename,
+                         absl::string_view element_name,
+                         const Message* descriptor,
+                         DescriptorPool::ErrorCollector::ErrorLocation location,
+                         int* line, int* column);
+
   class SingleFileErrorCollector;
 
   SourceTree* source_tree_;
@@ -146,6 +180,13 @@ class PROTOBUF_EXPORT SourceTreeDescriptorDatabase : public DescriptorDatabase {
   absl::flat_hash_map<std::string,
                       std::vector<std::pair<std::string, std::string>>>
       declarations_files_;
+  std::string parse_cache_directory_;
+  absl::flat_hash_set<std::string> uncached_files_;
+  // The files last loaded from the parse cache while validation errors were
+  // being collected, and the addresses of the FileDescriptorProtos they were
+  // loaded into and of their submessages.  These are owned by the pool and
+  // only valid while it builds the file, so they are never dereferenced.
+  absl::flat_hash_map<std::string, std::vector<const Message*>> cached_files_;
 };
 
 // Simple interface for parsing .proto files.  This wraps the process
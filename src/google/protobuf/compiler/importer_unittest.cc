@@ -23,7 +23,9 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
+#include "google/protobuf/compiler/cache_entry.h"
 #include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 
 namespace google {
@@ -712,6 +714,171 @@ TEST_F(SourceTreeDescriptorDatabaseTest,
             "is not in the extension range.\n");
 }
 
+constexpr char kFooContents[] =
+    "syntax = \"proto2\";\n"
+    "message Foo {\n"
+    "  optional Bar bar = 1;\n"
+    "}\n";
+
+class ParseCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    cache_directory_ = absl::StrCat(TestTempDir(), "/parse_cache");
+    File::DeleteRecursively(cache_directory_, NULL, NULL);
+    ABSL_CHECK_OK(File::CreateDir(cache_directory_, 0777));
+    source_tree_.AddFile("foo.proto", kFooContents);
+  }
+
+  void TearDown() override {
+    File::DeleteRecursively(cache_directory_, NULL, NULL);
+  }
+
+  // Builds foo.proto, which refers to an undefined type, and returns the
+  // error.
+  std::string BuildError(bool use_cache) {
+    SourceTreeDescriptorDatabase database(&source_tree_);
+    if (use_cache) database.SetParseCacheDirectory(cache_directory_);
+    MockErrorCollector error_collector;
+    database.RecordErrorsTo(&error_collector);
+    DescriptorPool pool(&database, database.GetValidationErrorCollector());
+    EXPECT_EQ(pool.FindFileByName("foo.proto"), nullptr);
+    return error_collector.text_;
+  }
+
+  std::string cache_directory_;
+  MockSourceTree source_tree_;
+};
+
+TEST_F(ParseCacheTest, ReturnsParsedFile) {
+  FileDescriptorProto expected;
+  SourceTreeDescriptorDatabase uncached(&source_tree_);
+  ASSERT_TRUE(uncached.FindFileByName("foo.proto", &expected));
+
+  for (int i = 0; i < 2; ++i) {
+    SourceTreeDescriptorDatabase database(&source_tree_);
+    database.SetParseCacheDirectory(cache_directory_);
+    FileDescriptorProto file_proto;
+    ASSERT_TRUE(database.FindFileByName("foo.proto", &file_proto));
+    EXPECT_EQ(file_proto.DebugString(), expected.DebugString());
+  }
+}
+
+TEST_F(ParseCacheTest, SkipsParsing) {
+  // Replace the entry for foo.proto, which is then returned instead of the
+  // parsed file.
+  FileDescriptorProto cached;
+  cached.set_name("foo.proto");
+  cached.add_message_type()->set_name("Cached");
+  internal::WriteCacheEntry(
+      internal::CacheEntryName(cache_directory_, {"foo.proto", kFooContents}),
+      {"foo.proto", kFooContents}, cached.SerializeAsString());
+
+  SourceTreeDescriptorDatabase database(&source_tree_);
+  database.SetParseCacheDirectory(cache_directory_);
+  FileDescriptorProto file_proto;
+  ASSERT_TRUE(database.FindFileByName("foo.proto", &file_proto));
+  EXPECT_EQ(file_proto.DebugString(), cached.DebugString());
+}
+
+TEST_F(ParseCacheTest, ReportsErrorLocationsInCachedFiles) {
+  // The second build loads foo.proto from the cache, and parses it again only
+  // to locate the error.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(BuildError(/*use_cache=*/true),
+              "foo.proto:2:11: \"Bar\" is not defined.\n");
+  }
+}
+
+TEST_F(ParseCacheTest, ReportsImportLocationsInCachedFiles) {
+  source_tree_.AddFile("foo.proto",
+                       "syntax = \"proto2\";\n"
+                       "import \"bar.proto\";\n"
+                       "message Foo {}\n");
+  source_tree_.AddFile("bar.proto",
+                       "syntax = \"proto2\";\n"
+                       "message Bar {\n"
+                       "  optional Baz baz = 1;\n"
+                       "}\n");
+  const std::string expected = BuildError(/*use_cache=*/false);
+  EXPECT_NE(expected.find("foo.proto:1:0: Import \"bar.proto\""),
+            std::string::npos)
+      << expected;
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(BuildError(/*use_cache=*/true), expected);
+  }
+}
+
+TEST_F(ParseCacheTest, CachedFilesOutliveTheirBuild) {
+  source_tree_.AddFile("foo.proto",
+                       "syntax = \"proto2\";\n"
+                       "message Foo {}\n");
+  SourceTreeDescriptorDatabase database(&source_tree_);
+  database.SetParseCacheDirectory(cache_directory_);
+  MockErrorCollector error_collector;
+  database.RecordErrorsTo(&error_collector);
+  // The second pool loads foo.proto from the cache, and deletes the
+  // FileDescriptorProto it was loaded into once it has been built.
+  for (int i = 0; i < 2; ++i) {
+    DescriptorPool pool(&database, database.GetValidationErrorCollector());
+    ASSERT_NE(pool.FindFileByName("foo.proto"), nullptr);
+  }
+
+  // Errors later reported for another foo.proto have no location.
+  FileDescriptorProto file_proto;
+  file_proto.set_name("foo.proto");
+  file_proto.add_message_type()->set_name("Foo");
+  file_proto.add_message_type()->set_name("Foo");
+  DescriptorPool pool;
+  EXPECT_EQ(pool.BuildFileCollectingErrors(
+                file_proto, database.GetValidationErrorCollector()),
+            nullptr);
+  EXPECT_EQ(error_collector.text_,
+            "foo.proto:-1:0: \"Foo\" is already defined.\n");
+}
+
+TEST_F(ParseCacheTest, ChecksContents) {
+  BuildError(/*use_cache=*/true);
+  source_tree_.AddFile("foo.proto",
+                       "syntax = \"proto2\";\n"
+                       "message Foo {\n"
+                       "  optional Baz baz = 1;\n"
+                       "}\n");
+  EXPECT_EQ(BuildError(/*use_cache=*/true),
+            "foo.proto:2:11: \"Baz\" is not defined.\n");
+}
+
+TEST_F(ParseCacheTest, DisableParseCacheFor) {
+  BuildError(/*use_cache=*/true);
+
+  SourceTreeDescriptorDatabase database(&source_tree_);
+  database.SetParseCacheDirectory(cache_directory_);
+  database.DisableParseCacheFor("foo.proto");
+  MockErrorCollector error_collector;
+  database.RecordErrorsTo(&error_collector);
+  DescriptorPool pool(&database, database.GetValidationErrorCollector());
+  EXPECT_EQ(pool.FindFileByName("foo.proto"), nullptr);
+  EXPECT_EQ(error_collector.text_,
+            "foo.proto:2:11: \"Bar\" is not defined.\n");
+}
+
+TEST_F(ParseCacheTest, DoesNotCacheFilesWithWarnings) {
+  source_tree_.AddFile("foo.proto",
+                       "syntax = \"proto2\";\n"
+                       "message Foo {\n"
+                       "  reserved \"not an identifier\";\n"
+                       "}\n");
+
+  for (int i = 0; i < 2; ++i) {
+    SourceTreeDescriptorDatabase database(&source_tree_);
+    database.SetParseCacheDirectory(cache_directory_);
+    MockErrorCollector error_collector;
+    database.RecordErrorsTo(&error_collector);
+    FileDescriptorProto file_proto;
+    ASSERT_TRUE(database.FindFileByName("foo.proto", &file_proto));
+    EXPECT_NE(error_collector.warning_text_, "");
+  }
+}
+
 }  // namespace
 
 }  // namespace compiler
@@ -289,6 +289,9 @@ class PROTOC_EXPORT JavaFeatures_NestInFileClassFeature final : public ::google:
   }
 
   // accessors -------------------------------------------------------
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+  }
   // @@protoc_insertion_point(class_scope:pb.JavaFeatures.NestInFileClassFeature)
  private:
   class _Internal;
@@ -541,6 +544,34 @@ class PROTOC_EXPORT JavaFeatures final : public ::google::protobuf::Message
   void _internal_set_nest_in_file_class(::pb::JavaFeatures_NestInFileClassFeature_NestInFileClass value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_legacy_closed_enum()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &JavaFeatures::clear_legacy_closed_enum>(
+          msg, "legacy_closed_enum", msg.legacy_closed_enum(), visitor);
+    }
+    if (msg.has_utf8_validation()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &JavaFeatures::clear_utf8_validation>(
+          msg, "utf8_validation", msg.utf8_validation(), visitor);
+    }
+    if (msg.has_large_enum()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &JavaFeatures::clear_large_enum>(
+          msg, "large_enum", msg.large_enum(), visitor);
+    }
+    if (msg.has_use_old_outer_classname_default()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &JavaFeatures::clear_use_old_outer_classname_default>(
+          msg, "use_old_outer_classname_default", msg.use_old_outer_classname_default(), visitor);
+    }
+    if (msg.has_nest_in_file_class()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &JavaFeatures::clear_nest_in_file_class>(
+          msg, "nest_in_file_class", msg.nest_in_file_class(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:pb.JavaFeatures)
  private:
   class _Internal;
@@ -223,6 +223,10 @@ bool MockCodeGenerator::Generate(const FileDescriptor* file,
   // Override minimum/maximum after generating the pool to simulate a plugin
   // that "works" but doesn't advertise support of the current edition.
   absl::string_view test_case = GetTestCase();
+  if (test_case == "fail_if_called") {
+    *error = "Generator was called.";
+    return false;
+  }
   if (test_case == "high_minimum") {
     minimum_edition_ = Edition::EDITION_99997_TEST_ONLY;
   } else if (test_case == "low_maximum") {
@@ -330,6 +330,29 @@ class PROTOC_EXPORT Version final : public ::google::protobuf::Message
   void _internal_set_patch(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_major()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Version::clear_major>(
+          msg, "major", msg.major(), visitor);
+    }
+    if (msg.has_minor()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Version::clear_minor>(
+          msg, "minor", msg.minor(), visitor);
+    }
+    if (msg.has_patch()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Version::clear_patch>(
+          msg, "patch", msg.patch(), visitor);
+    }
+    if (msg.has_suffix()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Version::clear_suffix>(
+          msg, "suffix", msg.suffix(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.compiler.Version)
  private:
   class _Internal;
@@ -585,6 +608,29 @@ class PROTOC_EXPORT CodeGeneratorResponse_File final : public ::google::protobuf
   ::google::protobuf::GeneratedCodeInfo* PROTOBUF_NONNULL _internal_mutable_generated_code_info();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse_File::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_insertion_point()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse_File::clear_insertion_point>(
+          msg, "insertion_point", msg.insertion_point(), visitor);
+    }
+    if (msg.has_content()) {
+      ::google::protobuf::internal::VisitGeneratedField<15, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse_File::clear_content>(
+          msg, "content", msg.content(), visitor);
+    }
+    if (msg.has_generated_code_info()) {
+      ::google::protobuf::internal::VisitGeneratedField<16, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse_File::clear_generated_code_info>(
+          msg, "generated_code_info", msg.generated_code_info(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.compiler.CodeGeneratorResponse.File)
  private:
   class _Internal;
@@ -867,6 +913,34 @@ class PROTOC_EXPORT CodeGeneratorResponse final : public ::google::protobuf::Mes
   void _internal_set_maximum_edition(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_error()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse::clear_error>(
+          msg, "error", msg.error(), visitor);
+    }
+    if (msg.has_supported_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse::clear_supported_features>(
+          msg, "supported_features", msg.supported_features(), visitor);
+    }
+    if (msg.has_minimum_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse::clear_minimum_edition>(
+          msg, "minimum_edition", msg.minimum_edition(), visitor);
+    }
+    if (msg.has_maximum_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorResponse::clear_maximum_edition>(
+          msg, "maximum_edition", msg.maximum_edition(), visitor);
+    }
+    if (msg.file_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<15, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &CodeGeneratorResponse::clear_file>(
+          msg, "file", msg.file(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.compiler.CodeGeneratorResponse)
  private:
   class _Internal;
@@ -1154,6 +1228,34 @@ class PROTOC_EXPORT CodeGeneratorRequest final : public ::google::protobuf::Mess
   const ::google::protobuf::FileDescriptorProto& source_file_descriptors(int index) const;
   ::google::protobuf::FileDescriptorProto* PROTOBUF_NONNULL add_source_file_descriptors();
   const ::google::protobuf::RepeatedPtrField<::google::protobuf::FileDescriptorProto>& source_file_descriptors() const;
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.file_to_generate_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &CodeGeneratorRequest::clear_file_to_generate>(
+          msg, "file_to_generate", msg.file_to_generate(), visitor);
+    }
+    if (msg.has_parameter()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorRequest::clear_parameter>(
+          msg, "parameter", msg.parameter(), visitor);
+    }
+    if (msg.proto_file_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<15, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &CodeGeneratorRequest::clear_proto_file>(
+          msg, "proto_file", msg.proto_file(), visitor);
+    }
+    if (msg.source_file_descriptors_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<17, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &CodeGeneratorRequest::clear_source_file_descriptors>(
+          msg, "source_file_descriptors", msg.source_file_descriptors(), visitor);
+    }
+    if (msg.has_compiler_version()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &CodeGeneratorRequest::clear_compiler_version>(
+          msg, "compiler_version", msg.compiler_version(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.compiler.CodeGeneratorRequest)
  private:
   class _Internal;
@@ -0,0 +1,109 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/compiler/split_map.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/strip.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace {
+
+bool IsValidFullName(absl::string_view name) {
+  for (absl::string_view part : absl::StrSplit(name, '.')) {
+    if (part.empty() || absl::ascii_isdigit(part[0])) return false;
+    for (char c : part) {
+      if (!absl::ascii_isalnum(c) && c != '_') return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+absl::StatusOr<SplitMap> SplitMap::Parse(absl::string_view contents) {
+  SplitMap split_map;
+  int line_number = 0;
+  for (absl::string_view line : absl::StrSplit(contents, '\n')) {
+    ++line_number;
+    line = line.substr(0, line.find('#'));
+    line = absl::StripAsciiWhitespace(line);
+    if (line.empty()) continue;
+    // Allow names to be written with the leading dot used in type names.
+    line = absl::StripPrefix(line, ".");
+    if (!IsValidFullName(line)) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Line ", line_number, ": \"", line, "\" is not a field name."));
+    }
+    split_map.AddField(line);
+  }
+  return split_map;
+}
+
+absl::StatusOr<SplitMap> SplitMap::ReadFromFile(const std::string& path) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return absl::NotFoundError(
+        absl::StrCat("Could not open split map file: ", path));
+  }
+  std::string contents;
+  char buffer[4096];
+  while (true) {
+    size_t n = fread(buffer, 1, sizeof(buffer), file);
+    if (n == 0) break;
+    contents.append(buffer, n);
+  }
+  int error = ferror(file);
+  fclose(file);
+  if (error != 0) {
+    return absl::InternalError(
+        absl::StrCat("Could not read split map file: ", path));
+  }
+
+  absl::StatusOr<SplitMap> split_map = Parse(contents);
+  if (!split_map.ok()) {
+    return absl::InvalidArgumentError(
+        absl::StrCat(path, ": ", split_map.status().message()));
+  }
+  return split_map;
+}
+
+void SplitMap::AddField(absl::string_view full_name) {
+  fields_.emplace(full_name);
+}
+
+std::string SplitMap::Serialize() const {
+  std::vector<absl::string_view> names(fields_.begin(), fields_.end());
+  std::sort(names.begin(), names.end());
+  std::string result;
+  for (absl::string_view name : names) {
+    absl::StrAppend(&result, name, "\n");
+  }
+  return result;
+}
+
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
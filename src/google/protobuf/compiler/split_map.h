@@ -0,0 +1,77 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// A SplitMap lists the message fields that the C++ generator moves out of the
+// message object into a separately allocated "split" struct.  The split struct
+// is shared with the default instance until one of its fields is set, so
+// splitting the fields that are rarely present shrinks the message object and
+// keeps the fields that are present closer together in memory.
+//
+// A split map is passed to the C++ generator as a file, with
+// `--cpp_opt=split_map_file=PATH`.  The file lists one field per line by its
+// fully-qualified name, and `#` starts a comment:
+//
+//   # Fields that are present in less than 0.5% of the messages.
+//   foo.bar.Baz.rarely_set_field
+//   foo.bar.Baz.NestedMessage.other_field
+//
+// Fields that can't be split (for example, oneof members, map fields, weak
+// fields or fields of lite messages) are ignored.
+
+#ifndef GOOGLE_PROTOBUF_COMPILER_SPLIT_MAP_H__
+#define GOOGLE_PROTOBUF_COMPILER_SPLIT_MAP_H__
+
+#include <string>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/descriptor.h"
+
+// Must appear last
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+
+class PROTOC_EXPORT SplitMap {
+ public:
+  SplitMap() = default;
+
+  // Parses the contents of a split map file.
+  static absl::StatusOr<SplitMap> Parse(absl::string_view contents);
+
+  // Reads and parses the split map file at `path`.
+  static absl::StatusOr<SplitMap> ReadFromFile(const std::string& path);
+
+  // Adds the field with the given fully-qualified name to the map.
+  void AddField(absl::string_view full_name);
+
+  // Returns true if the field is listed in the map.
+  bool Contains(const FieldDescriptor* field) const {
+    return fields_.contains(field->full_name());
+  }
+
+  bool empty() const { return fields_.empty(); }
+  size_t size() const { return fields_.size(); }
+
+  // Returns the map in the format accepted by Parse(), with the fields sorted
+  // by name.
+  std::string Serialize() const;
+
+ private:
+  absl::flat_hash_set<std::string> fields_;
+};
+
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_COMPILER_SPLIT_MAP_H__
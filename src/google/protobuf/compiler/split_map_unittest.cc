@@ -0,0 +1,197 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/compiler/split_map.h"
+
+#include <string>
+
+#include "google/protobuf/descriptor.pb.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/compiler/cpp/helpers.h"
+#include "google/protobuf/compiler/cpp/options.h"
+#include "google/protobuf/compiler/parser.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/io/tokenizer.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/testing/file.h"
+#include "google/protobuf/testing/googletest.h"
+
+namespace google {
+namespace protobuf {
+namespace compiler {
+namespace {
+
+using ::testing::HasSubstr;
+
+class AbortingErrorCollector : public io::ErrorCollector {
+ public:
+  void RecordError(int line, io::ColumnNumber column,
+                   absl::string_view message) override {
+    ABSL_LOG(FATAL) << line << ":" << column << ": " << message;
+  }
+};
+
+class SplitMapTest : public testing::Test {
+ protected:
+  const FileDescriptor* ParseSchema(absl::string_view contents) {
+    io::ArrayInputStream input_stream(contents.data(),
+                                      static_cast<int>(contents.size()));
+    io::Tokenizer tokenizer(&input_stream, &error_collector_);
+    Parser parser;
+    parser.RecordErrorsTo(&error_collector_);
+    FileDescriptorProto file_proto;
+    ABSL_CHECK(parser.Parse(&tokenizer, &file_proto));
+    file_proto.set_name("foo.proto");
+    const FileDescriptor* file = pool_.BuildFile(file_proto);
+    ABSL_CHECK(file != nullptr);
+    return file;
+  }
+
+  const FieldDescriptor* FindField(absl::string_view full_name) {
+    const FieldDescriptor* field = pool_.FindFieldByName(full_name);
+    ABSL_CHECK(field != nullptr) << full_name;
+    return field;
+  }
+
+  AbortingErrorCollector error_collector_;
+  DescriptorPool pool_;
+};
+
+TEST_F(SplitMapTest, Parse) {
+  ParseSchema(R"schema(
+    syntax = "proto2";
+    package foo;
+    message Bar {
+      optional int32 hot = 1;
+      optional int32 cold = 2;
+      message Baz {
+        optional string cold = 1;
+      }
+    }
+  )schema");
+
+  absl::StatusOr<SplitMap> split_map = SplitMap::Parse(
+      "# A comment.\n"
+      "foo.Bar.cold  # Another comment.\n"
+      "\n"
+      "  .foo.Bar.Baz.cold\n");
+  ASSERT_TRUE(split_map.ok()) << split_map.status();
+  EXPECT_EQ(split_map->size(), 2);
+  EXPECT_FALSE(split_map->Contains(FindField("foo.Bar.hot")));
+  EXPECT_TRUE(split_map->Contains(FindField("foo.Bar.cold")));
+  EXPECT_TRUE(split_map->Contains(FindField("foo.Bar.Baz.cold")));
+}
+
+TEST_F(SplitMapTest, ParseEmpty) {
+  absl::StatusOr<SplitMap> split_map = SplitMap::Parse("# Nothing.\n\n");
+  ASSERT_TRUE(split_map.ok()) << split_map.status();
+  EXPECT_TRUE(split_map->empty());
+}
+
+TEST_F(SplitMapTest, ParseInvalidName) {
+  for (absl::string_view contents :
+       {"foo.Bar.cold\nfoo..Bar\n", "foo.Bar.cold\nfoo.Bar.\n",
+        "foo.Bar.cold\nfoo.1Bar\n", "foo.Bar.cold\nfoo.Bar cold\n"}) {
+    absl::StatusOr<SplitMap> split_map = SplitMap::Parse(contents);
+    EXPECT_EQ(split_map.status().code(), absl::StatusCode::kInvalidArgument);
+    EXPECT_THAT(split_map.status().message(), HasSubstr("Line 2:"));
+  }
+}
+
+TEST_F(SplitMapTest, Serialize) {
+  SplitMap split_map;
+  split_map.AddField("foo.Bar.b");
+  split_map.AddField("foo.Bar.a");
+  split_map.AddField("foo.Bar.b");
+  EXPECT_EQ(split_map.Serialize(), "foo.Bar.a\nfoo.Bar.b\n");
+
+  absl::StatusOr<SplitMap> parsed = SplitMap::Parse(split_map.Serialize());
+  ASSERT_TRUE(parsed.ok()) << parsed.status();
+  EXPECT_EQ(parsed->Serialize(), split_map.Serialize());
+}
+
+TEST_F(SplitMapTest, ReadFromFile) {
+  std::string path = absl::StrCat(TestTempDir(), "/split_map_test.txt");
+  ABSL_CHECK_OK(File::SetContents(path, "foo.Bar.a\nfoo.Bar.b\n", true));
+  absl::StatusOr<SplitMap> split_map = SplitMap::ReadFromFile(path);
+  ASSERT_TRUE(split_map.ok()) << split_map.status();
+  EXPECT_EQ(split_map->Serialize(), "foo.Bar.a\nfoo.Bar.b\n");
+
+  ABSL_CHECK_OK(File::SetContents(path, "foo.Bar.a\n-\n", true));
+  split_map = SplitMap::ReadFromFile(path);
+  EXPECT_THAT(split_map.status().message(),
+              HasSubstr(absl::StrCat(path, ": Line 2:")));
+
+  split_map = SplitMap::ReadFromFile(
+      absl::StrCat(TestTempDir(), "/no_such_split_map.txt"));
+  EXPECT_EQ(split_map.status().code(), absl::StatusCode::kNotFound);
+}
+
+TEST_F(SplitMapTest, ShouldSplit) {
+  ParseSchema(R"schema(
+    syntax = "proto2";
+    package foo;
+    message Bar {
+      optional int32 hot = 1;
+      optional int32 cold = 2;
+      repeated string cold_repeated = 3;
+      map<int32, int32> cold_map = 4;
+      oneof kind {
+        int32 cold_oneof = 5;
+      }
+      optional Bar cold_lazy = 6 [lazy = true];
+      optional bytes cold_cord = 7 [ctype = CORD];
+    }
+    message Baz {
+      optional int32 hot = 1;
+    }
+  )schema");
+  absl::StatusOr<SplitMap> split_map = SplitMap::Parse(
+      "foo.Bar.cold\n"
+      "foo.Bar.cold_repeated\n"
+      "foo.Bar.cold_map\n"
+      "foo.Bar.cold_oneof\n"
+      "foo.Bar.cold_lazy\n"
+      "foo.Bar.cold_cord\n");
+  ASSERT_TRUE(split_map.ok()) << split_map.status();
+
+  cpp::Options options;
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold"), options));
+  EXPECT_FALSE(
+      cpp::ShouldSplit(pool_.FindMessageTypeByName("foo.Bar"), options));
+
+  options.split_map = &*split_map;
+  EXPECT_TRUE(
+      cpp::ShouldSplit(pool_.FindMessageTypeByName("foo.Bar"), options));
+  EXPECT_FALSE(
+      cpp::ShouldSplit(pool_.FindMessageTypeByName("foo.Baz"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.hot"), options));
+  EXPECT_TRUE(cpp::ShouldSplit(FindField("foo.Bar.cold"), options));
+  EXPECT_TRUE(cpp::ShouldSplit(FindField("foo.Bar.cold_repeated"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold_map"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold_oneof"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold_lazy"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold_cord"), options));
+
+  // Splitting relies on reflection.
+  options.enforce_mode = cpp::EnforceOptimizeMode::kLiteRuntime;
+  EXPECT_FALSE(
+      cpp::ShouldSplit(pool_.FindMessageTypeByName("foo.Bar"), options));
+  EXPECT_FALSE(cpp::ShouldSplit(FindField("foo.Bar.cold"), options));
+}
+
+}  // namespace
+}  // namespace compiler
+}  // namespace protobuf
+}  // namespace google
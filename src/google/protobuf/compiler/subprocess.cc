@@ -15,16 +15,20 @@
 
 #ifndef _WIN32
 #include <errno.h>
+#include <fcntl.h>
 #include <signal.h>
 #include <sys/select.h>
 #include <sys/wait.h>
 #endif
 
+#include "absl/base/attributes.h"
+#include "absl/base/const_init.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/io/io_win32.h"
 #include "google/protobuf/message.h"
 
@@ -32,6 +36,14 @@ namespace google {
 namespace protobuf {
 namespace compiler {
 
+namespace {
+// Subprocesses may be started from several threads at once, e.g. by protoc
+// running plugins in parallel.  Starting them one at a time keeps the pipes
+// created for one child from being inherited by another, which would keep
+// the first child's stdin open until the second one exits.
+ABSL_CONST_INIT absl::Mutex start_mutex(absl::kConstInit);
+}  // namespace
+
 #ifdef _WIN32
 
 static void CloseHandleOrDie(HANDLE handle) {
@@ -57,6 +69,8 @@ Subprocess::~Subprocess() {
 }
 
 void Subprocess::Start(const std::string& program, SearchMode search_mode) {
+  absl::MutexLock lock(&start_mutex);
+
   // Create the pipes.
   HANDLE stdin_pipe_read;
   HANDLE stdin_pipe_write;
@@ -296,11 +310,33 @@ char* portable_strdup(const char* s) {
   }
   return ns;
 }
+
+void SetCloseOnExec(int fd) {
+  ABSL_CHECK(fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC) != -1);
+}
+
+// SIGPIPE is ignored while any Communicate() is in progress, and the original
+// handler is restored when the last one finishes.
+ABSL_CONST_INIT absl::Mutex sigpipe_mutex(absl::kConstInit);
+int sigpipe_users ABSL_GUARDED_BY(sigpipe_mutex) = 0;
+void (*old_sigpipe_handler)(int) ABSL_GUARDED_BY(sigpipe_mutex) = nullptr;
+
+void IgnoreSigpipe() {
+  absl::MutexLock lock(&sigpipe_mutex);
+  if (sigpipe_users++ == 0) old_sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+}
+
+void RestoreSigpipe() {
+  absl::MutexLock lock(&sigpipe_mutex);
+  if (--sigpipe_users == 0) signal(SIGPIPE, old_sigpipe_handler);
+}
 }  // namespace
 
 void Subprocess::Start(const std::string& program, SearchMode search_mode) {
-  // Note that we assume that there are no other threads, thus we don't have to
-  // do crazy stuff like using socket pairs or avoiding libc locks.
+  // Other threads may be running, but the child only calls dup2(), close()
+  // and exec*() before replacing itself, so it cannot deadlock on a libc lock
+  // held by one of them.
+  absl::MutexLock lock(&start_mutex);
 
   // [0] is read end, [1] is write end.
   int stdin_pipe[2];
@@ -308,6 +344,12 @@ void Subprocess::Start(const std::string& program, SearchMode search_mode) {
 
   ABSL_CHECK(pipe(stdin_pipe) != -1);
   ABSL_CHECK(pipe(stdout_pipe) != -1);
+  // Keep children started by other threads from inheriting these pipes.
+  // dup2() clears the flag on the child's own stdin and stdout.
+  SetCloseOnExec(stdin_pipe[0]);
+  SetCloseOnExec(stdin_pipe[1]);
+  SetCloseOnExec(stdout_pipe[0]);
+  SetCloseOnExec(stdout_pipe[1]);
 
   char* argv[2] = {portable_strdup(program.c_str()), nullptr};
 
@@ -362,17 +404,14 @@ bool Subprocess::Communicate(const Message& input, Message* output,
                              std::string* error) {
   ABSL_CHECK_NE(child_stdin_, -1) << "Must call Start() first.";
 
-  // The "sighandler_t" typedef is GNU-specific, so define our own.
-  typedef void SignalHandler(int);
-
-  // Make sure SIGPIPE is disabled so that if the child dies it doesn't kill us.
-  SignalHandler* old_pipe_handler = signal(SIGPIPE, SIG_IGN);
-
   std::string input_data;
   if (!input.SerializeToString(&input_data)) {
     *error = "Failed to serialize request.";
     return false;
   }
+
+  // Make sure SIGPIPE is disabled so that if the child dies it doesn't kill us.
+  IgnoreSigpipe();
   std::string output_data;
 
   int input_pos = 0;
@@ -446,7 +485,7 @@ bool Subprocess::Communicate(const Message& input, Message* output,
   }
 
   // Restore SIGPIPE handling.
-  signal(SIGPIPE, old_pipe_handler);
+  RestoreSigpipe();
 
   if (WIFEXITED(status)) {
     if (WEXITSTATUS(status) != 0) {
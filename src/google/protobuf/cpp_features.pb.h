@@ -315,6 +315,24 @@ class PROTOBUF_EXPORT CppFeatures final : public ::google::protobuf::Message
   void _internal_set_enum_name_uses_string_view(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_legacy_closed_enum()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &CppFeatures::clear_legacy_closed_enum>(
+          msg, "legacy_closed_enum", msg.legacy_closed_enum(), visitor);
+    }
+    if (msg.has_string_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &CppFeatures::clear_string_type>(
+          msg, "string_type", msg.string_type(), visitor);
+    }
+    if (msg.has_enum_name_uses_string_view()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &CppFeatures::clear_enum_name_uses_string_view>(
+          msg, "enum_name_uses_string_view", msg.enum_name_uses_string_view(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:pb.CppFeatures)
  private:
   class _Internal;
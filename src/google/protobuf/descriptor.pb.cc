@@ -4367,7 +4367,7 @@ DescriptorProto_ReservedRange::_table_ = {
      {16, 1, 0,
       PROTOBUF_FIELD_OFFSET(DescriptorProto_ReservedRange, _impl_.end_)}},
     // optional int32 start = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(DescriptorProto_ReservedRange, _impl_.start_), 0>(),
+    {::_pbi::TcParser::FastFixedLayout<::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV32, 8, 0, offsetof(DescriptorProto_ReservedRange, _impl_.start_)), ::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV32, 16, 1, offsetof(DescriptorProto_ReservedRange, _impl_.end_))>,
      {8, 0, 0,
       PROTOBUF_FIELD_OFFSET(DescriptorProto_ReservedRange, _impl_.start_)}},
   }}, {{
@@ -7215,7 +7215,7 @@ EnumDescriptorProto_EnumReservedRange::_table_ = {
      {16, 1, 0,
       PROTOBUF_FIELD_OFFSET(EnumDescriptorProto_EnumReservedRange, _impl_.end_)}},
     // optional int32 start = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(EnumDescriptorProto_EnumReservedRange, _impl_.start_), 0>(),
+    {::_pbi::TcParser::FastFixedLayout<::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV32, 8, 0, offsetof(EnumDescriptorProto_EnumReservedRange, _impl_.start_)), ::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV32, 16, 1, offsetof(EnumDescriptorProto_EnumReservedRange, _impl_.end_))>,
      {8, 0, 0,
       PROTOBUF_FIELD_OFFSET(EnumDescriptorProto_EnumReservedRange, _impl_.start_)}},
   }}, {{
@@ -1175,6 +1175,19 @@ class PROTOBUF_EXPORT UninterpretedOption_NamePart final : public ::google::prot
   void _internal_set_is_extension(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name_part()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption_NamePart::clear_name_part>(
+          msg, "name_part", msg.name_part(), visitor);
+    }
+    if (msg.has_is_extension()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption_NamePart::clear_is_extension>(
+          msg, "is_extension", msg.is_extension(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.UninterpretedOption.NamePart)
  private:
   class _Internal;
@@ -1457,6 +1470,34 @@ class PROTOBUF_EXPORT SourceCodeInfo_Location final : public ::google::protobuf:
   ::std::string* PROTOBUF_NONNULL _internal_mutable_trailing_comments();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.path_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitRepeated, &SourceCodeInfo_Location::clear_path>(
+          msg, "path", msg.path(), visitor);
+    }
+    if (msg.span_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitRepeated, &SourceCodeInfo_Location::clear_span>(
+          msg, "span", msg.span(), visitor);
+    }
+    if (msg.has_leading_comments()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &SourceCodeInfo_Location::clear_leading_comments>(
+          msg, "leading_comments", msg.leading_comments(), visitor);
+    }
+    if (msg.has_trailing_comments()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &SourceCodeInfo_Location::clear_trailing_comments>(
+          msg, "trailing_comments", msg.trailing_comments(), visitor);
+    }
+    if (msg.leading_detached_comments_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &SourceCodeInfo_Location::clear_leading_detached_comments>(
+          msg, "leading_detached_comments", msg.leading_detached_comments(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.SourceCodeInfo.Location)
  private:
   class _Internal;
@@ -1742,6 +1783,34 @@ class PROTOBUF_EXPORT GeneratedCodeInfo_Annotation final : public ::google::prot
   void _internal_set_semantic(::google::protobuf::GeneratedCodeInfo_Annotation_Semantic value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.path_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitRepeated, &GeneratedCodeInfo_Annotation::clear_path>(
+          msg, "path", msg.path(), visitor);
+    }
+    if (msg.has_source_file()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &GeneratedCodeInfo_Annotation::clear_source_file>(
+          msg, "source_file", msg.source_file(), visitor);
+    }
+    if (msg.has_begin()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &GeneratedCodeInfo_Annotation::clear_begin>(
+          msg, "begin", msg.begin(), visitor);
+    }
+    if (msg.has_end()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &GeneratedCodeInfo_Annotation::clear_end>(
+          msg, "end", msg.end(), visitor);
+    }
+    if (msg.has_semantic()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &GeneratedCodeInfo_Annotation::clear_semantic>(
+          msg, "semantic", msg.semantic(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.GeneratedCodeInfo.Annotation)
  private:
   class _Internal;
@@ -2003,6 +2072,34 @@ class PROTOBUF_EXPORT FieldOptions_FeatureSupport final : public ::google::proto
   void _internal_set_edition_removed(::google::protobuf::Edition value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_edition_introduced()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_FeatureSupport::clear_edition_introduced>(
+          msg, "edition_introduced", msg.edition_introduced(), visitor);
+    }
+    if (msg.has_edition_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_FeatureSupport::clear_edition_deprecated>(
+          msg, "edition_deprecated", msg.edition_deprecated(), visitor);
+    }
+    if (msg.has_deprecation_warning()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_FeatureSupport::clear_deprecation_warning>(
+          msg, "deprecation_warning", msg.deprecation_warning(), visitor);
+    }
+    if (msg.has_edition_removed()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_FeatureSupport::clear_edition_removed>(
+          msg, "edition_removed", msg.edition_removed(), visitor);
+    }
+    if (msg.has_removal_error()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_FeatureSupport::clear_removal_error>(
+          msg, "removal_error", msg.removal_error(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FieldOptions.FeatureSupport)
  private:
   class _Internal;
@@ -2219,6 +2316,19 @@ class PROTOBUF_EXPORT FieldOptions_EditionDefault final : public ::google::proto
   void _internal_set_edition(::google::protobuf::Edition value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_EditionDefault::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+    if (msg.has_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions_EditionDefault::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FieldOptions.EditionDefault)
  private:
   class _Internal;
@@ -2394,6 +2504,9 @@ class PROTOBUF_EXPORT FeatureSet_VisibilityFeature final : public ::google::prot
   }
 
   // accessors -------------------------------------------------------
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FeatureSet.VisibilityFeature)
  private:
   class _Internal;
@@ -3007,6 +3120,49 @@ class PROTOBUF_EXPORT FeatureSet final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_field_presence()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_field_presence>(
+          msg, "field_presence", msg.field_presence(), visitor);
+    }
+    if (msg.has_enum_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_enum_type>(
+          msg, "enum_type", msg.enum_type(), visitor);
+    }
+    if (msg.has_repeated_field_encoding()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_repeated_field_encoding>(
+          msg, "repeated_field_encoding", msg.repeated_field_encoding(), visitor);
+    }
+    if (msg.has_utf8_validation()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_utf8_validation>(
+          msg, "utf8_validation", msg.utf8_validation(), visitor);
+    }
+    if (msg.has_message_encoding()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_message_encoding>(
+          msg, "message_encoding", msg.message_encoding(), visitor);
+    }
+    if (msg.has_json_format()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_json_format>(
+          msg, "json_format", msg.json_format(), visitor);
+    }
+    if (msg.has_enforce_naming_style()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_enforce_naming_style>(
+          msg, "enforce_naming_style", msg.enforce_naming_style(), visitor);
+    }
+    if (msg.has_default_symbol_visibility()) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSet::clear_default_symbol_visibility>(
+          msg, "default_symbol_visibility", msg.default_symbol_visibility(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FeatureSet)
  private:
   class _Internal;
@@ -3271,6 +3427,34 @@ class PROTOBUF_EXPORT ExtensionRangeOptions_Declaration final : public ::google:
   void _internal_set_repeated(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_number()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions_Declaration::clear_number>(
+          msg, "number", msg.number(), visitor);
+    }
+    if (msg.has_full_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions_Declaration::clear_full_name>(
+          msg, "full_name", msg.full_name(), visitor);
+    }
+    if (msg.has_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions_Declaration::clear_type>(
+          msg, "type", msg.type(), visitor);
+    }
+    if (msg.has_reserved()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions_Declaration::clear_reserved>(
+          msg, "reserved", msg.reserved(), visitor);
+    }
+    if (msg.has_repeated()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions_Declaration::clear_repeated>(
+          msg, "repeated", msg.repeated(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.ExtensionRangeOptions.Declaration)
  private:
   class _Internal;
@@ -3482,6 +3666,19 @@ class PROTOBUF_EXPORT EnumDescriptorProto_EnumReservedRange final : public ::goo
   void _internal_set_end(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_start()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumDescriptorProto_EnumReservedRange::clear_start>(
+          msg, "start", msg.start(), visitor);
+    }
+    if (msg.has_end()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumDescriptorProto_EnumReservedRange::clear_end>(
+          msg, "end", msg.end(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumDescriptorProto.EnumReservedRange)
  private:
   class _Internal;
@@ -3690,6 +3887,19 @@ class PROTOBUF_EXPORT DescriptorProto_ReservedRange final : public ::google::pro
   void _internal_set_end(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_start()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto_ReservedRange::clear_start>(
+          msg, "start", msg.start(), visitor);
+    }
+    if (msg.has_end()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto_ReservedRange::clear_end>(
+          msg, "end", msg.end(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.DescriptorProto.ReservedRange)
  private:
   class _Internal;
@@ -3990,6 +4200,44 @@ class PROTOBUF_EXPORT UninterpretedOption final : public ::google::protobuf::Mes
   void _internal_set_double_value(double value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.name_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &UninterpretedOption::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_identifier_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_identifier_value>(
+          msg, "identifier_value", msg.identifier_value(), visitor);
+    }
+    if (msg.has_positive_int_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_positive_int_value>(
+          msg, "positive_int_value", msg.positive_int_value(), visitor);
+    }
+    if (msg.has_negative_int_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_INT64,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_negative_int_value>(
+          msg, "negative_int_value", msg.negative_int_value(), visitor);
+    }
+    if (msg.has_double_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_double_value>(
+          msg, "double_value", msg.double_value(), visitor);
+    }
+    if (msg.has_string_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_BYTES,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_string_value>(
+          msg, "string_value", msg.string_value(), visitor);
+    }
+    if (msg.has_aggregate_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &UninterpretedOption::clear_aggregate_value>(
+          msg, "aggregate_value", msg.aggregate_value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.UninterpretedOption)
  private:
   class _Internal;
@@ -4392,6 +4640,14 @@ class PROTOBUF_EXPORT SourceCodeInfo final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.location_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &SourceCodeInfo::clear_location>(
+          msg, "location", msg.location(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.SourceCodeInfo)
  private:
   class _Internal;
@@ -4594,6 +4850,14 @@ class PROTOBUF_EXPORT GeneratedCodeInfo final : public ::google::protobuf::Messa
   const ::google::protobuf::GeneratedCodeInfo_Annotation& annotation(int index) const;
   ::google::protobuf::GeneratedCodeInfo_Annotation* PROTOBUF_NONNULL add_annotation();
   const ::google::protobuf::RepeatedPtrField<::google::protobuf::GeneratedCodeInfo_Annotation>& annotation() const;
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.annotation_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &GeneratedCodeInfo::clear_annotation>(
+          msg, "annotation", msg.annotation(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.GeneratedCodeInfo)
  private:
   class _Internal;
@@ -4827,6 +5091,24 @@ class PROTOBUF_EXPORT FeatureSetDefaults_FeatureSetEditionDefault final : public
   void _internal_set_edition(::google::protobuf::Edition value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSetDefaults_FeatureSetEditionDefault::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+    if (msg.has_overridable_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSetDefaults_FeatureSetEditionDefault::clear_overridable_features>(
+          msg, "overridable_features", msg.overridable_features(), visitor);
+    }
+    if (msg.has_fixed_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSetDefaults_FeatureSetEditionDefault::clear_fixed_features>(
+          msg, "fixed_features", msg.fixed_features(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FeatureSetDefaults.FeatureSetEditionDefault)
  private:
   class _Internal;
@@ -5254,6 +5536,24 @@ class PROTOBUF_EXPORT ServiceOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<34, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &ServiceOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<33, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &ServiceOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &ServiceOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.ServiceOptions)
  private:
   class _Internal;
@@ -5669,6 +5969,19 @@ class PROTOBUF_EXPORT OneofOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &OneofOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &OneofOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.OneofOptions)
  private:
   class _Internal;
@@ -6130,6 +6443,29 @@ class PROTOBUF_EXPORT MethodOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<33, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_idempotency_level()) {
+      ::google::protobuf::internal::VisitGeneratedField<34, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodOptions::clear_idempotency_level>(
+          msg, "idempotency_level", msg.idempotency_level(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<35, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &MethodOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.MethodOptions)
  private:
   class _Internal;
@@ -6611,6 +6947,44 @@ class PROTOBUF_EXPORT MessageOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_message_set_wire_format()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_message_set_wire_format>(
+          msg, "message_set_wire_format", msg.message_set_wire_format(), visitor);
+    }
+    if (msg.has_no_standard_descriptor_accessor()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_no_standard_descriptor_accessor>(
+          msg, "no_standard_descriptor_accessor", msg.no_standard_descriptor_accessor(), visitor);
+    }
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_map_entry()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_map_entry>(
+          msg, "map_entry", msg.map_entry(), visitor);
+    }
+    if (msg.has_deprecated_legacy_json_field_conflicts()) {
+      ::google::protobuf::internal::VisitGeneratedField<11, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_deprecated_legacy_json_field_conflicts>(
+          msg, "deprecated_legacy_json_field_conflicts", msg.deprecated_legacy_json_field_conflicts(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<12, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &MessageOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &MessageOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.MessageOptions)
  private:
   class _Internal;
@@ -7348,6 +7722,114 @@ class PROTOBUF_EXPORT FileOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_java_package()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_package>(
+          msg, "java_package", msg.java_package(), visitor);
+    }
+    if (msg.has_java_outer_classname()) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_outer_classname>(
+          msg, "java_outer_classname", msg.java_outer_classname(), visitor);
+    }
+    if (msg.has_java_multiple_files()) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_multiple_files>(
+          msg, "java_multiple_files", msg.java_multiple_files(), visitor);
+    }
+    if (msg.has_java_generate_equals_and_hash()) {
+      ::google::protobuf::internal::VisitGeneratedField<20, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_generate_equals_and_hash>(
+          msg, "java_generate_equals_and_hash", msg.java_generate_equals_and_hash(), visitor);
+    }
+    if (msg.has_java_string_check_utf8()) {
+      ::google::protobuf::internal::VisitGeneratedField<27, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_string_check_utf8>(
+          msg, "java_string_check_utf8", msg.java_string_check_utf8(), visitor);
+    }
+    if (msg.has_optimize_for()) {
+      ::google::protobuf::internal::VisitGeneratedField<9, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_optimize_for>(
+          msg, "optimize_for", msg.optimize_for(), visitor);
+    }
+    if (msg.has_go_package()) {
+      ::google::protobuf::internal::VisitGeneratedField<11, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_go_package>(
+          msg, "go_package", msg.go_package(), visitor);
+    }
+    if (msg.has_cc_generic_services()) {
+      ::google::protobuf::internal::VisitGeneratedField<16, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_cc_generic_services>(
+          msg, "cc_generic_services", msg.cc_generic_services(), visitor);
+    }
+    if (msg.has_java_generic_services()) {
+      ::google::protobuf::internal::VisitGeneratedField<17, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_java_generic_services>(
+          msg, "java_generic_services", msg.java_generic_services(), visitor);
+    }
+    if (msg.has_py_generic_services()) {
+      ::google::protobuf::internal::VisitGeneratedField<18, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_py_generic_services>(
+          msg, "py_generic_services", msg.py_generic_services(), visitor);
+    }
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<23, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_cc_enable_arenas()) {
+      ::google::protobuf::internal::VisitGeneratedField<31, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_cc_enable_arenas>(
+          msg, "cc_enable_arenas", msg.cc_enable_arenas(), visitor);
+    }
+    if (msg.has_objc_class_prefix()) {
+      ::google::protobuf::internal::VisitGeneratedField<36, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_objc_class_prefix>(
+          msg, "objc_class_prefix", msg.objc_class_prefix(), visitor);
+    }
+    if (msg.has_csharp_namespace()) {
+      ::google::protobuf::internal::VisitGeneratedField<37, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_csharp_namespace>(
+          msg, "csharp_namespace", msg.csharp_namespace(), visitor);
+    }
+    if (msg.has_swift_prefix()) {
+      ::google::protobuf::internal::VisitGeneratedField<39, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_swift_prefix>(
+          msg, "swift_prefix", msg.swift_prefix(), visitor);
+    }
+    if (msg.has_php_class_prefix()) {
+      ::google::protobuf::internal::VisitGeneratedField<40, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_php_class_prefix>(
+          msg, "php_class_prefix", msg.php_class_prefix(), visitor);
+    }
+    if (msg.has_php_namespace()) {
+      ::google::protobuf::internal::VisitGeneratedField<41, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_php_namespace>(
+          msg, "php_namespace", msg.php_namespace(), visitor);
+    }
+    if (msg.has_php_metadata_namespace()) {
+      ::google::protobuf::internal::VisitGeneratedField<44, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_php_metadata_namespace>(
+          msg, "php_metadata_namespace", msg.php_metadata_namespace(), visitor);
+    }
+    if (msg.has_ruby_package()) {
+      ::google::protobuf::internal::VisitGeneratedField<45, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_ruby_package>(
+          msg, "ruby_package", msg.ruby_package(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<50, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FileOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FileOptions)
  private:
   class _Internal;
@@ -8048,6 +8530,79 @@ class PROTOBUF_EXPORT FieldOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_ctype()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_ctype>(
+          msg, "ctype", msg.ctype(), visitor);
+    }
+    if (msg.has_packed()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_packed>(
+          msg, "packed", msg.packed(), visitor);
+    }
+    if (msg.has_jstype()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_jstype>(
+          msg, "jstype", msg.jstype(), visitor);
+    }
+    if (msg.has_lazy()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_lazy>(
+          msg, "lazy", msg.lazy(), visitor);
+    }
+    if (msg.has_unverified_lazy()) {
+      ::google::protobuf::internal::VisitGeneratedField<15, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_unverified_lazy>(
+          msg, "unverified_lazy", msg.unverified_lazy(), visitor);
+    }
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_weak()) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_weak>(
+          msg, "weak", msg.weak(), visitor);
+    }
+    if (msg.has_debug_redact()) {
+      ::google::protobuf::internal::VisitGeneratedField<16, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_debug_redact>(
+          msg, "debug_redact", msg.debug_redact(), visitor);
+    }
+    if (msg.has_retention()) {
+      ::google::protobuf::internal::VisitGeneratedField<17, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_retention>(
+          msg, "retention", msg.retention(), visitor);
+    }
+    if (msg.targets_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<19, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitRepeated, &FieldOptions::clear_targets>(
+          msg, "targets", msg.targets(), visitor);
+    }
+    if (msg.edition_defaults_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<20, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FieldOptions::clear_edition_defaults>(
+          msg, "edition_defaults", msg.edition_defaults(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<21, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.has_feature_support()) {
+      ::google::protobuf::internal::VisitGeneratedField<22, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldOptions::clear_feature_support>(
+          msg, "feature_support", msg.feature_support(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FieldOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FieldOptions)
  private:
   class _Internal;
@@ -8294,6 +8849,24 @@ class PROTOBUF_EXPORT FeatureSetDefaults final : public ::google::protobuf::Mess
   void _internal_set_maximum_edition(::google::protobuf::Edition value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.defaults_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FeatureSetDefaults::clear_defaults>(
+          msg, "defaults", msg.defaults(), visitor);
+    }
+    if (msg.has_minimum_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSetDefaults::clear_minimum_edition>(
+          msg, "minimum_edition", msg.minimum_edition(), visitor);
+    }
+    if (msg.has_maximum_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FeatureSetDefaults::clear_maximum_edition>(
+          msg, "maximum_edition", msg.maximum_edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FeatureSetDefaults)
  private:
   class _Internal;
@@ -8761,6 +9334,29 @@ class PROTOBUF_EXPORT ExtensionRangeOptions final : public ::google::protobuf::M
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &ExtensionRangeOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+    if (msg.declaration_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &ExtensionRangeOptions::clear_declaration>(
+          msg, "declaration", msg.declaration(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<50, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.has_verification()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &ExtensionRangeOptions::clear_verification>(
+          msg, "verification", msg.verification(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.ExtensionRangeOptions)
  private:
   class _Internal;
@@ -9220,6 +9816,34 @@ class PROTOBUF_EXPORT EnumValueOptions final : public ::google::protobuf::Messag
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.has_debug_redact()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueOptions::clear_debug_redact>(
+          msg, "debug_redact", msg.debug_redact(), visitor);
+    }
+    if (msg.has_feature_support()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueOptions::clear_feature_support>(
+          msg, "feature_support", msg.feature_support(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumValueOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumValueOptions)
  private:
   class _Internal;
@@ -9676,6 +10300,34 @@ class PROTOBUF_EXPORT EnumOptions final : public ::google::protobuf::Message
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_allow_alias()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumOptions::clear_allow_alias>(
+          msg, "allow_alias", msg.allow_alias(), visitor);
+    }
+    if (msg.has_deprecated()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumOptions::clear_deprecated>(
+          msg, "deprecated", msg.deprecated(), visitor);
+    }
+    if (msg.has_deprecated_legacy_json_field_conflicts()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumOptions::clear_deprecated_legacy_json_field_conflicts>(
+          msg, "deprecated_legacy_json_field_conflicts", msg.deprecated_legacy_json_field_conflicts(), visitor);
+    }
+    if (msg.has_features()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumOptions::clear_features>(
+          msg, "features", msg.features(), visitor);
+    }
+    if (msg.uninterpreted_option_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<999, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumOptions::clear_uninterpreted_option>(
+          msg, "uninterpreted_option", msg.uninterpreted_option(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumOptions)
  private:
   class _Internal;
@@ -9902,6 +10554,19 @@ class PROTOBUF_EXPORT OneofDescriptorProto final : public ::google::protobuf::Me
   ::google::protobuf::OneofOptions* PROTOBUF_NONNULL _internal_mutable_options();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &OneofDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &OneofDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.OneofDescriptorProto)
  private:
   class _Internal;
@@ -10186,6 +10851,39 @@ class PROTOBUF_EXPORT MethodDescriptorProto final : public ::google::protobuf::M
   void _internal_set_server_streaming(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_input_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_input_type>(
+          msg, "input_type", msg.input_type(), visitor);
+    }
+    if (msg.has_output_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_output_type>(
+          msg, "output_type", msg.output_type(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.has_client_streaming()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_client_streaming>(
+          msg, "client_streaming", msg.client_streaming(), visitor);
+    }
+    if (msg.has_server_streaming()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &MethodDescriptorProto::clear_server_streaming>(
+          msg, "server_streaming", msg.server_streaming(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.MethodDescriptorProto)
  private:
   class _Internal;
@@ -10606,6 +11304,64 @@ class PROTOBUF_EXPORT FieldDescriptorProto final : public ::google::protobuf::Me
   void _internal_set_type(::google::protobuf::FieldDescriptorProto_Type value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_number()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_number>(
+          msg, "number", msg.number(), visitor);
+    }
+    if (msg.has_label()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_label>(
+          msg, "label", msg.label(), visitor);
+    }
+    if (msg.has_type()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_type>(
+          msg, "type", msg.type(), visitor);
+    }
+    if (msg.has_type_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_type_name>(
+          msg, "type_name", msg.type_name(), visitor);
+    }
+    if (msg.has_extendee()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_extendee>(
+          msg, "extendee", msg.extendee(), visitor);
+    }
+    if (msg.has_default_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_default_value>(
+          msg, "default_value", msg.default_value(), visitor);
+    }
+    if (msg.has_oneof_index()) {
+      ::google::protobuf::internal::VisitGeneratedField<9, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_oneof_index>(
+          msg, "oneof_index", msg.oneof_index(), visitor);
+    }
+    if (msg.has_json_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_json_name>(
+          msg, "json_name", msg.json_name(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.has_proto3_optional()) {
+      ::google::protobuf::internal::VisitGeneratedField<17, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &FieldDescriptorProto::clear_proto3_optional>(
+          msg, "proto3_optional", msg.proto3_optional(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FieldDescriptorProto)
  private:
   class _Internal;
@@ -10850,6 +11606,24 @@ class PROTOBUF_EXPORT EnumValueDescriptorProto final : public ::google::protobuf
   void _internal_set_number(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_number()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueDescriptorProto::clear_number>(
+          msg, "number", msg.number(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValueDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumValueDescriptorProto)
  private:
   class _Internal;
@@ -11081,6 +11855,24 @@ class PROTOBUF_EXPORT DescriptorProto_ExtensionRange final : public ::google::pr
   void _internal_set_end(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_start()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto_ExtensionRange::clear_start>(
+          msg, "start", msg.start(), visitor);
+    }
+    if (msg.has_end()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto_ExtensionRange::clear_end>(
+          msg, "end", msg.end(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto_ExtensionRange::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.DescriptorProto.ExtensionRange)
  private:
   class _Internal;
@@ -11323,6 +12115,24 @@ class PROTOBUF_EXPORT ServiceDescriptorProto final : public ::google::protobuf::
   ::google::protobuf::ServiceOptions* PROTOBUF_NONNULL _internal_mutable_options();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &ServiceDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.method_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &ServiceDescriptorProto::clear_method>(
+          msg, "method", msg.method(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &ServiceDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.ServiceDescriptorProto)
  private:
   class _Internal;
@@ -11622,6 +12432,39 @@ class PROTOBUF_EXPORT EnumDescriptorProto final : public ::google::protobuf::Mes
   void _internal_set_visibility(::google::protobuf::SymbolVisibility value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.value_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumDescriptorProto::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.reserved_range_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumDescriptorProto::clear_reserved_range>(
+          msg, "reserved_range", msg.reserved_range(), visitor);
+    }
+    if (msg.reserved_name_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumDescriptorProto::clear_reserved_name>(
+          msg, "reserved_name", msg.reserved_name(), visitor);
+    }
+    if (msg.has_visibility()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumDescriptorProto::clear_visibility>(
+          msg, "visibility", msg.visibility(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumDescriptorProto)
  private:
   class _Internal;
@@ -12020,6 +12863,64 @@ class PROTOBUF_EXPORT DescriptorProto final : public ::google::protobuf::Message
   void _internal_set_visibility(::google::protobuf::SymbolVisibility value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.field_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_field>(
+          msg, "field", msg.field(), visitor);
+    }
+    if (msg.extension_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_extension>(
+          msg, "extension", msg.extension(), visitor);
+    }
+    if (msg.nested_type_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_nested_type>(
+          msg, "nested_type", msg.nested_type(), visitor);
+    }
+    if (msg.enum_type_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_enum_type>(
+          msg, "enum_type", msg.enum_type(), visitor);
+    }
+    if (msg.extension_range_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_extension_range>(
+          msg, "extension_range", msg.extension_range(), visitor);
+    }
+    if (msg.oneof_decl_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_oneof_decl>(
+          msg, "oneof_decl", msg.oneof_decl(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.reserved_range_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<9, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_reserved_range>(
+          msg, "reserved_range", msg.reserved_range(), visitor);
+    }
+    if (msg.reserved_name_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &DescriptorProto::clear_reserved_name>(
+          msg, "reserved_name", msg.reserved_name(), visitor);
+    }
+    if (msg.has_visibility()) {
+      ::google::protobuf::internal::VisitGeneratedField<11, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &DescriptorProto::clear_visibility>(
+          msg, "visibility", msg.visibility(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.DescriptorProto)
  private:
   class _Internal;
@@ -12481,6 +13382,79 @@ class PROTOBUF_EXPORT FileDescriptorProto final : public ::google::protobuf::Mes
   void _internal_set_edition(::google::protobuf::Edition value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_name()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_package()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_package>(
+          msg, "package", msg.package(), visitor);
+    }
+    if (msg.dependency_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_dependency>(
+          msg, "dependency", msg.dependency(), visitor);
+    }
+    if (msg.public_dependency_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_public_dependency>(
+          msg, "public_dependency", msg.public_dependency(), visitor);
+    }
+    if (msg.weak_dependency_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<11, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_weak_dependency>(
+          msg, "weak_dependency", msg.weak_dependency(), visitor);
+    }
+    if (msg.option_dependency_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<15, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_option_dependency>(
+          msg, "option_dependency", msg.option_dependency(), visitor);
+    }
+    if (msg.message_type_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_message_type>(
+          msg, "message_type", msg.message_type(), visitor);
+    }
+    if (msg.enum_type_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_enum_type>(
+          msg, "enum_type", msg.enum_type(), visitor);
+    }
+    if (msg.service_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_service>(
+          msg, "service", msg.service(), visitor);
+    }
+    if (msg.extension_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorProto::clear_extension>(
+          msg, "extension", msg.extension(), visitor);
+    }
+    if (msg.has_options()) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.has_source_code_info()) {
+      ::google::protobuf::internal::VisitGeneratedField<9, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_source_code_info>(
+          msg, "source_code_info", msg.source_code_info(), visitor);
+    }
+    if (msg.has_syntax()) {
+      ::google::protobuf::internal::VisitGeneratedField<12, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_syntax>(
+          msg, "syntax", msg.syntax(), visitor);
+    }
+    if (msg.has_edition()) {
+      ::google::protobuf::internal::VisitGeneratedField<14, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &FileDescriptorProto::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FileDescriptorProto)
  private:
   class _Internal;
@@ -12889,6 +13863,14 @@ class PROTOBUF_EXPORT FileDescriptorSet final : public ::google::protobuf::Messa
     return _proto_TypeTraits::MutableRepeated(
         GetArena(), id.number(), _field_type, _is_packed, &_impl_._extensions_);
   }
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.file_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &FileDescriptorSet::clear_file>(
+          msg, "file", msg.file(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FileDescriptorSet)
  private:
   class _Internal;
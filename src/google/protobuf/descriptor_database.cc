@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/strings/ascii.h"
@@ -32,6 +33,7 @@
 #include "absl/strings/string_view.h"
 #include "absl/strings/strip.h"
 #include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/endian.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/parse_context.h"
 #include "google/protobuf/wire_format_lite.h"
@@ -400,6 +402,186 @@ bool SimpleDescriptorDatabase::MaybeCopy(
 
 // -------------------------------------------------------------------
 
+namespace {
+
+// Layout of the bundle written by
+// EncodedDescriptorDatabase::SerializeIndexedBundle().  Every integer is a
+// little-endian uint32_t and every offset is relative to the start of the
+// bundle, so the bytes can be mmap()ed or embedded and used as they are:
+//
+//   header:      magic, version,
+//                file_count, files_offset,
+//                symbol_count, symbols_offset,
+//                extension_count, extensions_offset
+//   files:       {name_offset, name_size, data_offset, data_size}
+//                sorted by name
+//   symbols:     {name_offset, name_size, file_index}
+//                sorted by fully-qualified name
+//   extensions:  {extendee_offset, extendee_size, number, file_index}
+//                sorted by (extendee, number), extendee without leading '.'
+//   followed by the encoded FileDescriptorProtos and the string data.
+constexpr uint32_t kBundleMagic = 0x58444250;  // "PBDX"
+constexpr uint32_t kBundleVersion = 1;
+constexpr size_t kBundleHeaderSize = 8 * sizeof(uint32_t);
+constexpr size_t kBundleFileRecordSize = 4 * sizeof(uint32_t);
+constexpr size_t kBundleSymbolRecordSize = 3 * sizeof(uint32_t);
+constexpr size_t kBundleExtensionRecordSize = 4 * sizeof(uint32_t);
+
+// Read-only view over a bundle.  All accessors are bounds-checked against the
+// bundle size, so a truncated or corrupt bundle makes lookups fail instead of
+// reading out of bounds.
+class IndexedBundle {
+ public:
+  using Value = std::pair<const void*, int>;
+
+  explicit IndexedBundle(absl::string_view data) : data_(data) {}
+
+  // Checks the header and that all the record tables fit in the bundle.
+  bool IsValid() const {
+    if (data_.size() < kBundleHeaderSize) return false;
+    if (Word(0) != kBundleMagic || Word(4) != kBundleVersion) return false;
+    return TableFits(file_count(), files_offset(), kBundleFileRecordSize) &&
+           TableFits(symbol_count(), symbols_offset(),
+                     kBundleSymbolRecordSize) &&
+           TableFits(extension_count(), extensions_offset(),
+                     kBundleExtensionRecordSize);
+  }
+
+  uint32_t file_count() const { return Word(8); }
+  absl::string_view file_name(uint32_t i) const {
+    size_t record = files_offset() + i * kBundleFileRecordSize;
+    return Bytes(Word(record), Word(record + 4));
+  }
+  Value file_value(uint32_t i) const {
+    size_t record = files_offset() + i * kBundleFileRecordSize;
+    absl::string_view bytes = Bytes(Word(record + 8), Word(record + 12));
+    if (bytes.data() == nullptr) return Value();
+    return {bytes.data(), static_cast<int>(bytes.size())};
+  }
+
+  Value FindFile(absl::string_view filename) const {
+    uint32_t i = LowerBound(file_count(), [&](uint32_t i) {
+      return file_name(i) < filename;
+    });
+    return i < file_count() && file_name(i) == filename ? file_value(i)
+                                                        : Value();
+  }
+
+  Value FindSymbol(absl::string_view name) const {
+    // Find the last symbol which sorts less than or equal to `name`.
+    uint32_t i = LowerBound(symbol_count(), [&](uint32_t i) {
+      return symbol_name(i) <= name;
+    });
+    if (i == 0) return Value();
+    --i;
+    return IsSubSymbol(symbol_name(i), name) ? FileValueAt(symbol_file(i))
+                                             : Value();
+  }
+
+  Value FindExtension(absl::string_view containing_type,
+                      int field_number) const {
+    uint32_t i = ExtensionLowerBound(containing_type, field_number);
+    return i < extension_count() &&
+                   extension_extendee(i) == containing_type &&
+                   extension_number(i) == field_number
+               ? FileValueAt(extension_file(i))
+               : Value();
+  }
+
+  bool FindAllExtensionNumbers(absl::string_view containing_type,
+                               std::vector<int>* output) const {
+    bool success = false;
+    for (uint32_t i = ExtensionLowerBound(containing_type, 0);
+         i < extension_count() && extension_extendee(i) == containing_type;
+         ++i) {
+      output->push_back(extension_number(i));
+      success = true;
+    }
+    return success;
+  }
+
+ private:
+  uint32_t Word(size_t offset) const {
+    if (offset + sizeof(uint32_t) > data_.size()) return 0;
+    uint32_t value;
+    memcpy(&value, data_.data() + offset, sizeof(value));
+    return internal::little_endian::ToHost(value);
+  }
+
+  // Returns a null view if the range is out of bounds.
+  absl::string_view Bytes(uint32_t offset, uint32_t size) const {
+    if (offset > data_.size() || size > data_.size() - offset) return {};
+    return data_.substr(offset, size);
+  }
+
+  bool TableFits(uint32_t count, uint32_t offset, size_t record_size) const {
+    return offset <= data_.size() &&
+           static_cast<uint64_t>(count) * record_size <= data_.size() - offset;
+  }
+
+  // Returns the first index in [0, count) for which `less` is false.
+  template <typename Less>
+  static uint32_t LowerBound(uint32_t count, Less less) {
+    uint32_t first = 0;
+    while (count > 0) {
+      uint32_t step = count / 2;
+      if (less(first + step)) {
+        first += step + 1;
+        count -= step + 1;
+      } else {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  uint32_t ExtensionLowerBound(absl::string_view containing_type,
+                               int field_number) const {
+    return LowerBound(extension_count(), [&](uint32_t i) {
+      return std::make_tuple(extension_extendee(i), extension_number(i)) <
+             std::make_tuple(containing_type, field_number);
+    });
+  }
+
+  Value FileValueAt(uint32_t file_index) const {
+    return file_index < file_count() ? file_value(file_index) : Value();
+  }
+
+  uint32_t files_offset() const { return Word(12); }
+  uint32_t symbol_count() const { return Word(16); }
+  uint32_t symbols_offset() const { return Word(20); }
+  uint32_t extension_count() const { return Word(24); }
+  uint32_t extensions_offset() const { return Word(28); }
+
+  absl::string_view symbol_name(uint32_t i) const {
+    size_t record = symbols_offset() + i * kBundleSymbolRecordSize;
+    return Bytes(Word(record), Word(record + 4));
+  }
+  uint32_t symbol_file(uint32_t i) const {
+    return Word(symbols_offset() + i * kBundleSymbolRecordSize + 8);
+  }
+  absl::string_view extension_extendee(uint32_t i) const {
+    size_t record = extensions_offset() + i * kBundleExtensionRecordSize;
+    return Bytes(Word(record), Word(record + 4));
+  }
+  int extension_number(uint32_t i) const {
+    return static_cast<int>(
+        Word(extensions_offset() + i * kBundleExtensionRecordSize + 8));
+  }
+  uint32_t extension_file(uint32_t i) const {
+    return Word(extensions_offset() + i * kBundleExtensionRecordSize + 12);
+  }
+
+  absl::string_view data_;
+};
+
+void AppendBundleWord(uint32_t value, std::string* output) {
+  value = internal::little_endian::FromHost(value);
+  output->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
 class EncodedDescriptorDatabase::DescriptorIndex {
  public:
   using Value = std::pair<const void*, int>;
@@ -417,6 +599,9 @@ class EncodedDescriptorDatabase::DescriptorIndex {
   void FindAllFileNames(
       std::vector<std::string>* PROTOBUF_NONNULL output) const;
 
+  void AddBundle(absl::string_view data) { bundles_.emplace_back(data); }
+  bool SerializeBundle(std::string* PROTOBUF_NONNULL output);
+
  private:
   friend class EncodedDescriptorDatabase;
 
@@ -584,6 +769,10 @@ class EncodedDescriptorDatabase::DescriptorIndex {
   absl::btree_set<ExtensionEntry, ExtensionCompare> by_extension_{
       ExtensionCompare{*this}};
   std::vector<ExtensionEntry> by_extension_flat_;
+
+  // Precomputed indexes registered through AddIndexedBundle().  They are only
+  // consulted when the tables above have no match.
+  std::vector<IndexedBundle> bundles_;
 };
 
 bool EncodedDescriptorDatabase::Add(
@@ -598,6 +787,23 @@ bool EncodedDescriptorDatabase::Add(
   }
 }
 
+bool EncodedDescriptorDatabase::AddIndexedBundle(
+    const void* PROTOBUF_NONNULL data, size_t size) {
+  absl::string_view bundle(static_cast<const char*>(data), size);
+  if (!IndexedBundle(bundle).IsValid()) {
+    ABSL_LOG(ERROR) << "Invalid bundle passed to "
+                       "EncodedDescriptorDatabase::AddIndexedBundle().";
+    return false;
+  }
+  index_->AddBundle(bundle);
+  return true;
+}
+
+bool EncodedDescriptorDatabase::SerializeIndexedBundle(
+    std::string* PROTOBUF_NONNULL output) {
+  return index_->SerializeBundle(output);
+}
+
 bool EncodedDescriptorDatabase::AddCopy(
     const void* PROTOBUF_NONNULL encoded_file_descriptor, int size) {
   void* copy = internal::Allocate(size);
@@ -808,7 +1014,12 @@ bool EncodedDescriptorDatabase::DescriptorIndex::AddExtension(
 std::pair<const void*, int>
 EncodedDescriptorDatabase::DescriptorIndex::FindSymbol(absl::string_view name) {
   EnsureFlat();
-  return FindSymbolOnlyFlat(name);
+  Value value = FindSymbolOnlyFlat(name);
+  for (auto it = bundles_.begin(); value.first == nullptr && it != bundles_.end();
+       ++it) {
+    value = it->FindSymbol(name);
+  }
+  return value;
 }
 
 std::pair<const void*, int>
@@ -830,11 +1041,16 @@ EncodedDescriptorDatabase::DescriptorIndex::FindExtension(
   auto it = std::lower_bound(
       by_extension_flat_.begin(), by_extension_flat_.end(),
       std::make_tuple(containing_type, field_number), by_extension_.key_comp());
-  return it == by_extension_flat_.end() ||
-                 it->extendee(*this) != containing_type ||
-                 it->extension_number != field_number
-             ? std::make_pair(nullptr, 0)
-             : all_values_[it->data_offset].value();
+  if (it != by_extension_flat_.end() &&
+      it->extendee(*this) == containing_type &&
+      it->extension_number == field_number) {
+    return all_values_[it->data_offset].value();
+  }
+  for (const IndexedBundle& bundle : bundles_) {
+    Value value = bundle.FindExtension(containing_type, field_number);
+    if (value.first != nullptr) return value;
+  }
+  return std::make_pair(nullptr, 0);
 }
 
 template <typename T, typename Less>
@@ -869,6 +1085,9 @@ bool EncodedDescriptorDatabase::DescriptorIndex::FindAllExtensionNumbers(
     output->push_back(it->extension_number);
     success = true;
   }
+  for (const IndexedBundle& bundle : bundles_) {
+    success |= bundle.FindAllExtensionNumbers(containing_type, output);
+  }
 
   return success;
 }
@@ -885,6 +1104,16 @@ void EncodedDescriptorDatabase::DescriptorIndex::FindAllFileNames(
     (*output)[i] = std::string(entry.name(*this));
     i++;
   }
+  if (bundles_.empty()) return;
+  // Bundle files are shadowed by files added with Add() and by earlier
+  // bundles, so list each name only once.
+  absl::flat_hash_set<std::string> seen(output->begin(), output->end());
+  for (const IndexedBundle& bundle : bundles_) {
+    for (uint32_t j = 0; j < bundle.file_count(); ++j) {
+      std::string name(bundle.file_name(j));
+      if (seen.insert(name).second) output->push_back(std::move(name));
+    }
+  }
 }
 
 std::pair<const void*, int>
@@ -894,9 +1123,157 @@ EncodedDescriptorDatabase::DescriptorIndex::FindFile(
 
   auto it = std::lower_bound(by_name_flat_.begin(), by_name_flat_.end(),
                              filename, by_name_.key_comp());
-  return it == by_name_flat_.end() || it->name(*this) != filename
-             ? std::make_pair(nullptr, 0)
-             : all_values_[it->data_offset].value();
+  if (it != by_name_flat_.end() && it->name(*this) == filename) {
+    return all_values_[it->data_offset].value();
+  }
+  for (const IndexedBundle& bundle : bundles_) {
+    Value value = bundle.FindFile(filename);
+    if (value.first != nullptr) return value;
+  }
+  return std::make_pair(nullptr, 0);
+}
+
+bool EncodedDescriptorDatabase::DescriptorIndex::SerializeBundle(
+    std::string* PROTOBUF_NONNULL output) {
+  std::vector<std::string> names;
+  FindAllFileNames(&names);
+  std::sort(names.begin(), names.end());
+
+  struct SymbolRecord {
+    std::string name;
+    uint32_t file_index;
+  };
+  struct ExtensionRecord {
+    std::string extendee;
+    int number;
+    uint32_t file_index;
+  };
+  std::vector<Value> files;
+  std::vector<SymbolRecord> symbols;
+  std::vector<ExtensionRecord> extensions;
+
+  FileDescriptorProto file;
+  for (const std::string& name : names) {
+    Value value = FindFile(name);
+    if (!file.ParseFromArray(value.first, value.second)) {
+      ABSL_LOG(ERROR) << "Invalid file descriptor data for " << name;
+      return false;
+    }
+    uint32_t file_index = static_cast<uint32_t>(files.size());
+    files.push_back(value);
+
+    std::string prefix = file.package().empty()
+                             ? std::string()
+                             : absl::StrCat(file.package(), ".");
+    const auto add_symbol = [&](absl::string_view symbol) {
+      symbols.push_back({absl::StrCat(prefix, symbol), file_index});
+    };
+    const auto add_extension = [&](const FieldDescriptorProto& field) {
+      // Like AddExtension(), only fully-qualified extendees are indexed.
+      if (!field.extendee().empty() && field.extendee()[0] == '.') {
+        extensions.push_back(
+            {field.extendee().substr(1), field.number(), file_index});
+      }
+    };
+    std::vector<const DescriptorProto*> messages;
+    for (const auto& message_type : file.message_type()) {
+      add_symbol(message_type.name());
+      messages.push_back(&message_type);
+    }
+    while (!messages.empty()) {
+      const DescriptorProto* message = messages.back();
+      messages.pop_back();
+      for (const auto& extension : message->extension()) {
+        add_extension(extension);
+      }
+      for (const auto& nested_type : message->nested_type()) {
+        messages.push_back(&nested_type);
+      }
+    }
+    for (const auto& enum_type : file.enum_type()) {
+      add_symbol(enum_type.name());
+    }
+    for (const auto& extension : file.extension()) {
+      add_symbol(extension.name());
+      add_extension(extension);
+    }
+    for (const auto& service : file.service()) {
+      add_symbol(service.name());
+    }
+  }
+
+  std::sort(symbols.begin(), symbols.end(),
+            [](const SymbolRecord& a, const SymbolRecord& b) {
+              return std::tie(a.name, a.file_index) <
+                     std::tie(b.name, b.file_index);
+            });
+  std::sort(extensions.begin(), extensions.end(),
+            [](const ExtensionRecord& a, const ExtensionRecord& b) {
+              return std::tie(a.extendee, a.number, a.file_index) <
+                     std::tie(b.extendee, b.number, b.file_index);
+            });
+
+  // Lay out the record tables first and append all variable-length data
+  // after them, so records can refer to it by absolute offset.
+  const uint64_t data_start =
+      kBundleHeaderSize + files.size() * kBundleFileRecordSize +
+      symbols.size() * kBundleSymbolRecordSize +
+      extensions.size() * kBundleExtensionRecordSize;
+  std::string data;
+  const auto append_data = [&](absl::string_view bytes) {
+    uint64_t offset = data_start + data.size();
+    data.append(bytes.data(), bytes.size());
+    return offset;
+  };
+
+  std::string records;
+  for (size_t i = 0; i < files.size(); ++i) {
+    uint64_t name_offset = append_data(names[i]);
+    uint64_t data_offset = append_data(absl::string_view(
+        static_cast<const char*>(files[i].first), files[i].second));
+    AppendBundleWord(static_cast<uint32_t>(name_offset), &records);
+    AppendBundleWord(static_cast<uint32_t>(names[i].size()), &records);
+    AppendBundleWord(static_cast<uint32_t>(data_offset), &records);
+    AppendBundleWord(static_cast<uint32_t>(files[i].second), &records);
+  }
+  for (const SymbolRecord& symbol : symbols) {
+    AppendBundleWord(static_cast<uint32_t>(append_data(symbol.name)),
+                     &records);
+    AppendBundleWord(static_cast<uint32_t>(symbol.name.size()), &records);
+    AppendBundleWord(symbol.file_index, &records);
+  }
+  for (const ExtensionRecord& extension : extensions) {
+    AppendBundleWord(static_cast<uint32_t>(append_data(extension.extendee)),
+                     &records);
+    AppendBundleWord(static_cast<uint32_t>(extension.extendee.size()),
+                     &records);
+    AppendBundleWord(static_cast<uint32_t>(extension.number), &records);
+    AppendBundleWord(extension.file_index, &records);
+  }
+
+  if (data_start + data.size() > uint64_t{0xFFFFFFFF}) {
+    ABSL_LOG(ERROR) << "Descriptor bundle exceeds the 4GB format limit.";
+    return false;
+  }
+
+  const uint32_t files_offset = static_cast<uint32_t>(kBundleHeaderSize);
+  const uint32_t symbols_offset = static_cast<uint32_t>(
+      files_offset + files.size() * kBundleFileRecordSize);
+  const uint32_t extensions_offset = static_cast<uint32_t>(
+      symbols_offset + symbols.size() * kBundleSymbolRecordSize);
+  output->clear();
+  output->reserve(data_start + data.size());
+  AppendBundleWord(kBundleMagic, output);
+  AppendBundleWord(kBundleVersion, output);
+  AppendBundleWord(static_cast<uint32_t>(files.size()), output);
+  AppendBundleWord(files_offset, output);
+  AppendBundleWord(static_cast<uint32_t>(symbols.size()), output);
+  AppendBundleWord(symbols_offset, output);
+  AppendBundleWord(static_cast<uint32_t>(extensions.size()), output);
+  AppendBundleWord(extensions_offset, output);
+  output->append(records);
+  output->append(data);
+  return true;
 }
 
 
@@ -14,6 +14,7 @@
 #ifndef GOOGLE_PROTOBUF_DESCRIPTOR_DATABASE_H__
 #define GOOGLE_PROTOBUF_DESCRIPTOR_DATABASE_H__
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -308,6 +309,27 @@ class PROTOBUF_EXPORT EncodedDescriptorDatabase : public DescriptorDatabase {
   // need to keep it around.
   bool AddCopy(const void* PROTOBUF_NONNULL encoded_file_descriptor, int size);
 
+  // Registers a precomputed index produced by SerializeIndexedBundle().  The
+  // bundle holds the encoded files together with sorted symbol and extension
+  // tables, and lookups binary-search it in place, so adding a bundle does not
+  // parse any FileDescriptorProto or allocate per-symbol memory.  This makes
+  // it suitable for data that is mmap()ed or linked into the binary.  As with
+  // Add(), the database does not make a copy of the bytes and the caller must
+  // keep them valid for the life of the database.  Returns false and logs an
+  // error if the bundle header is malformed.
+  //
+  // The contents of a bundle are trusted: unlike Add(), files and symbols in
+  // it are not checked for conflicts against the rest of the database.  Files
+  // added through Add() take precedence over bundles, and earlier bundles
+  // take precedence over later ones.
+  bool AddIndexedBundle(const void* PROTOBUF_NONNULL data, size_t size);
+
+  // Writes every file in this database, including files from bundles, into a
+  // bundle that can be passed to AddIndexedBundle().  The output is
+  // deterministic for a given set of files.  Returns false if the result
+  // would exceed the 4GB limit of the format.
+  bool SerializeIndexedBundle(std::string* PROTOBUF_NONNULL output);
+
   // Like FindFileContainingSymbol but returns only the name of the file.
   bool FindNameOfFileContainingSymbol(StringViewArg symbol_name,
                                       std::string* PROTOBUF_NONNULL output);
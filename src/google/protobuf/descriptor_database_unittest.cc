@@ -106,6 +106,40 @@ class EncodedDescriptorDatabaseTestCase : public DescriptorDatabaseTestCase {
   EncodedDescriptorDatabase database_;
 };
 
+// Specialization for EncodedDescriptorDatabase where every file is loaded
+// through its own precomputed bundle.
+class IndexedBundleDatabaseTestCase : public DescriptorDatabaseTestCase {
+ public:
+  static DescriptorDatabaseTestCase* New() {
+    return new IndexedBundleDatabaseTestCase;
+  }
+
+  ~IndexedBundleDatabaseTestCase() override {}
+
+  DescriptorDatabase* GetDatabase() override { return &database_; }
+  bool AddToDatabase(const FileDescriptorProto& file) override {
+    std::string data;
+    file.SerializeToString(&data);
+    // Bundles are not checked for conflicts, so detect them up front with a
+    // regular database holding all the files.
+    if (!all_files_.AddCopy(data.data(), data.size())) return false;
+
+    EncodedDescriptorDatabase single_file;
+    if (!single_file.AddCopy(data.data(), data.size())) return false;
+    bundles_.push_back(std::make_unique<std::string>());
+    if (!single_file.SerializeIndexedBundle(bundles_.back().get())) {
+      return false;
+    }
+    return database_.AddIndexedBundle(bundles_.back()->data(),
+                                      bundles_.back()->size());
+  }
+
+ private:
+  EncodedDescriptorDatabase all_files_;
+  std::vector<std::unique_ptr<std::string>> bundles_;
+  EncodedDescriptorDatabase database_;
+};
+
 // Specialization for DescriptorPoolDatabase.
 class DescriptorPoolDatabaseTestCase : public DescriptorDatabaseTestCase {
  public:
@@ -455,6 +489,9 @@ INSTANTIATE_TEST_SUITE_P(
 INSTANTIATE_TEST_SUITE_P(
     MemoryConserving, DescriptorDatabaseTest,
     testing::Values(&EncodedDescriptorDatabaseTestCase::New));
+INSTANTIATE_TEST_SUITE_P(
+    IndexedBundle, DescriptorDatabaseTest,
+    testing::Values(&IndexedBundleDatabaseTestCase::New));
 INSTANTIATE_TEST_SUITE_P(Pool, DescriptorDatabaseTest,
                          testing::Values(&DescriptorPoolDatabaseTestCase::New));
 
@@ -492,6 +529,140 @@ TEST(EncodedDescriptorDatabaseExtraTest, FindNameOfFileContainingSymbol) {
   EXPECT_FALSE(db.FindNameOfFileContainingSymbol("baz.Baz", &filename));
 }
 
+TEST(EncodedDescriptorDatabaseExtraTest, IndexedBundleRoundTrip) {
+  FileDescriptorProto foo, bar;
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(
+        name: "foo.proto"
+        package: "foo"
+        message_type {
+          name: "Foo"
+          extension_range { start: 1 end: 1000 }
+          nested_type {
+            name: "Nested"
+            extension { name: "nested_ext" number: 7 extendee: ".foo.Foo" }
+          }
+        }
+        enum_type { name: "Color" }
+        service { name: "Service" }
+      )pb",
+      &foo));
+  ASSERT_TRUE(TextFormat::ParseFromString(
+      R"pb(
+        name: "bar.proto"
+        message_type { name: "Bar" }
+        extension { name: "bar_ext" number: 3 extendee: ".foo.Foo" }
+      )pb",
+      &bar));
+  std::string foo_data = foo.SerializeAsString();
+  std::string bar_data = bar.SerializeAsString();
+
+  EncodedDescriptorDatabase source;
+  ASSERT_TRUE(source.Add(foo_data.data(), foo_data.size()));
+  ASSERT_TRUE(source.Add(bar_data.data(), bar_data.size()));
+  std::string bundle;
+  ASSERT_TRUE(source.SerializeIndexedBundle(&bundle));
+
+  EncodedDescriptorDatabase db;
+  ASSERT_TRUE(db.AddIndexedBundle(bundle.data(), bundle.size()));
+
+  FileDescriptorProto file;
+  EXPECT_TRUE(db.FindFileByName("foo.proto", &file));
+  EXPECT_EQ(file.SerializeAsString(), foo_data);
+  EXPECT_FALSE(db.FindFileByName("baz.proto", &file));
+
+  std::string filename;
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("foo.Foo.Nested", &filename));
+  EXPECT_EQ("foo.proto", filename);
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("foo.Color", &filename));
+  EXPECT_EQ("foo.proto", filename);
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("foo.Service", &filename));
+  EXPECT_EQ("foo.proto", filename);
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("Bar", &filename));
+  EXPECT_EQ("bar.proto", filename);
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("bar_ext", &filename));
+  EXPECT_EQ("bar.proto", filename);
+  EXPECT_FALSE(db.FindNameOfFileContainingSymbol("foo", &filename));
+  EXPECT_FALSE(db.FindNameOfFileContainingSymbol("foo.Fo", &filename));
+
+  file.Clear();
+  EXPECT_TRUE(db.FindFileContainingExtension("foo.Foo", 7, &file));
+  EXPECT_EQ("foo.proto", file.name());
+  file.Clear();
+  EXPECT_TRUE(db.FindFileContainingExtension("foo.Foo", 3, &file));
+  EXPECT_EQ("bar.proto", file.name());
+  EXPECT_FALSE(db.FindFileContainingExtension("foo.Foo", 4, &file));
+
+  std::vector<int> numbers;
+  EXPECT_TRUE(db.FindAllExtensionNumbers("foo.Foo", &numbers));
+  EXPECT_THAT(numbers, testing::ElementsAre(3, 7));
+
+  std::vector<std::string> all_files;
+  EXPECT_TRUE(db.FindAllFileNames(&all_files));
+  EXPECT_THAT(all_files, testing::ElementsAre("bar.proto", "foo.proto"));
+
+  // Re-serializing a database backed by a bundle is stable.
+  std::string bundle2;
+  ASSERT_TRUE(db.SerializeIndexedBundle(&bundle2));
+  EXPECT_EQ(bundle, bundle2);
+}
+
+TEST(EncodedDescriptorDatabaseExtraTest, IndexedBundleTakesLowerPrecedence) {
+  FileDescriptorProto old_foo, new_foo;
+  old_foo.set_name("foo.proto");
+  old_foo.add_message_type()->set_name("Old");
+  new_foo.set_name("foo.proto");
+  new_foo.add_message_type()->set_name("New");
+
+  EncodedDescriptorDatabase source;
+  std::string old_data = old_foo.SerializeAsString();
+  ASSERT_TRUE(source.Add(old_data.data(), old_data.size()));
+  std::string bundle;
+  ASSERT_TRUE(source.SerializeIndexedBundle(&bundle));
+
+  EncodedDescriptorDatabase db;
+  ASSERT_TRUE(db.AddIndexedBundle(bundle.data(), bundle.size()));
+  std::string new_data = new_foo.SerializeAsString();
+  ASSERT_TRUE(db.Add(new_data.data(), new_data.size()));
+
+  FileDescriptorProto file;
+  EXPECT_TRUE(db.FindFileByName("foo.proto", &file));
+  ExpectContainsType(file, "New");
+  std::string filename;
+  EXPECT_TRUE(db.FindNameOfFileContainingSymbol("Old", &filename));
+  EXPECT_EQ("foo.proto", filename);
+
+  // A file shadowed by Add() or by an earlier bundle is only listed once,
+  // and only the file that lookups find is re-serialized.
+  ASSERT_TRUE(db.AddIndexedBundle(bundle.data(), bundle.size()));
+  std::vector<std::string> all_files;
+  EXPECT_TRUE(db.FindAllFileNames(&all_files));
+  EXPECT_THAT(all_files, testing::ElementsAre("foo.proto"));
+  std::string bundle2;
+  ASSERT_TRUE(db.SerializeIndexedBundle(&bundle2));
+  EncodedDescriptorDatabase db2;
+  ASSERT_TRUE(db2.AddIndexedBundle(bundle2.data(), bundle2.size()));
+  EXPECT_TRUE(db2.FindFileByName("foo.proto", &file));
+  ExpectContainsType(file, "New");
+}
+
+TEST(EncodedDescriptorDatabaseExtraTest, InvalidIndexedBundle) {
+  EncodedDescriptorDatabase source;
+  FileDescriptorProto foo;
+  foo.set_name("foo.proto");
+  std::string data = foo.SerializeAsString();
+  ASSERT_TRUE(source.Add(data.data(), data.size()));
+  std::string bundle;
+  ASSERT_TRUE(source.SerializeIndexedBundle(&bundle));
+
+  EncodedDescriptorDatabase db;
+  std::string garbage = "not a bundle, not at all";
+  EXPECT_FALSE(db.AddIndexedBundle(garbage.data(), garbage.size()));
+  // Truncated so that the file table no longer fits.
+  EXPECT_FALSE(db.AddIndexedBundle(bundle.data(), 40));
+  EXPECT_TRUE(db.AddIndexedBundle(bundle.data(), bundle.size()));
+}
+
 TEST(SimpleDescriptorDatabaseExtraTest, FindAllFileNames) {
   FileDescriptorProto f;
   f.set_name("foo.proto");
@@ -232,7 +232,7 @@ Duration::_table_ = {
      {16, 1, 0,
       PROTOBUF_FIELD_OFFSET(Duration, _impl_.nanos_)}},
     // int64 seconds = 1;
-    {::_pbi::TcParser::SingularVarintNoZag1<::uint64_t, offsetof(Duration, _impl_.seconds_), 0>(),
+    {::_pbi::TcParser::FastFixedLayout<::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV64, 8, 0, offsetof(Duration, _impl_.seconds_)), ::_pbi::TcParser::FixedLayoutField(::_pbi::TcParser::kFixedLayoutV32, 16, 1, offsetof(Duration, _impl_.nanos_))>,
      {8, 0, 0,
       PROTOBUF_FIELD_OFFSET(Duration, _impl_.seconds_)}},
   }}, {{
@@ -42,6 +42,7 @@
 #include "google/protobuf/dynamic_message.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -49,6 +50,8 @@
 #include <new>
 #include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/hash/hash.h"
@@ -346,6 +349,9 @@ class DynamicMessage final : public Message {
                  Arena* arena);
 
   void SharedCtor(bool lock_factory);
+  void ConstructField(int i, bool lock_factory);
+
+  void ClearImpl();
 
   // Needed to get the offset of the internal metadata member.
   friend class DynamicMessageFactory;
@@ -396,6 +402,15 @@ struct DynamicMessageFactory::TypeInfo {
   std::unique_ptr<uint32_t[]> has_bits_indices;
   int weak_field_map_offset;  // The offset for the weak_field_map;
 
+  // Byte ranges [first, second) of the has bits and of the singular numeric
+  // fields outside of oneofs.  They hold plain data, so new messages copy them
+  // from the prototype and Clear() restores them the same way, instead of
+  // going field by field.
+  std::vector<std::pair<uint32_t, uint32_t>> plain_data_ranges;
+  // The remaining fields outside of oneofs, which need to be constructed and
+  // cleared one by one.
+  std::vector<int> non_plain_fields;
+
   internal::ClassDataFull class_data = {
       internal::ClassData{
           nullptr,  // default_instance
@@ -418,6 +433,14 @@ struct DynamicMessageFactory::TypeInfo {
 
   TypeInfo() = default;
 
+  void CopyPlainDataFromPrototype(void* msg) const {
+    const auto* from = reinterpret_cast<const char*>(
+        static_cast<const DynamicMessage*>(class_data.prototype));
+    for (const auto& [begin, end] : plain_data_ranges) {
+      memcpy(static_cast<char*>(msg) + begin, from + begin, end - begin);
+    }
+  }
+
   ~TypeInfo() {
     delete class_data.prototype;
     delete class_data.reflection;
@@ -509,7 +532,6 @@ void DynamicMessage::SharedCtor(bool lock_factory) {
   // constructor.)
 
   const Descriptor* descriptor = type_info_->class_data.descriptor;
-  Arena* arena = GetArena();
   // Initialize oneof cases.
   int oneof_count = 0;
   for (int i = 0; i < descriptor->real_oneof_decl_count(); ++i) {
@@ -520,16 +542,26 @@ void DynamicMessage::SharedCtor(bool lock_factory) {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_EXTENSION_SET
     new (MutableExtensionsRaw()) ExtensionSet();
 #else
-    new (MutableExtensionsRaw()) ExtensionSet(arena);
+    new (MutableExtensionsRaw()) ExtensionSet(GetArena());
 #endif
   }
-  for (int i = 0; i < descriptor->field_count(); i++) {
-    const FieldDescriptor* field = descriptor->field(i);
-    void* field_ptr = MutableRaw(i);
-    if (InRealOneof(field)) {
-      continue;
+  if (is_prototype()) {
+    for (int i = 0; i < descriptor->field_count(); i++) {
+      if (!InRealOneof(descriptor->field(i))) ConstructField(i, lock_factory);
     }
-    switch (field->cpp_type()) {
+  } else {
+    // NewImpl() already copied the plain data fields from the prototype.
+    for (int i : type_info_->non_plain_fields) {
+      ConstructField(i, lock_factory);
+    }
+  }
+}
+
+void DynamicMessage::ConstructField(int i, bool lock_factory) {
+  const FieldDescriptor* field = type_info_->class_data.descriptor->field(i);
+  Arena* arena = GetArena();
+  void* field_ptr = MutableRaw(i);
+  switch (field->cpp_type()) {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_FIELD
 #define HANDLE_TYPE(CPPTYPE, TYPE)                                         \
   case FieldDescriptor::CPPTYPE_##CPPTYPE:                                 \
@@ -550,124 +582,122 @@ void DynamicMessage::SharedCtor(bool lock_factory) {
     break;
 #endif
 
-      HANDLE_TYPE(INT32, int32_t);
-      HANDLE_TYPE(INT64, int64_t);
-      HANDLE_TYPE(UINT32, uint32_t);
-      HANDLE_TYPE(UINT64, uint64_t);
-      HANDLE_TYPE(DOUBLE, double);
-      HANDLE_TYPE(FLOAT, float);
-      HANDLE_TYPE(BOOL, bool);
+    HANDLE_TYPE(INT32, int32_t);
+    HANDLE_TYPE(INT64, int64_t);
+    HANDLE_TYPE(UINT32, uint32_t);
+    HANDLE_TYPE(UINT64, uint64_t);
+    HANDLE_TYPE(DOUBLE, double);
+    HANDLE_TYPE(FLOAT, float);
+    HANDLE_TYPE(BOOL, bool);
 #undef HANDLE_TYPE
 
-      case FieldDescriptor::CPPTYPE_ENUM:
-        if (!field->is_repeated()) {
-          new (field_ptr) int{field->default_value_enum()->number()};
-        } else {
+    case FieldDescriptor::CPPTYPE_ENUM:
+      if (!field->is_repeated()) {
+        new (field_ptr) int{field->default_value_enum()->number()};
+      } else {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_FIELD
-          new (field_ptr) RepeatedField<int>(FieldInternalMetadataOffset(i));
+        new (field_ptr) RepeatedField<int>(FieldInternalMetadataOffset(i));
 #else
-          new (field_ptr) RepeatedField<int>(arena);
+        new (field_ptr) RepeatedField<int>(arena);
 #endif
-        }
-        break;
+      }
+      break;
 
-      case FieldDescriptor::CPPTYPE_STRING:
-        switch (field->cpp_string_type()) {
-          case FieldDescriptor::CppStringType::kCord:
-            if (!field->is_repeated()) {
-              if (field->has_default_value()) {
-                new (field_ptr) absl::Cord(field->default_value_string());
-              } else {
-                new (field_ptr) absl::Cord;
-              }
-              if (arena != nullptr) {
-                // Cord does not support arena so here we need to notify arena
-                // to remove the data it allocated on the heap by calling its
-                // destructor.
-                arena->OwnDestructor(static_cast<absl::Cord*>(field_ptr));
-              }
+    case FieldDescriptor::CPPTYPE_STRING:
+      switch (field->cpp_string_type()) {
+        case FieldDescriptor::CppStringType::kCord:
+          if (!field->is_repeated()) {
+            if (field->has_default_value()) {
+              new (field_ptr) absl::Cord(field->default_value_string());
             } else {
+              new (field_ptr) absl::Cord;
+            }
+            if (arena != nullptr) {
+              // Cord does not support arena so here we need to notify arena
+              // to remove the data it allocated on the heap by calling its
+              // destructor.
+              arena->OwnDestructor(static_cast<absl::Cord*>(field_ptr));
+            }
+          } else {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_FIELD
-              new (field_ptr)
-                  RepeatedField<absl::Cord>(FieldInternalMetadataOffset(i));
+            new (field_ptr)
+                RepeatedField<absl::Cord>(FieldInternalMetadataOffset(i));
 #else
-              new (field_ptr) RepeatedField<absl::Cord>(arena);
+            new (field_ptr) RepeatedField<absl::Cord>(arena);
 #endif
-              if (arena != nullptr) {
-                // Needs to destroy Cord elements.
-                arena->OwnDestructor(
-                    static_cast<RepeatedField<absl::Cord>*>(field_ptr));
-              }
+            if (arena != nullptr) {
+              // Needs to destroy Cord elements.
+              arena->OwnDestructor(
+                  static_cast<RepeatedField<absl::Cord>*>(field_ptr));
             }
+          }
+          break;
+        case FieldDescriptor::CppStringType::kView:
+          if (internal::EnableExperimentalMicroString() &&
+              !field->is_repeated()) {
+            *MutableRaw<MicroString>(i) =
+                is_prototype()
+                    // Make a new object, potentially creating the default.
+                    ? MicroString::MakeDefaultValuePrototype(
+                          field->default_value_string())
+                    // Copy from the prototype.
+                    : MicroString(arena, static_cast<const DynamicMessage*>(
+                                             type_info_->class_data.prototype)
+                                             ->GetRaw<MicroString>(i));
             break;
-          case FieldDescriptor::CppStringType::kView:
-            if (internal::EnableExperimentalMicroString() &&
-                !field->is_repeated()) {
-              *MutableRaw<MicroString>(i) =
-                  is_prototype()
-                      // Make a new object, potentially creating the default.
-                      ? MicroString::MakeDefaultValuePrototype(
-                            field->default_value_string())
-                      // Copy from the prototype.
-                      : MicroString(arena, static_cast<const DynamicMessage*>(
-                                               type_info_->class_data.prototype)
-                                               ->GetRaw<MicroString>(i));
-              break;
-            }
-            [[fallthrough]];
-          case FieldDescriptor::CppStringType::kString:
-            if (!field->is_repeated()) {
-              ArenaStringPtr* asp = new (field_ptr) ArenaStringPtr();
-              asp->InitDefault();
-            } else {
+          }
+          [[fallthrough]];
+        case FieldDescriptor::CppStringType::kString:
+          if (!field->is_repeated()) {
+            ArenaStringPtr* asp = new (field_ptr) ArenaStringPtr();
+            asp->InitDefault();
+          } else {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_PTR_FIELD
-              new (field_ptr)
-                  RepeatedPtrField<std::string>(FieldInternalMetadataOffset(i));
+            new (field_ptr)
+                RepeatedPtrField<std::string>(FieldInternalMetadataOffset(i));
 #else  // !PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_PTR_FIELD
-              new (field_ptr) RepeatedPtrField<std::string>(arena);
+            new (field_ptr) RepeatedPtrField<std::string>(arena);
 #endif
-            }
-            break;
-        }
-        break;
+          }
+          break;
+      }
+      break;
 
-      case FieldDescriptor::CPPTYPE_MESSAGE: {
-        if (!field->is_repeated()) {
-          new (field_ptr) Message*(nullptr);
-        } else {
-          if (IsMapFieldInApi(field)) {
-            const auto* sub =
-                field->message_type()->map_value()->message_type();
-            // We need to lock in most cases to avoid data racing. Only not lock
-            // when the constructor is called inside GetPrototype(), in which
-            // case we have already locked the factory.
-            new (field_ptr) DynamicMapField(
-                lock_factory
-                    ? type_info_->factory->GetPrototype(field->message_type())
-                    : type_info_->factory->GetPrototypeNoLock(
-                          field->message_type()),
-                sub != nullptr
-                    ? lock_factory
-                          ? type_info_->factory->GetPrototype(sub)
-                          : type_info_->factory->GetPrototypeNoLock(sub)
-                    : nullptr,
+    case FieldDescriptor::CPPTYPE_MESSAGE: {
+      if (!field->is_repeated()) {
+        new (field_ptr) Message*(nullptr);
+      } else {
+        if (IsMapFieldInApi(field)) {
+          const auto* sub = field->message_type()->map_value()->message_type();
+          // We need to lock in most cases to avoid data racing. Only not lock
+          // when the constructor is called inside GetPrototype(), in which
+          // case we have already locked the factory.
+          new (field_ptr) DynamicMapField(
+              lock_factory
+                  ? type_info_->factory->GetPrototype(field->message_type())
+                  : type_info_->factory->GetPrototypeNoLock(
+                        field->message_type()),
+              sub != nullptr
+                  ? lock_factory
+                        ? type_info_->factory->GetPrototype(sub)
+                        : type_info_->factory->GetPrototypeNoLock(sub)
+                  : nullptr,
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_MAP_FIELD
-                FieldInternalMetadataOffset(i)
+              FieldInternalMetadataOffset(i)
 #else
-                arena
+              arena
 #endif
-            );
-          } else {
+          );
+        } else {
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_PTR_FIELD
-            new (field_ptr)
-                RepeatedPtrField<Message>(FieldInternalMetadataOffset(i));
+          new (field_ptr)
+              RepeatedPtrField<Message>(FieldInternalMetadataOffset(i));
 #else  // !PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_PTR_FIELD
-            new (field_ptr) RepeatedPtrField<Message>(arena);
+          new (field_ptr) RepeatedPtrField<Message>(arena);
 #endif
-          }
         }
-        break;
       }
+      break;
     }
   }
 }
@@ -817,9 +847,47 @@ void* DynamicMessage::NewImpl(const void* prototype, void* mem, Arena* arena) {
   const auto* type_info =
       static_cast<const DynamicMessage*>(prototype)->type_info_;
   memset(mem, 0, type_info->class_data.allocation_size());
+  type_info->CopyPlainDataFromPrototype(mem);
   return new (mem) DynamicMessage(type_info, arena);
 }
 
+void DynamicMessage::ClearImpl() {
+  const Descriptor* descriptor = type_info_->class_data.descriptor;
+  const Reflection* reflection = type_info_->class_data.reflection;
+
+  for (int i = 0; i < descriptor->real_oneof_decl_count(); ++i) {
+    if (*static_cast<const uint32_t*>(MutableOneofCaseRaw(i)) != 0) {
+      reflection->ClearOneof(this, descriptor->real_oneof_decl(i));
+    }
+  }
+  if (type_info_->extensions_offset != -1) {
+    static_cast<ExtensionSet*>(MutableExtensionsRaw())->Clear();
+  }
+
+  // Singular fields whose has bit is not set are already clear.
+  const uint32_t* has_bits =
+      type_info_->has_bits_offset != -1
+          ? static_cast<const uint32_t*>(
+                OffsetToPointer(type_info_->has_bits_offset))
+          : nullptr;
+  for (int i : type_info_->non_plain_fields) {
+    const FieldDescriptor* field = descriptor->field(i);
+    if (has_bits != nullptr && !field->is_repeated()) {
+      const uint32_t has_bit_index = type_info_->has_bits_indices[i];
+      if (has_bit_index != static_cast<uint32_t>(internal::kNoHasbit) &&
+          (has_bits[has_bit_index / 32] & (1u << (has_bit_index % 32))) == 0) {
+        continue;
+      }
+    }
+    reflection->ClearField(this, field);
+  }
+
+  // This resets the has bits and the numeric fields to their defaults.
+  type_info_->CopyPlainDataFromPrototype(this);
+
+  _internal_metadata_.Clear<UnknownFieldSet>();
+}
+
 void DynamicMessage::DestroyImpl(MessageLite& msg) {
   static_cast<DynamicMessage&>(msg).~DynamicMessage();
 }
@@ -854,12 +922,101 @@ const internal::ClassData* DynamicMessage::GetClassData() const {
 
 // ===================================================================
 
+// An insert-only open addressing hash table from descriptors to prototypes.
+// Readers don't lock: inserts publish the key after the value, and growing
+// publishes a new table while keeping the old ones alive until the factory is
+// destroyed, which costs at most as much memory as the current table.
+// Inserts must hold the factory's mutex.
+class DynamicMessageFactory::PrototypeCache {
+ public:
+  PrototypeCache() = default;
+  PrototypeCache(const PrototypeCache&) = delete;
+  PrototypeCache& operator=(const PrototypeCache&) = delete;
+  ~PrototypeCache() { delete table_.load(std::memory_order_relaxed); }
+
+  const Message* Find(const Descriptor* type) const {
+    const Table* table = table_.load(std::memory_order_acquire);
+    if (table == nullptr) return nullptr;
+    for (size_t i = table->Start(type);; i = table->Next(i)) {
+      const Descriptor* key =
+          table->slots[i].key.load(std::memory_order_acquire);
+      if (key == type) {
+        return table->slots[i].value.load(std::memory_order_relaxed);
+      }
+      if (key == nullptr) return nullptr;
+    }
+  }
+
+  void Insert(const Descriptor* type, const Message* prototype) {
+    if (Find(type) != nullptr) return;
+    Table* table = table_.load(std::memory_order_relaxed);
+    if (table == nullptr || 2 * (size_ + 1) > table->capacity) {
+      table = Grow(table);
+    }
+    InsertInto(table, type, prototype);
+    ++size_;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<const Descriptor*> key{nullptr};
+    std::atomic<const Message*> value{nullptr};
+  };
+  struct Table {
+    explicit Table(size_t capacity)
+        : capacity(capacity), slots(new Slot[capacity]) {}
+    size_t Start(const Descriptor* type) const {
+      return absl::HashOf(type) & (capacity - 1);
+    }
+    size_t Next(size_t i) const { return (i + 1) & (capacity - 1); }
+
+    const size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+    // Kept alive for readers that may still be looking at it.
+    std::unique_ptr<Table> previous;
+  };
+
+  static void InsertInto(Table* table, const Descriptor* type,
+                         const Message* prototype) {
+    size_t i = table->Start(type);
+    while (table->slots[i].key.load(std::memory_order_relaxed) != nullptr) {
+      i = table->Next(i);
+    }
+    table->slots[i].value.store(prototype, std::memory_order_relaxed);
+    table->slots[i].key.store(type, std::memory_order_release);
+  }
+
+  Table* Grow(Table* table) {
+    auto* grown = new Table(table == nullptr ? 16 : 2 * table->capacity);
+    if (table != nullptr) {
+      for (size_t i = 0; i < table->capacity; ++i) {
+        const Descriptor* key =
+            table->slots[i].key.load(std::memory_order_relaxed);
+        if (key != nullptr) {
+          InsertInto(grown, key,
+                     table->slots[i].value.load(std::memory_order_relaxed));
+        }
+      }
+    }
+    grown->previous.reset(table);
+    table_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  std::atomic<Table*> table_{nullptr};
+  size_t size_ = 0;
+};
+
 DynamicMessageFactory::DynamicMessageFactory()
-    : pool_(nullptr), delegate_to_generated_factory_(false) {}
+    : pool_(nullptr),
+      delegate_to_generated_factory_(false),
+      prototype_cache_(std::make_unique<PrototypeCache>()) {}
 
 DynamicMessageFactory::DynamicMessageFactory(
     const DescriptorPool* PROTOBUF_NONNULL pool)
-    : pool_(pool), delegate_to_generated_factory_(false) {}
+    : pool_(pool),
+      delegate_to_generated_factory_(false),
+      prototype_cache_(std::make_unique<PrototypeCache>()) {}
 
 DynamicMessageFactory::~DynamicMessageFactory() {
   for (auto iter = prototypes_.begin(); iter != prototypes_.end(); ++iter) {
@@ -870,8 +1027,13 @@ DynamicMessageFactory::~DynamicMessageFactory() {
 const Message* PROTOBUF_NONNULL
 DynamicMessageFactory::GetPrototype(const Descriptor* PROTOBUF_NONNULL type) {
   ABSL_CHECK(type != nullptr);
+  if (const Message* prototype = prototype_cache_->Find(type)) {
+    return prototype;
+  }
   absl::MutexLock lock(&prototypes_mutex_);
-  return GetPrototypeNoLock(type);
+  const Message* prototype = GetPrototypeNoLock(type);
+  prototype_cache_->Insert(type, prototype);
+  return prototype;
 }
 
 const Message* DynamicMessageFactory::GetPrototypeNoLock(
@@ -995,16 +1157,49 @@ const Message* DynamicMessageFactory::GetPrototypeNoLock(
     type_info->extensions_offset = -1;
   }
 
+  // The has bits are plain data, and so are the singular numeric fields.
+  // Consecutive plain ranges are merged across the padding between them, but
+  // never across anything else: on 32-bit platforms a pointer fits in the gap.
+  bool last_was_plain = false;
+  auto add_plain_data = [&](uint32_t begin, uint32_t end) {
+    auto& ranges = type_info->plain_data_ranges;
+    if (last_was_plain) {
+      ranges.back().second = end;
+    } else {
+      ranges.emplace_back(begin, end);
+    }
+    last_was_plain = true;
+  };
+  if (type_info->has_bits_offset != -1) {
+    add_plain_data(type_info->has_bits_offset,
+                   type_info->has_bits_offset +
+                       DivideRoundingUp(max_hasbit, bitsizeof(uint32_t)) *
+                           sizeof(uint32_t));
+    // The oneof cases and the ExtensionSet sit between the has bits and the
+    // fields.
+    last_was_plain =
+        real_oneof_count == 0 && type_info->extensions_offset == -1;
+  }
+
   // All the fields.
   //
   // TODO:  Optimize the order of fields to minimize padding.
   for (int i = 0; i < type->field_count(); i++) {
     // Make sure field is aligned to avoid bus errors.
     // Oneof fields do not use any space.
-    if (!InRealOneof(type->field(i))) {
-      int field_size = FieldSpaceUsed(type->field(i));
+    const FieldDescriptor* field = type->field(i);
+    if (!InRealOneof(field)) {
+      int field_size = FieldSpaceUsed(field);
       size = AlignTo(size, std::min(kSafeAlignment, field_size));
-      offsets[i] = size | FieldFlags(type->field(i));
+      offsets[i] = size | FieldFlags(field);
+      if (!field->is_repeated() &&
+          field->cpp_type() != FieldDescriptor::CPPTYPE_STRING &&
+          field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+        add_plain_data(size, size + field_size);
+      } else {
+        type_info->non_plain_fields.push_back(i);
+        last_was_plain = false;
+      }
       size += field_size;
     }
   }
@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -111,7 +112,8 @@ class PROTOBUF_EXPORT DynamicMessageFactory : public MessageFactory {
   // The given descriptor must be non-null and outlive the returned message, and
   // hence must outlive the DynamicMessageFactory.
   //
-  // The method is thread-safe.
+  // The method is thread-safe.  Once the prototype for a type exists, looking
+  // it up again does not take a lock.
   const Message* PROTOBUF_NONNULL
   GetPrototype(const Descriptor* PROTOBUF_NONNULL type) override;
 
@@ -123,6 +125,10 @@ class PROTOBUF_EXPORT DynamicMessageFactory : public MessageFactory {
   absl::flat_hash_map<const Descriptor*, const TypeInfo*> prototypes_;
   mutable absl::Mutex prototypes_mutex_;
 
+  // Prototypes returned by GetPrototype(), readable without the mutex.
+  class PrototypeCache;
+  std::unique_ptr<PrototypeCache> prototype_cache_;
+
   friend class DynamicMessage;
   const Message* PROTOBUF_NONNULL
   GetPrototypeNoLock(const Descriptor* PROTOBUF_NONNULL type);
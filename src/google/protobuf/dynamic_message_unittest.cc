@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT
 #include <tuple>
 #include <vector>
 
@@ -220,6 +221,64 @@ TEST_P(DynamicMessageTest, IndependentOffsets) {
   }
 }
 
+TEST_P(DynamicMessageTest, Clear) {
+  Arena arena;
+  Message* message = prototype_->New(use_arena() ? &arena : nullptr);
+  TestUtil::ReflectionTester reflection_tester(descriptor_);
+
+  reflection_tester.SetAllFieldsViaReflection(message);
+  message->Clear();
+  reflection_tester.ExpectClearViaReflection(*message);
+
+  // The message is still usable after being cleared.
+  reflection_tester.SetAllFieldsViaReflection(message);
+  reflection_tester.ExpectAllFieldsSetViaReflection(*message);
+
+  Message* oneof_message =
+      oneof_prototype_->New(use_arena() ? &arena : nullptr);
+  TestUtil::ReflectionTester oneof_tester(oneof_descriptor_);
+  oneof_tester.SetOneofViaReflection(oneof_message);
+  oneof_message->Clear();
+  EXPECT_EQ(oneof_message->ByteSizeLong(), 0);
+
+  if (!use_arena()) {
+    delete message;
+    delete oneof_message;
+  }
+}
+
+TEST_P(DynamicMessageTest, ConcurrentGetPrototype) {
+  DynamicMessageFactory factory(&pool_);
+  std::vector<const Descriptor*> types;
+  const FileDescriptor* file = descriptor_->file();
+  for (int i = 0; i < file->message_type_count(); ++i) {
+    types.push_back(file->message_type(i));
+  }
+
+  constexpr int kThreads = 4;
+  std::vector<std::vector<const Message*>> prototypes(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < 2; ++round) {
+        prototypes[t].clear();
+        for (const Descriptor* type : types) {
+          prototypes[t].push_back(factory.GetPrototype(type));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (int t = 0; t < kThreads; ++t) {
+    EXPECT_EQ(prototypes[t], prototypes[0]);
+  }
+  for (size_t i = 0; i < types.size(); ++i) {
+    EXPECT_EQ(prototypes[0][i]->GetDescriptor(), types[i]);
+    EXPECT_EQ(factory.GetPrototype(types[i]), prototypes[0][i]);
+  }
+}
+
 TEST_P(DynamicMessageTest, Extensions) {
   // Check that extensions work.
   Arena arena;
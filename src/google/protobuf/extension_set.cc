@@ -16,20 +16,24 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/overload.h"
 #include "absl/hash/hash.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/numeric/bits.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/arena.h"
 #include "google/protobuf/extension_set_inl.h"  // IWYU pragma: keep
 #include "google/protobuf/internal_visibility.h"
@@ -93,22 +97,35 @@ using ExtensionRegistry =
 
 static const ExtensionRegistry* global_registry = nullptr;
 
+// The field numbers registered for each extendee, from which ExtensionTables
+// are built.
+using ExtensionNumbers =
+    absl::flat_hash_map<const MessageLite*, std::vector<int>>;
+
+static const ExtensionNumbers* global_extension_numbers = nullptr;
+
+// Incremented by every registration, so that ExtensionTables built before
+// the registration are rebuilt.
+static std::atomic<uint64_t> registry_generation{0};
+
 // This function is only called at startup, so there is no need for thread-
 // safety.
 void Register(const ExtensionInfo& info) {
   static auto local_static_registry = OnShutdownDelete(new ExtensionRegistry);
+  static auto local_static_numbers = OnShutdownDelete(new ExtensionNumbers);
   global_registry = local_static_registry;
+  global_extension_numbers = local_static_numbers;
   if (!local_static_registry->insert(info).second) {
     ABSL_LOG(FATAL) << "Multiple extension registrations for type \""
                     << info.message->GetTypeName() << "\", field number "
                     << info.number << ".";
   }
+  (*local_static_numbers)[info.message].push_back(info.number);
+  registry_generation.fetch_add(1, std::memory_order_relaxed);
 }
 
-const ExtensionInfo* FindRegisteredExtension(const MessageLite* extendee,
-                                             int number) {
-  if (!global_registry) return nullptr;
-
+const ExtensionInfo* FindRegisteredExtensionInRegistry(
+    const MessageLite* extendee, int number) {
   ExtensionInfoKey info;
   info.message = extendee;
   info.number = number;
@@ -123,6 +140,121 @@ const ExtensionInfo* FindRegisteredExtension(const MessageLite* extendee,
 
 }  // namespace
 
+// The extensions registered for one extendee, indexed by field number.  Most
+// extendees use a compact range of extension numbers, which is stored as a
+// dense array.  Other extendees have their extensions sorted by number.
+class ExtensionTable {
+ public:
+  ExtensionTable(const MessageLite* extendee, uint64_t generation,
+                 std::vector<ExtensionInfo> extensions)
+      : extendee_(extendee), generation_(generation) {
+    std::sort(extensions.begin(), extensions.end(),
+              [](const ExtensionInfo& a, const ExtensionInfo& b) {
+                return a.number < b.number;
+              });
+    if (extensions.empty()) return;
+    min_number_ = extensions.front().number;
+    const size_t span =
+        static_cast<size_t>(extensions.back().number - min_number_) + 1;
+    if (span > 2 * extensions.size() + 8) {
+      extensions_ = std::move(extensions);
+      return;
+    }
+    dense_ = true;
+    // Unused slots keep number 0, which is never a valid field number.
+    extensions_.resize(span);
+    for (const ExtensionInfo& extension : extensions) {
+      extensions_[extension.number - min_number_] = extension;
+    }
+  }
+
+  const MessageLite* extendee() const { return extendee_; }
+  uint64_t generation() const { return generation_; }
+
+  const ExtensionInfo* Find(int number) const {
+    if (dense_) {
+      const uint32_t index =
+          static_cast<uint32_t>(number) - static_cast<uint32_t>(min_number_);
+      if (index >= extensions_.size()) return nullptr;
+      const ExtensionInfo& extension = extensions_[index];
+      return extension.number == number ? &extension : nullptr;
+    }
+    auto it = std::lower_bound(extensions_.begin(), extensions_.end(), number,
+                               [](const ExtensionInfo& extension, int number) {
+                                 return extension.number < number;
+                               });
+    if (it == extensions_.end() || it->number != number) return nullptr;
+    return &*it;
+  }
+
+ private:
+  const MessageLite* extendee_;
+  uint64_t generation_;
+  int min_number_ = 0;
+  bool dense_ = false;
+  std::vector<ExtensionInfo> extensions_;
+};
+
+namespace {
+
+ABSL_CONST_INIT absl::Mutex extension_table_mutex(absl::kConstInit);
+
+// Builds the ExtensionTable of an extendee and caches it in its ClassData.
+// Tables replaced after a late registration are kept alive until shutdown,
+// since other threads may still be reading them.
+const ExtensionTable* BuildExtensionTable(const MessageLite* extendee,
+                                          const ClassData* class_data) {
+  static auto tables =
+      OnShutdownDelete(new std::vector<std::unique_ptr<ExtensionTable>>);
+
+  absl::MutexLock lock(&extension_table_mutex);
+  const uint64_t generation =
+      registry_generation.load(std::memory_order_relaxed);
+  const ExtensionTable* table = class_data->extension_table.Get();
+  if (table != nullptr && table->extendee() == extendee &&
+      table->generation() == generation) {
+    return table;
+  }
+
+  std::vector<ExtensionInfo> extensions;
+  auto it = global_extension_numbers->find(extendee);
+  if (it != global_extension_numbers->end()) {
+    extensions.reserve(it->second.size());
+    for (int number : it->second) {
+      extensions.push_back(
+          *FindRegisteredExtensionInRegistry(extendee, number));
+    }
+  }
+  tables->push_back(std::make_unique<ExtensionTable>(extendee, generation,
+                                                     std::move(extensions)));
+  class_data->extension_table.Set(tables->back().get());
+  return tables->back().get();
+}
+
+const ExtensionInfo* FindRegisteredExtension(const MessageLite* extendee,
+                                             int number) {
+  if (!global_registry) return nullptr;
+
+  // Extensions are looked up in a table cached in the extendee's ClassData,
+  // which saves probing the process-wide registry for each extension parsed.
+  const ClassData* class_data = GetClassData(*extendee);
+  const ExtensionTable* table = class_data->extension_table.Get();
+  if (ABSL_PREDICT_FALSE(
+          table == nullptr ||
+          table->generation() !=
+              registry_generation.load(std::memory_order_relaxed))) {
+    table = BuildExtensionTable(extendee, class_data);
+  }
+  if (ABSL_PREDICT_FALSE(table->extendee() != extendee)) {
+    // The registry is keyed by the extendee's address, and the table only
+    // covers the instance it was built for.
+    return FindRegisteredExtensionInRegistry(extendee, number);
+  }
+  return table->Find(number);
+}
+
+}  // namespace
+
 bool GeneratedExtensionFinder::Find(int number, ExtensionInfo* output) {
   const ExtensionInfo* extension = FindRegisteredExtension(extendee_, number);
   if (extension == nullptr) {
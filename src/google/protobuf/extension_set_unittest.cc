@@ -1713,6 +1713,61 @@ INSTANTIATE_TEST_SUITE_P(
       return name;
     });
 
+TEST(GeneratedExtensionFinderTest, FindsEveryRegisteredExtension) {
+  const Descriptor* descriptor = unittest::TestAllExtensions::descriptor();
+  std::vector<const FieldDescriptor*> extensions;
+  DescriptorPool::generated_pool()->FindAllExtensions(descriptor, &extensions);
+  ASSERT_FALSE(extensions.empty());
+
+  GeneratedExtensionFinder finder(
+      &unittest::TestAllExtensions::default_instance());
+  int max_number = 0;
+  for (const FieldDescriptor* field : extensions) {
+    ExtensionInfo info;
+    ASSERT_TRUE(finder.Find(field->number(), &info)) << field->full_name();
+    EXPECT_EQ(info.number, field->number());
+    // Generated code registers strings without UTF-8 validation as bytes.
+    EXPECT_EQ(info.type, field->type() == FieldDescriptor::TYPE_STRING &&
+                                 !field->requires_utf8_validation()
+                             ? FieldDescriptor::TYPE_BYTES
+                             : field->type());
+    EXPECT_EQ(info.is_repeated, field->is_repeated());
+    max_number = std::max(max_number, field->number());
+  }
+  for (int number = 1; number <= max_number + 10; ++number) {
+    ExtensionInfo info;
+    EXPECT_EQ(finder.Find(number, &info),
+              absl::c_any_of(extensions, [&](const FieldDescriptor* field) {
+                return field->number() == number;
+              }))
+        << number;
+  }
+}
+
+TEST(GeneratedExtensionFinderTest, FindsExtensionsRegisteredLate) {
+  const MessageLite* extendee =
+      &unittest::TestHugeFieldNumbers::default_instance();
+  GeneratedExtensionFinder finder(extendee);
+  ExtensionInfo info;
+  EXPECT_TRUE(finder.Find(unittest::kTestAllTypesFieldNumber, &info));
+
+  // Registering another extension after the first lookup updates the cached
+  // table. The registry is global, so only register on the first run when the
+  // test is repeated.
+  static bool registered = false;
+  if (!registered) {
+    EXPECT_FALSE(finder.Find(536869999, &info));
+    ExtensionSet::RegisterExtension(extendee, 536869999,
+                                    WireFormatLite::TYPE_INT32,
+                                    /*is_repeated=*/false, /*is_packed=*/false);
+    registered = true;
+  }
+  ASSERT_TRUE(finder.Find(536869999, &info));
+  EXPECT_EQ(info.type, WireFormatLite::TYPE_INT32);
+  EXPECT_TRUE(finder.Find(unittest::kTestAllTypesFieldNumber, &info));
+  EXPECT_EQ(info.type, WireFormatLite::TYPE_MESSAGE);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace protobuf
@@ -236,6 +236,14 @@ class PROTOBUF_EXPORT FieldMask final : public ::google::protobuf::Message
   ::google::protobuf::RepeatedPtrField<::std::string>* PROTOBUF_NONNULL _internal_mutable_paths();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.paths_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &FieldMask::clear_paths>(
+          msg, "paths", msg.paths(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FieldMask)
  private:
   class _Internal;
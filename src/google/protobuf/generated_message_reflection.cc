@@ -507,8 +507,11 @@ size_t Reflection::SpaceUsedLong(const Message& message) const {
                 // changed from the default value.
                 // Except oneof fields, those never point to a default instance,
                 // and there is no default instance to point to.
+                // Shared strings are owned by the message they are shared
+                // with.
                 const auto& str = GetField<ArenaStringPtr>(message, field);
-                if (!str.IsDefault() || schema_.InRealOneof(field)) {
+                if (!str.IsShared() &&
+                    (!str.IsDefault() || schema_.InRealOneof(field))) {
                   // string fields are represented by just a pointer, so also
                   // include sizeof(string) as well.
                   total_size += sizeof(std::string) +
@@ -2237,6 +2240,26 @@ void Reflection::SetString(Message* message, const FieldDescriptor* field,
   }
 }
 
+bool Reflection::ShareString(const Message& from, Message* to,
+                             const FieldDescriptor* field) const {
+  ABSL_DCHECK(!field->is_repeated());
+  ABSL_DCHECK_EQ(field->cpp_type(), FieldDescriptor::CPPTYPE_STRING);
+  Arena* arena = to->GetArena();
+  if (from.GetReflection() != this || arena == nullptr ||
+      arena != from.GetArena() || field->is_extension() || IsInlined(field) ||
+      IsMicroString(field) ||
+      field->cpp_string_type() == FieldDescriptor::CppStringType::kCord) {
+    return false;
+  }
+  if (schema_.InRealOneof(field) && !HasOneofField(*to, field)) {
+    ClearOneof(to, field->containing_oneof());
+  }
+  // The previous value, if any, is owned by the arena.
+  MutableField<ArenaStringPtr>(to, field)->InitShared(
+      GetField<ArenaStringPtr>(from, field));
+  return true;
+}
+
 std::string Reflection::GetRepeatedString(const Message& message,
                                           const FieldDescriptor* field,
                                           int index) const {
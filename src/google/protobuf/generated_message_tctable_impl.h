@@ -553,6 +553,40 @@ class PROTOBUF_EXPORT TcParser final {
     ABSL_LOG(FATAL) << "This should be unreachable";
   }
 
+  // Functions referenced by generated fast tables of small fixed-layout
+  // messages, whose fields are all singular numeric fields with 1-byte tags:
+  //
+  // FastFixedLayout is placed in the fast entry of the first field.  It parses
+  // the fields in field number order, which is the order in which they are
+  // serialized, without going back to TagDispatch between them.  As soon as
+  // the next tag is not the expected one (a field is missing, out of order,
+  // repeated or unknown) or the buffer runs out, it falls back to the
+  // table-driven parser at the current position.
+  //
+  // Each field is described by a FixedLayoutField() constant.  The value is
+  // parsed like the FastXxxS1 function with the same suffix would parse it.
+  enum FixedLayoutKind : uint8_t {
+    kFixedLayoutV8,
+    kFixedLayoutV32,
+    kFixedLayoutV64,
+    kFixedLayoutZ32,
+    kFixedLayoutZ64,
+    kFixedLayoutF32,
+    kFixedLayoutF64,
+  };
+
+  static constexpr uint64_t FixedLayoutField(FixedLayoutKind kind,
+                                             uint8_t coded_tag,
+                                             uint8_t hasbit_idx,
+                                             uint32_t offset) {
+    return uint64_t{coded_tag} | uint64_t{kind} << 8 |
+           uint64_t{hasbit_idx} << 16 | uint64_t{offset} << 32;
+  }
+
+  template <uint64_t kFirst, uint64_t... kRest>
+  PROTOBUF_NOINLINE PROTOBUF_CC static const char* FastFixedLayout(
+      PROTOBUF_TC_PARAM_DECL);
+
   // Functions referenced by generated fast tables (closed enum):
   //   E: closed enum (N.B.: open enums use V32, above)
   //   r: enum range  v: enum validator (ValidateEnum function)
@@ -1000,6 +1034,17 @@ class PROTOBUF_EXPORT TcParser final {
   template <typename LayoutType, typename TagType>
   PROTOBUF_CC static inline const char* PackedFixed(PROTOBUF_TC_PARAM_DECL);
 
+  // Implementations for FastFixedLayout:
+  template <uint64_t kField>
+  static inline const char* FixedLayoutParseValue(MessageLite* msg,
+                                                  const char* ptr,
+                                                  uint64_t& hasbits);
+  template <uint64_t kField, uint64_t... kRest>
+  static inline const char* FixedLayoutParseFields(MessageLite* msg,
+                                                   const char* ptr,
+                                                   ParseContext* ctx,
+                                                   uint64_t& hasbits);
+
   // Implementations for fast varint field parsing functions:
   template <typename FieldType, typename TagType, bool zigzag = false>
   PROTOBUF_CC static inline const char* SingularVarint(PROTOBUF_TC_PARAM_DECL);
@@ -1204,6 +1249,78 @@ PROTOBUF_ALWAYS_INLINE const char* TcParser::ParseLoop(
   return ptr;
 }
 
+template <uint64_t kField>
+inline const char* TcParser::FixedLayoutParseValue(MessageLite* msg,
+                                                   const char* ptr,
+                                                   uint64_t& hasbits) {
+  constexpr auto kKind = static_cast<FixedLayoutKind>((kField >> 8) & 0xFF);
+  constexpr uint8_t kHasbitIdx = (kField >> 16) & 0xFF;
+  constexpr uint32_t kOffset = static_cast<uint32_t>(kField >> 32);
+  if constexpr (kKind == kFixedLayoutF32 || kKind == kFixedLayoutF64) {
+    using LayoutType =
+        std::conditional_t<kKind == kFixedLayoutF32, uint32_t, uint64_t>;
+    RefAt<LayoutType>(msg, kOffset) = UnalignedLoad<LayoutType>(ptr);
+    ptr += sizeof(LayoutType);
+  } else {
+    using VarintType =
+        std::conditional_t<kKind == kFixedLayoutV32 || kKind == kFixedLayoutZ32,
+                           uint32_t, uint64_t>;
+    VarintType value;
+    ptr = VarintParse(ptr, &value);
+    if (ABSL_PREDICT_FALSE(ptr == nullptr)) return nullptr;
+    if constexpr (kKind == kFixedLayoutV8) {
+      RefAt<bool>(msg, kOffset) = value != 0;
+    } else if constexpr (kKind == kFixedLayoutZ32) {
+      RefAt<int32_t>(msg, kOffset) = WireFormatLite::ZigZagDecode32(value);
+    } else if constexpr (kKind == kFixedLayoutZ64) {
+      RefAt<int64_t>(msg, kOffset) = WireFormatLite::ZigZagDecode64(value);
+    } else {
+      RefAt<VarintType>(msg, kOffset) = value;
+    }
+  }
+  hasbits |= uint64_t{1} << kHasbitIdx;
+  return ptr;
+}
+
+template <uint64_t kField, uint64_t... kRest>
+inline const char* TcParser::FixedLayoutParseFields(MessageLite* msg,
+                                                    const char* ptr,
+                                                    ParseContext* ctx,
+                                                    uint64_t& hasbits) {
+  constexpr uint8_t kCodedTag = kField & 0xFF;
+  if (ABSL_PREDICT_FALSE(!ctx->DataAvailable(ptr) ||
+                         static_cast<uint8_t>(*ptr) != kCodedTag)) {
+    return ptr;
+  }
+  ptr = FixedLayoutParseValue<kField>(msg, ptr + 1, hasbits);
+  if constexpr (sizeof...(kRest) > 0) {
+    if (ABSL_PREDICT_TRUE(ptr != nullptr)) {
+      return FixedLayoutParseFields<kRest...>(msg, ptr, ctx, hasbits);
+    }
+  }
+  return ptr;
+}
+
+template <uint64_t kFirst, uint64_t... kRest>
+PROTOBUF_NOINLINE const char* TcParser::FastFixedLayout(
+    PROTOBUF_TC_PARAM_DECL) {
+  if (ABSL_PREDICT_FALSE(data.coded_tag<uint8_t>() != 0)) {
+    PROTOBUF_MUSTTAIL return MiniParse(PROTOBUF_TC_PARAM_NO_DATA_PASS);
+  }
+  ptr = FixedLayoutParseValue<kFirst>(msg, ptr + 1, hasbits);
+  if constexpr (sizeof...(kRest) > 0) {
+    if (ABSL_PREDICT_TRUE(ptr != nullptr)) {
+      ptr = FixedLayoutParseFields<kRest...>(msg, ptr, ctx, hasbits);
+    }
+  }
+  if (ABSL_PREDICT_FALSE(ptr == nullptr)) {
+    PROTOBUF_MUSTTAIL return Error(PROTOBUF_TC_PARAM_NO_DATA_PASS);
+  }
+  // Either all fields were parsed or the next tag was not the expected one.
+  // Continue with the regular dispatch in both cases.
+  PROTOBUF_MUSTTAIL return ToTagDispatch(PROTOBUF_TC_PARAM_NO_DATA_PASS);
+}
+
 // Prints the type card as or of labels, using known higher level labels.
 // Used for code generation, but also useful for debugging.
 PROTOBUF_EXPORT std::string TypeCardToString(uint16_t type_card);
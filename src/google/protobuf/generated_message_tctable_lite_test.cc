@@ -8,12 +8,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <string>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/algorithm/container.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
@@ -989,6 +991,92 @@ TEST(GeneratedMessageTctableLiteTest,
   EXPECT_LE(proto.vals().Capacity(), 2048);
 }
 
+static proto2_unittest::TestFixedLayout MakeFixedLayout() {
+  proto2_unittest::TestFixedLayout proto;
+  proto.set_x(1.5);
+  proto.set_y(-2.5f);
+  proto.set_z(-3);
+  proto.set_flag(true);
+  proto.set_id(0x123456789abcdef0);
+  proto.set_count(-1);
+  return proto;
+}
+
+TEST(GeneratedMessageTctableLiteTest, FixedLayoutInOrder) {
+  const proto2_unittest::TestFixedLayout proto = MakeFixedLayout();
+  proto2_unittest::TestFixedLayout parsed;
+  ASSERT_TRUE(parsed.ParseFromString(proto.SerializeAsString()));
+  EXPECT_EQ(parsed.x(), 1.5);
+  EXPECT_EQ(parsed.y(), -2.5f);
+  EXPECT_EQ(parsed.z(), -3);
+  EXPECT_TRUE(parsed.flag());
+  EXPECT_EQ(parsed.id(), 0x123456789abcdef0);
+  EXPECT_EQ(parsed.count(), -1);
+  EXPECT_EQ(parsed.SerializeAsString(), proto.SerializeAsString());
+}
+
+TEST(GeneratedMessageTctableLiteTest, FixedLayoutFallback) {
+  const proto2_unittest::TestFixedLayout full = MakeFixedLayout();
+  proto2_unittest::TestFixedLayout head;
+  head.set_x(full.x());
+  head.set_y(full.y());
+  proto2_unittest::TestFixedLayout middle;
+  middle.set_flag(full.flag());
+  proto2_unittest::TestFixedLayout tail;
+  tail.set_id(full.id());
+  tail.set_count(full.count());
+  proto2_unittest::TestFixedLayout stale;
+  stale.set_x(7);
+  stale.set_flag(false);
+  // Field 10 is not part of the message.
+  const std::string unknown_field("\x50\x01", 2);
+
+  for (const std::string& serialized : {
+           // Missing fields.
+           absl::StrCat(head.SerializeAsString(), middle.SerializeAsString()),
+           // Out of order.
+           absl::StrCat(tail.SerializeAsString(), middle.SerializeAsString(),
+                        head.SerializeAsString()),
+           absl::StrCat(head.SerializeAsString(), tail.SerializeAsString(),
+                        middle.SerializeAsString()),
+           // Repeated occurrences, the last one wins.
+           absl::StrCat(stale.SerializeAsString(), head.SerializeAsString(),
+                        middle.SerializeAsString()),
+           // Unknown field in between.
+           absl::StrCat(head.SerializeAsString(), unknown_field,
+                        middle.SerializeAsString(), tail.SerializeAsString()),
+       }) {
+    proto2_unittest::TestFixedLayout parsed;
+    ASSERT_TRUE(parsed.ParseFromString(serialized));
+    EXPECT_EQ(parsed.x(), full.x());
+    EXPECT_EQ(parsed.y(), full.y());
+    EXPECT_FALSE(parsed.has_z());
+    EXPECT_EQ(parsed.flag(), full.flag());
+    EXPECT_EQ(parsed.has_id(),
+              absl::StrContains(serialized, tail.SerializeAsString()));
+    if (parsed.has_id()) {
+      EXPECT_EQ(parsed.id(), full.id());
+      EXPECT_EQ(parsed.count(), full.count());
+    }
+  }
+
+  proto2_unittest::TestFixedLayout parsed;
+  ASSERT_TRUE(parsed.ParseFromString(absl::StrCat(
+      head.SerializeAsString(), unknown_field, middle.SerializeAsString())));
+  EXPECT_EQ(parsed.unknown_fields().field_count(), 1);
+}
+
+TEST(GeneratedMessageTctableLiteTest, FixedLayoutMalformedVarint) {
+  proto2_unittest::TestFixedLayout head;
+  head.set_x(1);
+  head.set_y(2);
+  // Field 3 with a varint that doesn't end within 10 bytes.
+  std::string serialized =
+      absl::StrCat(head.SerializeAsString(), "\x18", std::string(10, '\xff'));
+  proto2_unittest::TestFixedLayout parsed;
+  EXPECT_FALSE(parsed.ParseFromString(serialized));
+}
+
 
 
 }  // namespace internal
@@ -397,6 +397,78 @@ constexpr absl::optional<uintptr_t> EncodePlacementArenaOffsets(
   return arena_bits;
 }
 
+// Flags describing a field to the visitor of google::protobuf::VisitFields().
+enum VisitFieldFlags : int {
+  kVisitSingular = 0,
+  kVisitRepeated = 1 << 0,
+  kVisitMap = 1 << 1,
+  kVisitOneof = 1 << 2,
+};
+
+// Describes a present field of a generated message to the visitor of
+// google::protobuf::VisitFields(). Everything except the value is a
+// compile-time constant. The object refers to the value and must not outlive
+// the call of the visitor.
+template <typename MessageT, typename ValueT, int kNumber,
+          WireFormatLite::FieldType kType, int kFlags, auto kClear>
+class GeneratedFieldInfo {
+ public:
+  GeneratedFieldInfo(MessageT& message, absl::string_view name,
+                     const ValueT& value)
+      : message_(message), name_(name), value_(value) {}
+
+  static constexpr int number() { return kNumber; }
+  static constexpr WireFormatLite::FieldType type() { return kType; }
+  absl::string_view name() const { return name_; }
+
+  // Returns the value as returned by the getter of the field, e.g. a
+  // `const RepeatedField<int32_t>&` for a repeated int32 field.
+  const ValueT& Get() const { return value_; }
+
+  // Clears the field. Only available when visiting a non-const message. The
+  // value returned by Get() must not be used afterwards.
+  template <typename M = MessageT,
+            typename = std::enable_if_t<!std::is_const<M>::value>>
+  void Clear() const {
+    (message_.*kClear)();
+  }
+
+  static constexpr bool is_repeated = (kFlags & kVisitRepeated) != 0;  // NOLINT
+  static constexpr bool is_map = (kFlags & kVisitMap) != 0;            // NOLINT
+  static constexpr bool is_extension = false;                          // NOLINT
+  static constexpr bool is_oneof = (kFlags & kVisitOneof) != 0;        // NOLINT
+
+ private:
+  MessageT& message_;
+  absl::string_view name_;
+  const ValueT& value_;
+};
+
+template <int kNumber, WireFormatLite::FieldType kType, int kFlags,
+          auto kClear, typename MessageT, typename ValueT, typename VisitorT>
+PROTOBUF_ALWAYS_INLINE void VisitGeneratedField(MessageT& message,
+                                                absl::string_view name,
+                                                const ValueT& value,
+                                                VisitorT& visitor) {
+  visitor(GeneratedFieldInfo<MessageT, ValueT, kNumber, kType, kFlags, kClear>(
+      message, name, value));
+}
+
+// Returns true if a singular field without presence has a non-default value,
+// which is when it is serialized. Like for reflection, -0.0 is considered set.
+template <typename T>
+bool IsImplicitPresenceFieldSet(const T& value) {
+  if constexpr (std::is_same<T, float>::value) {
+    return absl::bit_cast<uint32_t>(value) != 0;
+  } else if constexpr (std::is_same<T, double>::value) {
+    return absl::bit_cast<uint64_t>(value) != 0;
+  } else if constexpr (std::is_arithmetic<T>::value || std::is_enum<T>::value) {
+    return value != T{};
+  } else {
+    return !value.empty();
+  }
+}
+
 // The struct PrivateAccess is used to provide access to private members of
 // message classes without making them public. This is useful for highly
 // optimized code paths that need to access internals.
@@ -0,0 +1,345 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/io/async_file_stream.h"
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+namespace {
+
+// O_DIRECT requires buffers, sizes and file offsets aligned to the logical
+// block size of the device, which is at most the page size in practice.
+constexpr size_t kAlignment = 4096;
+
+struct AlignedDelete {
+  void operator()(char* ptr) const {
+    ::operator delete(ptr, std::align_val_t{kAlignment});
+  }
+};
+
+using AlignedBuffer = std::unique_ptr<char, AlignedDelete>;
+
+AlignedBuffer AllocateAligned(int size) {
+  return AlignedBuffer(static_cast<char*>(
+      ::operator new(static_cast<size_t>(size), std::align_val_t{kAlignment})));
+}
+
+int RoundUpToAlignment(int size) {
+  constexpr int kMaxSize = INT_MAX / kAlignment * kAlignment;
+  size = std::min(std::max(size, 1), kMaxSize);
+  return static_cast<int>((size + kAlignment - 1) / kAlignment * kAlignment);
+}
+
+}  // namespace
+
+// ===================================================================
+
+struct AsyncFileInputStream::Block {
+  AlignedBuffer data;
+  int size = 0;
+};
+
+AsyncFileInputStream::AsyncFileInputStream(int file_descriptor)
+    : AsyncFileInputStream(file_descriptor, Options()) {}
+
+AsyncFileInputStream::AsyncFileInputStream(int file_descriptor,
+                                           const Options& options)
+    : file_(file_descriptor),
+      block_size_(RoundUpToAlignment(options.block_size)),
+      direct_io_(false),
+      blocks_(std::max(options.num_blocks, 1)) {
+  for (Block& block : blocks_) block.data = AllocateAligned(block_size_);
+#ifdef O_DIRECT
+  if (options.direct_io) {
+    original_flags_ = fcntl(file_, F_GETFL);
+    direct_io_ = original_flags_ != -1 &&
+                 fcntl(file_, F_SETFL, original_flags_ | O_DIRECT) == 0;
+  }
+#endif
+  thread_ = std::thread([this] { ReadAhead(); });
+}
+
+AsyncFileInputStream::~AsyncFileInputStream() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_ = true;
+    changed_.SignalAll();
+  }
+  thread_.join();
+  if (direct_io_) fcntl(file_, F_SETFL, original_flags_);
+}
+
+int AsyncFileInputStream::GetErrno() const {
+  absl::MutexLock lock(&mutex_);
+  return errno_;
+}
+
+int AsyncFileInputStream::ReadBlock(char* buffer) {
+  while (true) {
+    const ssize_t result = read(file_, buffer, block_size_);
+    if (result >= 0) return static_cast<int>(result);
+    if (errno == EINTR) continue;
+    if (direct_io_ && errno == EINVAL) {
+      // The file system does not support direct I/O, or the file position is
+      // not aligned.
+      fcntl(file_, F_SETFL, original_flags_);
+      direct_io_ = false;
+      continue;
+    }
+    return -errno;
+  }
+}
+
+void AsyncFileInputStream::ReadAhead() {
+  const int64_t num_blocks = static_cast<int64_t>(blocks_.size());
+  for (int64_t n = 0;; ++n) {
+    {
+      absl::MutexLock lock(&mutex_);
+      // Wait for the caller to release the buffer.
+      while (!stop_ && n - blocks_released_ >= num_blocks) {
+        changed_.Wait(&mutex_);
+      }
+      if (stop_) return;
+    }
+
+    // A short read is returned as is rather than retried, so that data from a
+    // pipe or socket is handed out as soon as it arrives.
+    Block& block = blocks_[n % num_blocks];
+    const int result = ReadBlock(block.data.get());
+
+    absl::MutexLock lock(&mutex_);
+    if (result <= 0) {
+      errno_ = -result;
+      done_ = true;
+      changed_.SignalAll();
+      return;
+    }
+    block.size = result;
+    blocks_read_ = n + 1;
+    changed_.SignalAll();
+  }
+}
+
+bool AsyncFileInputStream::Next(const void** data, int* size) {
+  const int64_t num_blocks = static_cast<int64_t>(blocks_.size());
+  if (backup_bytes_ > 0) {
+    const Block& block = blocks_[(next_block_ - 1) % num_blocks];
+    *data = block.data.get() + block.size - backup_bytes_;
+    *size = backup_bytes_;
+    position_ += backup_bytes_;
+    backup_bytes_ = 0;
+    return true;
+  }
+
+  absl::MutexLock lock(&mutex_);
+  if (holding_block_) {
+    ++blocks_released_;
+    holding_block_ = false;
+    changed_.SignalAll();
+  }
+  while (blocks_read_ == next_block_ && !done_) changed_.Wait(&mutex_);
+  if (blocks_read_ == next_block_) return false;
+
+  const Block& block = blocks_[next_block_ % num_blocks];
+  ++next_block_;
+  holding_block_ = true;
+  *data = block.data.get();
+  *size = block.size;
+  position_ += block.size;
+  return true;
+}
+
+void AsyncFileInputStream::BackUp(int count) {
+  ABSL_CHECK(holding_block_)
+      << "BackUp() can only be called after a successful Next().";
+  ABSL_CHECK_GE(count, 0);
+  const Block& block = blocks_[(next_block_ - 1) % blocks_.size()];
+  ABSL_CHECK_LE(backup_bytes_ + count, block.size)
+      << "Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  backup_bytes_ += count;
+  position_ -= count;
+}
+
+bool AsyncFileInputStream::Skip(int count) {
+  ABSL_CHECK_GE(count, 0);
+  const void* data;
+  int size;
+  while (count > 0) {
+    if (!Next(&data, &size)) return false;
+    if (size > count) {
+      BackUp(size - count);
+      return true;
+    }
+    count -= size;
+  }
+  return true;
+}
+
+int64_t AsyncFileInputStream::ByteCount() const { return position_; }
+
+// ===================================================================
+
+struct AsyncFileOutputStream::Block {
+  AlignedBuffer data;
+  int size = 0;
+};
+
+AsyncFileOutputStream::AsyncFileOutputStream(int file_descriptor)
+    : AsyncFileOutputStream(file_descriptor, Options()) {}
+
+AsyncFileOutputStream::AsyncFileOutputStream(int file_descriptor,
+                                             const Options& options)
+    : file_(file_descriptor),
+      block_size_(RoundUpToAlignment(options.block_size)),
+      blocks_(std::max(options.num_blocks, 1)) {
+  for (Block& block : blocks_) block.data = AllocateAligned(block_size_);
+  thread_ = std::thread([this] { WriteBehind(); });
+}
+
+AsyncFileOutputStream::~AsyncFileOutputStream() {
+  Flush();
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_ = true;
+    changed_.SignalAll();
+  }
+  thread_.join();
+}
+
+int AsyncFileOutputStream::GetErrno() const {
+  absl::MutexLock lock(&mutex_);
+  return errno_;
+}
+
+void AsyncFileOutputStream::WriteBehind() {
+  const int64_t num_blocks = static_cast<int64_t>(blocks_.size());
+  while (true) {
+    int64_t n;
+    bool failed;
+    {
+      absl::MutexLock lock(&mutex_);
+      while (!stop_ && blocks_written_ == blocks_submitted_) {
+        changed_.Wait(&mutex_);
+      }
+      if (blocks_written_ == blocks_submitted_) return;
+      n = blocks_written_;
+      failed = errno_ != 0;
+    }
+
+    // After an error, the remaining blocks are dropped.
+    int error = 0;
+    const Block& block = blocks_[n % num_blocks];
+    for (int written = 0; !failed && written < block.size;) {
+      const ssize_t result =
+          write(file_, block.data.get() + written, block.size - written);
+      if (result < 0) {
+        if (errno == EINTR) continue;
+        error = errno;
+        break;
+      }
+      written += static_cast<int>(result);
+    }
+
+    absl::MutexLock lock(&mutex_);
+    if (error != 0) errno_ = error;
+    blocks_written_ = n + 1;
+    changed_.SignalAll();
+  }
+}
+
+void AsyncFileOutputStream::Submit() {
+  ABSL_DCHECK(holding_block_);
+  holding_block_ = false;
+  if (used_ == 0) return;
+  bytes_submitted_ += used_;
+
+  absl::MutexLock lock(&mutex_);
+  blocks_[blocks_submitted_ % blocks_.size()].size = used_;
+  ++blocks_submitted_;
+  used_ = 0;
+  changed_.SignalAll();
+}
+
+bool AsyncFileOutputStream::Next(void** data, int* size) {
+  if (holding_block_) {
+    if (used_ < block_size_) {
+      // Return the part of the block given back by BackUp().
+      const int64_t n = [&] {
+        absl::MutexLock lock(&mutex_);
+        return blocks_submitted_;
+      }();
+      *data = blocks_[n % blocks_.size()].data.get() + used_;
+      *size = block_size_ - used_;
+      used_ = block_size_;
+      return true;
+    }
+    Submit();
+  }
+
+  absl::MutexLock lock(&mutex_);
+  const int64_t num_blocks = static_cast<int64_t>(blocks_.size());
+  while (errno_ == 0 && blocks_submitted_ - blocks_written_ >= num_blocks) {
+    changed_.Wait(&mutex_);
+  }
+  if (errno_ != 0) return false;
+  holding_block_ = true;
+  used_ = block_size_;
+  *data = blocks_[blocks_submitted_ % num_blocks].data.get();
+  *size = block_size_;
+  return true;
+}
+
+void AsyncFileOutputStream::BackUp(int count) {
+  ABSL_CHECK(holding_block_)
+      << "BackUp() can only be called after a successful Next().";
+  ABSL_CHECK_GE(count, 0);
+  ABSL_CHECK_LE(count, used_)
+      << "Can't back up over more bytes than were returned by the last call"
+         " to Next().";
+  used_ -= count;
+}
+
+int64_t AsyncFileOutputStream::ByteCount() const {
+  return bytes_submitted_ + (holding_block_ ? used_ : 0);
+}
+
+bool AsyncFileOutputStream::Flush() {
+  if (holding_block_) Submit();
+  absl::MutexLock lock(&mutex_);
+  while (blocks_written_ != blocks_submitted_) changed_.Wait(&mutex_);
+  return errno_ == 0;
+}
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // !_WIN32
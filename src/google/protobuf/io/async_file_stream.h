@@ -0,0 +1,189 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// This file contains ZeroCopyStream implementations for Unix file descriptors
+// that overlap I/O with computation.  FileInputStream and FileOutputStream
+// issue one blocking read() or write() at a time, in small blocks, on the
+// calling thread.  The streams here instead move the reads and writes to a
+// background thread that works on several large, aligned buffers ahead of (or
+// behind) the caller, so that parsing a large file is not bound by read
+// latency.
+//
+// These streams are only available on POSIX systems.
+
+#ifndef GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
+#define GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
+
+#ifndef _WIN32
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+// A ZeroCopyInputStream which reads from a file descriptor, reading ahead of
+// the caller on a background thread.
+//
+// The stream reads sequentially from the descriptor's current position.  It
+// owns the descriptor's position while it exists, and may have read past the
+// last byte returned by Next() when it is destroyed.
+class PROTOBUF_EXPORT AsyncFileInputStream final : public ZeroCopyInputStream {
+ public:
+  struct Options {
+    // The number of bytes to read with each read(), and the size of the
+    // buffers returned by Next().  Rounded up to a multiple of 4096.
+    int block_size = 1 << 20;
+    // The number of buffers.  Up to this many blocks are read ahead of the
+    // caller.
+    int num_blocks = 4;
+    // Whether to bypass the page cache with O_DIRECT, where supported.  This
+    // avoids copying file data through the kernel's cache, which helps when
+    // a large file is read once.  The stream falls back to ordinary reads if
+    // the file system rejects direct I/O.
+    bool direct_io = false;
+  };
+
+  explicit AsyncFileInputStream(int file_descriptor);
+  AsyncFileInputStream(int file_descriptor, const Options& options);
+  AsyncFileInputStream(const AsyncFileInputStream&) = delete;
+  AsyncFileInputStream& operator=(const AsyncFileInputStream&) = delete;
+  // Stops reading ahead.  Does not close the file descriptor.
+  ~AsyncFileInputStream() override;
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const;
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  struct Block;
+
+  // Runs on the background thread.
+  void ReadAhead();
+  int ReadBlock(char* buffer);
+
+  const int file_;
+  const int block_size_;
+  bool direct_io_;
+  int original_flags_ = -1;
+
+  std::vector<Block> blocks_;
+
+  mutable absl::Mutex mutex_;
+  // Signaled whenever any of the state below changes.
+  absl::CondVar changed_;
+  // The number of blocks that have been read, and released by the caller.
+  int64_t blocks_read_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t blocks_released_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Whether the reader has reached the end of the file or an error.
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stop_ ABSL_GUARDED_BY(mutex_) = false;
+  int errno_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // Only accessed by the caller's thread.
+  int64_t next_block_ = 0;
+  bool holding_block_ = false;
+  int backup_bytes_ = 0;
+  int64_t position_ = 0;
+
+  std::thread thread_;
+};
+
+// A ZeroCopyOutputStream which writes to a file descriptor, writing behind the
+// caller on a background thread.
+class PROTOBUF_EXPORT AsyncFileOutputStream final
+    : public ZeroCopyOutputStream {
+ public:
+  struct Options {
+    // The number of bytes to write with each write(), and the size of the
+    // buffers returned by Next().
+    int block_size = 1 << 20;
+    // The number of buffers.  Up to this many blocks may be waiting to be
+    // written before Next() blocks.
+    int num_blocks = 4;
+  };
+
+  explicit AsyncFileOutputStream(int file_descriptor);
+  AsyncFileOutputStream(int file_descriptor, const Options& options);
+  AsyncFileOutputStream(const AsyncFileOutputStream&) = delete;
+  AsyncFileOutputStream& operator=(const AsyncFileOutputStream&) = delete;
+  // Flushes all data.  Does not close the file descriptor.
+  ~AsyncFileOutputStream() override;
+
+  // Waits until all data has been written to the file descriptor.  Returns
+  // false if an error has occurred; use GetErrno() to examine the error.
+  bool Flush();
+
+  // If an I/O error has occurred on this file descriptor, this is the
+  // errno from that error.  Otherwise, this is zero.  Once an error
+  // occurs, the stream is broken and all subsequent operations will
+  // fail.
+  int GetErrno() const;
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  struct Block;
+
+  // Hands the current block to the background thread.
+  void Submit();
+  // Runs on the background thread.
+  void WriteBehind();
+
+  const int file_;
+  const int block_size_;
+
+  std::vector<Block> blocks_;
+
+  mutable absl::Mutex mutex_;
+  // Signaled whenever any of the state below changes.
+  absl::CondVar changed_;
+  // The number of blocks that have been submitted, and written.
+  int64_t blocks_submitted_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t blocks_written_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stop_ ABSL_GUARDED_BY(mutex_) = false;
+  int errno_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  // Only accessed by the caller's thread.
+  bool holding_block_ = false;
+  // The number of bytes of the current block handed out by Next().
+  int used_ = 0;
+  int64_t bytes_submitted_ = 0;
+
+  std::thread thread_;
+};
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // !_WIN32
+
+#endif  // GOOGLE_PROTOBUF_IO_ASYNC_FILE_STREAM_H__
@@ -506,6 +506,22 @@ class PROTOBUF_EXPORT CodedInputStream {
   // factory has been provided.
   MessageFactory* GetExtensionFactory();
 
+  // Unknown Fields --------------------------------------------------
+  // ADVANCED USAGE:  99.9% of people can ignore this section.
+  //
+  // By default, parsing a (non-lite) message into an UnknownFieldSet creates
+  // an UnknownField, and a string or group, for each unknown field.  If this
+  // is set, parsing from this stream instead appends the unknown fields of
+  // the message and of its submessages to a single buffer of wire-format
+  // bytes in each UnknownFieldSet, as lite messages do.  The bytes are only
+  // decoded once the fields are accessed or modified, and serializing the set
+  // writes them back as they are, so this saves most of the allocations for
+  // messages which only pass unknown fields along.
+  void SetKeepUnknownFieldsAsWireBytes(bool keep);
+
+  // Get the value set via SetKeepUnknownFieldsAsWireBytes().
+  bool KeepsUnknownFieldsAsWireBytes() const;
+
  private:
   const uint8_t* buffer_;
   const uint8_t* buffer_end_;  // pointer to the end of the buffer.
@@ -558,6 +574,9 @@ class PROTOBUF_EXPORT CodedInputStream {
   const DescriptorPool* extension_pool_;
   MessageFactory* extension_factory_;
 
+  // See SetKeepUnknownFieldsAsWireBytes().
+  bool keep_unknown_fields_as_wire_bytes_;
+
   // Private member functions.
 
   // Fallback when Skip() goes past the end of the current buffer.
@@ -1584,6 +1603,14 @@ inline MessageFactory* CodedInputStream::GetExtensionFactory() {
   return extension_factory_;
 }
 
+inline void CodedInputStream::SetKeepUnknownFieldsAsWireBytes(bool keep) {
+  keep_unknown_fields_as_wire_bytes_ = keep;
+}
+
+inline bool CodedInputStream::KeepsUnknownFieldsAsWireBytes() const {
+  return keep_unknown_fields_as_wire_bytes_;
+}
+
 inline int CodedInputStream::BufferSize() const {
   return static_cast<int>(buffer_end_ - buffer_);
 }
@@ -1604,7 +1631,8 @@ inline CodedInputStream::CodedInputStream(ZeroCopyInputStream* input)
       recursion_budget_(default_recursion_limit_),
       recursion_limit_(default_recursion_limit_),
       extension_pool_(nullptr),
-      extension_factory_(nullptr) {
+      extension_factory_(nullptr),
+      keep_unknown_fields_as_wire_bytes_(false) {
   // Eagerly Refresh() so buffer space is immediately available.
   Refresh();
 }
@@ -1625,7 +1653,8 @@ inline CodedInputStream::CodedInputStream(const uint8_t* buffer, int size)
       recursion_budget_(default_recursion_limit_),
       recursion_limit_(default_recursion_limit_),
       extension_pool_(nullptr),
-      extension_factory_(nullptr) {
+      extension_factory_(nullptr),
+      keep_unknown_fields_as_wire_bytes_(false) {
   // Note that setting current_limit_ == size is important to prevent some
   // code paths from trying to access input_ and segfaulting.
 }
@@ -7,16 +7,24 @@
 
 // Author: brianolson@google.com (Brian Olson)
 //
-// This file contains the implementation of classes GzipInputStream and
-// GzipOutputStream.
+// This file contains the implementation of classes GzipInputStream,
+// GzipOutputStream and ParallelGzipOutputStream.
 
 
 #if HAVE_ZLIB
 #include "google/protobuf/io/gzip_stream.h"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "google/protobuf/stubs/common.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/synchronization/mutex.h"
 #include "google/protobuf/port.h"
 
 namespace google {
@@ -305,6 +313,337 @@ bool GzipOutputStream::Close() {
   return ok;
 }
 
+// ===================================================================
+
+namespace {
+
+// The largest distance a deflate match can reach back.
+constexpr size_t kWindowSize = 32768;
+
+}  // namespace
+
+struct ParallelGzipOutputStream::Block {
+  std::string input;
+  // The input preceding this block, which matches may refer to.
+  std::string dictionary;
+  bool last = false;
+
+  // Written by the worker.
+  std::string output;
+  uLong check = 0;
+  int error = Z_OK;
+  // Guarded by Workers::mutex_.
+  bool done = false;
+};
+
+// Compresses a block as a raw deflate fragment.  All but the last block end
+// with a sync flush, which leaves the fragment byte aligned so that the
+// fragments can simply be concatenated.
+static void CompressBlock(const ParallelGzipOutputStream::Options& options,
+                          std::string& input, const std::string& dictionary,
+                          bool last, std::string& output, uLong& check,
+                          int& error) {
+  if (options.format == GzipOutputStream::ZLIB) {
+    check = adler32(adler32(0L, Z_NULL, 0),
+                    reinterpret_cast<const Bytef*>(input.data()),
+                    static_cast<uInt>(input.size()));
+  } else {
+    check = crc32(crc32(0L, Z_NULL, 0),
+                  reinterpret_cast<const Bytef*>(input.data()),
+                  static_cast<uInt>(input.size()));
+  }
+
+  z_stream zcontext;
+  memset(&zcontext, 0, sizeof(zcontext));
+  error = deflateInit2(&zcontext, options.compression_level, Z_DEFLATED,
+                       /* windowBits (raw deflate) */ -15,
+                       /* memLevel (default) */ 8,
+                       options.compression_strategy);
+  if (error != Z_OK) return;
+  if (!dictionary.empty()) {
+    error = deflateSetDictionary(
+        &zcontext, reinterpret_cast<const Bytef*>(dictionary.data()),
+        static_cast<uInt>(dictionary.size()));
+  }
+
+  const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+  output.resize(deflateBound(&zcontext, input.size()) + 16);
+  zcontext.next_in = reinterpret_cast<Bytef*>(&input[0]);
+  zcontext.avail_in = static_cast<uInt>(input.size());
+  zcontext.next_out = reinterpret_cast<Bytef*>(&output[0]);
+  zcontext.avail_out = static_cast<uInt>(output.size());
+  while (error == Z_OK) {
+    if (zcontext.avail_out == 0) {
+      const size_t used = output.size();
+      output.resize(used * 2);
+      zcontext.next_out = reinterpret_cast<Bytef*>(&output[used]);
+      zcontext.avail_out = static_cast<uInt>(output.size() - used);
+    }
+    error = deflate(&zcontext, flush);
+    if (error == Z_STREAM_END) {
+      error = Z_OK;
+      break;
+    }
+    if (!last && error == Z_OK && zcontext.avail_in == 0 &&
+        zcontext.avail_out != 0) {
+      break;
+    }
+  }
+  output.resize(output.size() - zcontext.avail_out);
+  // deflateEnd() reports Z_DATA_ERROR for the unfinished, sync flushed
+  // blocks, which is expected.
+  deflateEnd(&zcontext);
+}
+
+class ParallelGzipOutputStream::Workers {
+ public:
+  Workers(int num_threads, const Options& options) : options_(options) {
+    for (int i = 0; i < num_threads; ++i) {
+      threads_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ~Workers() {
+    {
+      absl::MutexLock lock(&mutex_);
+      stop_ = true;
+      changed_.SignalAll();
+    }
+    for (std::thread& thread : threads_) thread.join();
+  }
+
+  void Add(Block* block) {
+    absl::MutexLock lock(&mutex_);
+    queue_.push_back(block);
+    changed_.SignalAll();
+  }
+
+  // Returns whether the block has been compressed, waiting for it if `wait`.
+  bool Done(const Block& block, bool wait) {
+    absl::MutexLock lock(&mutex_);
+    while (wait && !block.done) changed_.Wait(&mutex_);
+    return block.done;
+  }
+
+ private:
+  void Run() {
+    while (true) {
+      Block* block;
+      {
+        absl::MutexLock lock(&mutex_);
+        while (!stop_ && queue_.empty()) changed_.Wait(&mutex_);
+        if (stop_) return;
+        block = queue_.front();
+        queue_.pop_front();
+      }
+      CompressBlock(options_, block->input, block->dictionary, block->last,
+                    block->output, block->check, block->error);
+      absl::MutexLock lock(&mutex_);
+      block->done = true;
+      changed_.SignalAll();
+    }
+  }
+
+  const Options options_;
+  absl::Mutex mutex_;
+  absl::CondVar changed_;
+  std::deque<Block*> queue_ ABSL_GUARDED_BY(mutex_);
+  bool stop_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::thread> threads_;
+};
+
+ParallelGzipOutputStream::Options::Options()
+    : format(GzipOutputStream::GZIP),
+      compression_level(Z_DEFAULT_COMPRESSION),
+      compression_strategy(Z_DEFAULT_STRATEGY),
+      block_size(128 * 1024),
+      num_threads(0) {}
+
+ParallelGzipOutputStream::ParallelGzipOutputStream(
+    ZeroCopyOutputStream* sub_stream)
+    : ParallelGzipOutputStream(sub_stream, Options()) {}
+
+ParallelGzipOutputStream::ParallelGzipOutputStream(
+    ZeroCopyOutputStream* sub_stream, const Options& options)
+    : sub_stream_(sub_stream), options_(options) {
+  options_.block_size = std::max(options_.block_size, 1);
+  int num_threads = options_.num_threads;
+  if (num_threads <= 0) {
+    num_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+  }
+  if (num_threads > 1) {
+    workers_ = std::make_unique<Workers>(num_threads, options_);
+  }
+  // Keep every worker busy while the caller fills the next block.
+  max_pending_ = 2 * static_cast<size_t>(num_threads);
+  check_ = options_.format == GzipOutputStream::ZLIB ? adler32(0L, Z_NULL, 0)
+                                                      : crc32(0L, Z_NULL, 0);
+}
+
+ParallelGzipOutputStream::~ParallelGzipOutputStream() {
+  Close();
+  // Stop the workers before the blocks they may still be compressing are
+  // destroyed.
+  workers_.reset();
+}
+
+void ParallelGzipOutputStream::Submit(bool last) {
+  auto block = std::make_unique<Block>();
+  block->input = std::move(buffer_);
+  block->input.resize(used_);
+  block->dictionary = window_;
+  block->last = last;
+  if (block->input.size() >= kWindowSize) {
+    window_.assign(block->input, block->input.size() - kWindowSize,
+                   kWindowSize);
+  } else {
+    window_.append(block->input);
+    if (window_.size() > kWindowSize) {
+      window_.erase(0, window_.size() - kWindowSize);
+    }
+  }
+  bytes_submitted_ += used_;
+  buffer_.clear();
+  used_ = 0;
+
+  if (workers_ == nullptr) {
+    CompressBlock(options_, block->input, block->dictionary, block->last,
+                  block->output, block->check, block->error);
+    block->done = true;
+  } else {
+    workers_->Add(block.get());
+  }
+  pending_.push_back(std::move(block));
+}
+
+bool ParallelGzipOutputStream::WriteRaw(const void* data, size_t size) {
+  const char* input = static_cast<const char*>(data);
+  while (size > 0) {
+    void* out;
+    int out_size;
+    if (!sub_stream_->Next(&out, &out_size)) return false;
+    const size_t n = std::min(size, static_cast<size_t>(out_size));
+    memcpy(out, input, n);
+    input += n;
+    size -= n;
+    sub_stream_->BackUp(out_size - static_cast<int>(n));
+  }
+  return true;
+}
+
+bool ParallelGzipOutputStream::WriteBlocks(size_t max_pending) {
+  while (!pending_.empty()) {
+    Block& block = *pending_.front();
+    const bool wait = pending_.size() > max_pending;
+    if (workers_ != nullptr && !workers_->Done(block, wait)) break;
+    if (block.error != Z_OK) {
+      zerror_ = block.error;
+      return false;
+    }
+
+    if (!header_written_) {
+      bool ok;
+      if (options_.format == GzipOutputStream::ZLIB) {
+        // CMF: deflate with a 32kB window.  FLG: the compression level
+        // hint, and a check value making the header a multiple of 31.
+        const int level = options_.compression_level;
+        const int level_hint = level == Z_DEFAULT_COMPRESSION ? 2
+                               : level < 2                    ? 0
+                               : level < 6                    ? 1
+                               : level == 6                   ? 2
+                                                              : 3;
+        uint8_t header[2] = {0x78, static_cast<uint8_t>(level_hint << 6)};
+        header[1] += 31 - (header[0] * 256 + header[1]) % 31;
+        ok = WriteRaw(header, sizeof(header));
+      } else {
+        // No file name or modification time, and an unknown OS.
+        const uint8_t header[10] = {0x1f, 0x8b, Z_DEFLATED, 0, 0,
+                                    0,    0,    0,          0, 0xff};
+        ok = WriteRaw(header, sizeof(header));
+      }
+      if (!ok) {
+        zerror_ = Z_BUF_ERROR;
+        return false;
+      }
+      header_written_ = true;
+    }
+
+    if (!WriteRaw(block.output.data(), block.output.size())) {
+      zerror_ = Z_BUF_ERROR;
+      return false;
+    }
+    const auto size = static_cast<z_off_t>(block.input.size());
+    check_ = options_.format == GzipOutputStream::ZLIB
+                 ? adler32_combine(check_, block.check, size)
+                 : crc32_combine(check_, block.check, size);
+    // Reuse the input buffer for the next block.
+    if (buffer_.capacity() == 0) buffer_ = std::move(block.input);
+    pending_.pop_front();
+  }
+  return true;
+}
+
+bool ParallelGzipOutputStream::Next(void** data, int* size) {
+  if (zerror_ != Z_OK || closed_) return false;
+  if (used_ == options_.block_size) {
+    Submit(/* last */ false);
+    if (!WriteBlocks(max_pending_)) return false;
+  }
+  buffer_.resize(options_.block_size);
+  *data = &buffer_[used_];
+  *size = options_.block_size - used_;
+  used_ = options_.block_size;
+  return true;
+}
+
+void ParallelGzipOutputStream::BackUp(int count) {
+  ABSL_CHECK_GE(count, 0);
+  ABSL_CHECK_LE(count, used_);
+  used_ -= count;
+}
+
+int64_t ParallelGzipOutputStream::ByteCount() const {
+  return bytes_submitted_ + used_;
+}
+
+bool ParallelGzipOutputStream::Flush() {
+  if (zerror_ != Z_OK || closed_) return false;
+  if (used_ > 0) Submit(/* last */ false);
+  return WriteBlocks(0);
+}
+
+bool ParallelGzipOutputStream::Close() {
+  if (closed_) return zerror_ == Z_OK;
+  closed_ = true;
+  if (zerror_ != Z_OK) return false;
+  Submit(/* last */ true);
+  if (!WriteBlocks(0)) return false;
+
+  uint8_t trailer[8];
+  size_t trailer_size;
+  if (options_.format == GzipOutputStream::ZLIB) {
+    // Adler-32 of the input, most significant byte first.
+    for (int i = 0; i < 4; ++i) {
+      trailer[i] = static_cast<uint8_t>(check_ >> (24 - 8 * i));
+    }
+    trailer_size = 4;
+  } else {
+    // CRC-32 and size of the input modulo 2^32, least significant byte
+    // first.
+    const auto input_size = static_cast<uint32_t>(bytes_submitted_);
+    for (int i = 0; i < 4; ++i) {
+      trailer[i] = static_cast<uint8_t>(check_ >> (8 * i));
+      trailer[4 + i] = static_cast<uint8_t>(input_size >> (8 * i));
+    }
+    trailer_size = 8;
+  }
+  if (!WriteRaw(trailer, trailer_size)) {
+    zerror_ = Z_BUF_ERROR;
+    return false;
+  }
+  return true;
+}
+
 }  // namespace io
 }  // namespace protobuf
 }  // namespace google
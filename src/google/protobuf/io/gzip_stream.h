@@ -16,10 +16,18 @@
 //
 // GzipOutputStream is an ZeroCopyOutputStream that compresses data to
 // an underlying ZeroCopyOutputStream.
+//
+// ParallelGzipOutputStream produces the same formats as GzipOutputStream,
+// but compresses independent blocks of its input on several threads.
 
 #ifndef GOOGLE_PROTOBUF_IO_GZIP_STREAM_H__
 #define GOOGLE_PROTOBUF_IO_GZIP_STREAM_H__
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
 #include "google/protobuf/stubs/common.h"
 #include "google/protobuf/io/zero_copy_stream.h"
 #include "google/protobuf/port.h"
@@ -170,6 +178,106 @@ class PROTOBUF_EXPORT GzipOutputStream final : public ZeroCopyOutputStream {
   int Deflate(int flush);
 };
 
+// A ZeroCopyOutputStream that compresses data with zlib on several threads.
+//
+// The input is split into blocks which are compressed independently, each
+// primed with the last 32kB of the previous block so that little compression
+// is lost, and then written in order.  The result is a single GZIP or ZLIB
+// stream that any decompressor, including GzipInputStream, can read.  Each
+// block ends with a 4-byte sync marker, so the output is slightly larger than
+// GzipOutputStream's.
+class PROTOBUF_EXPORT ParallelGzipOutputStream final
+    : public ZeroCopyOutputStream {
+ public:
+  struct PROTOBUF_EXPORT Options {
+    // Defaults to GZIP.
+    GzipOutputStream::Format format;
+
+    // A number between 0 and 9, where 0 is no compression and 9 is best
+    // compression.  Defaults to Z_DEFAULT_COMPRESSION (see zlib.h).
+    int compression_level;
+
+    // Defaults to Z_DEFAULT_STRATEGY.  See GzipOutputStream::Options.
+    int compression_strategy;
+
+    // The number of bytes compressed as a unit.  Smaller blocks allow more
+    // parallelism for small outputs but compress less well.  Defaults to
+    // 128kB.
+    int block_size;
+
+    // The number of compression threads.  Defaults to 0, which uses one
+    // thread per CPU.  With 1, blocks are compressed on the calling thread.
+    int num_threads;
+
+    Options();  // Initializes with default values.
+  };
+
+  // Create a ParallelGzipOutputStream with default options.
+  explicit ParallelGzipOutputStream(ZeroCopyOutputStream* sub_stream);
+
+  // Create a ParallelGzipOutputStream with the given options.
+  ParallelGzipOutputStream(ZeroCopyOutputStream* sub_stream,
+                           const Options& options);
+  ParallelGzipOutputStream(const ParallelGzipOutputStream&) = delete;
+  ParallelGzipOutputStream& operator=(const ParallelGzipOutputStream&) =
+      delete;
+
+  ~ParallelGzipOutputStream() override;
+
+  // Return the last zlib error code, Z_BUF_ERROR if the underlying stream
+  // failed, or Z_OK if there was no error.
+  inline int ZlibErrorCode() const { return zerror_; }
+
+  // Compresses all data written so far and writes it to the underlying
+  // stream.  This ends the current block early.  It is the caller's
+  // responsibility to flush the underlying stream if necessary.
+  // Returns true if no error.
+  bool Flush();
+
+  // Writes out all data and closes the stream.
+  // It is the caller's responsibility to close the underlying stream if
+  // necessary.
+  // Returns true if no error.
+  bool Close();
+
+  // implements ZeroCopyOutputStream ---------------------------------
+  bool Next(void** data, int* size) override;
+  void BackUp(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  struct Block;
+  class Workers;
+
+  // Hands the buffered input to a worker as the next block.
+  void Submit(bool last);
+  // Writes compressed blocks to sub_stream_ in order, waiting for workers
+  // until at most `max_pending` blocks remain.  Returns false on error.
+  bool WriteBlocks(size_t max_pending);
+  bool WriteRaw(const void* data, size_t size);
+
+  ZeroCopyOutputStream* sub_stream_;
+  Options options_;
+  int zerror_ = Z_OK;
+  bool closed_ = false;
+  bool header_written_ = false;
+
+  // Null when compressing on the calling thread.
+  std::unique_ptr<Workers> workers_;
+  // Blocks submitted but not yet written, in order.
+  std::deque<std::unique_ptr<Block>> pending_;
+  size_t max_pending_;
+
+  // The buffer returned by Next(), and the number of bytes handed out.
+  std::string buffer_;
+  int used_ = 0;
+  // The last 32kB of input submitted, used as the next block's dictionary.
+  std::string window_;
+  // The CRC-32 or Adler-32 of the blocks written so far.
+  uLong check_;
+  int64_t bytes_submitted_ = 0;
+};
+
 }  // namespace io
 }  // namespace protobuf
 }  // namespace google
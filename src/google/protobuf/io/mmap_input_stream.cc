@@ -0,0 +1,157 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/io/mmap_input_stream.h"
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "absl/log/absl_check.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+namespace {
+
+size_t RoundDown(size_t value, size_t alignment) {
+  return value / alignment * alignment;
+}
+
+size_t RoundUp(size_t value, size_t alignment) {
+  return RoundDown(value + alignment - 1, alignment);
+}
+
+}  // namespace
+
+MmapInputStream::MmapInputStream(int file_descriptor)
+    : MmapInputStream(file_descriptor, Options()) {}
+
+MmapInputStream::MmapInputStream(int file_descriptor, const Options& options)
+    : page_size_(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+      chunk_size_(std::min(
+          RoundUp(static_cast<size_t>(std::max(options.chunk_size, 1)),
+                  page_size_),
+          RoundDown(INT_MAX, page_size_))),
+      prefetch_distance_(
+          static_cast<size_t>(std::max<int64_t>(options.prefetch_distance, 0))),
+      release_consumed_(options.release_consumed) {
+  struct stat info;
+  if (fstat(file_descriptor, &info) != 0) {
+    errno_ = errno;
+    return;
+  }
+  if (static_cast<uint64_t>(info.st_size) >
+      std::numeric_limits<size_t>::max()) {
+    errno_ = EFBIG;
+    return;
+  }
+  // mmap() rejects empty mappings.
+  if (info.st_size == 0) return;
+
+  const size_t size = static_cast<size_t>(info.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  if (data == MAP_FAILED) {
+    errno_ = errno;
+    return;
+  }
+  data_ = static_cast<const char*>(data);
+  size_ = size;
+#ifdef MADV_SEQUENTIAL
+  madvise(data, size_, MADV_SEQUENTIAL);
+#endif
+}
+
+MmapInputStream::~MmapInputStream() {
+  if (data_ != nullptr) munmap(const_cast<char*>(data_), size_);
+}
+
+void MmapInputStream::Advise(size_t chunk_end) {
+  // Both ranges are only passed to the kernel once they have grown by a whole
+  // chunk, to keep the number of system calls per chunk at most one each.
+#ifdef MADV_WILLNEED
+  if (prefetch_distance_ > 0) {
+    const size_t start =
+        std::max(prefetched_, RoundDown(chunk_end, page_size_));
+    const size_t distance = std::min(prefetch_distance_, size_ - chunk_end);
+    const size_t end =
+        std::min(size_, RoundUp(chunk_end + distance, page_size_));
+    if (end > start && (end - prefetched_ >= chunk_size_ || end == size_)) {
+      madvise(const_cast<char*>(data_) + start, end - start, MADV_WILLNEED);
+      prefetched_ = end;
+    }
+  }
+#endif
+#ifdef MADV_DONTNEED
+  if (release_consumed_) {
+    const size_t end = RoundDown(position_, page_size_);
+    if (end >= released_ + chunk_size_) {
+      madvise(const_cast<char*>(data_) + released_, end - released_,
+              MADV_DONTNEED);
+      released_ = end;
+    }
+  }
+#endif
+}
+
+bool MmapInputStream::Next(const void** data, int* size) {
+  if (position_ >= size_) {
+    last_returned_size_ = 0;  // Don't let caller back up.
+    return false;
+  }
+  const size_t chunk_end =
+      std::min(RoundDown(position_, chunk_size_) + chunk_size_, size_);
+  Advise(chunk_end);
+  *data = data_ + position_;
+  *size = last_returned_size_ = static_cast<int>(chunk_end - position_);
+  position_ = chunk_end;
+  return true;
+}
+
+void MmapInputStream::BackUp(int count) {
+  ABSL_CHECK_GT(last_returned_size_, 0)
+      << "BackUp() can only be called after a successful Next().";
+  ABSL_CHECK_LE(count, last_returned_size_);
+  ABSL_CHECK_GE(count, 0);
+  position_ -= static_cast<size_t>(count);
+  last_returned_size_ = 0;  // Don't let caller back up further.
+}
+
+bool MmapInputStream::Skip(int count) {
+  ABSL_CHECK_GE(count, 0);
+  last_returned_size_ = 0;  // Don't let caller back up.
+  if (static_cast<size_t>(count) > size_ - position_) {
+    position_ = size_;
+    return false;
+  }
+  position_ += static_cast<size_t>(count);
+  return true;
+}
+
+int64_t MmapInputStream::ByteCount() const {
+  return static_cast<int64_t>(position_);
+}
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // !_WIN32
@@ -0,0 +1,104 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// This file contains a ZeroCopyInputStream which maps a file into memory.
+// Unlike mapping the file by hand and wrapping it in an ArrayInputStream, the
+// stream hands out the file in page-aligned chunks, tells the kernel which
+// part of the file will be read next, and drops the pages it has already
+// read, so that reading a file much larger than memory keeps a bounded
+// resident set.
+//
+// This stream is only available on POSIX systems.
+
+#ifndef GOOGLE_PROTOBUF_IO_MMAP_INPUT_STREAM_H__
+#define GOOGLE_PROTOBUF_IO_MMAP_INPUT_STREAM_H__
+
+#ifndef _WIN32
+
+#include <cstddef>
+#include <cstdint>
+
+#include "google/protobuf/io/zero_copy_stream.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace io {
+
+// A ZeroCopyInputStream which reads a file through a read-only memory mapping.
+//
+// The whole file is mapped, and is read from its start regardless of the
+// file descriptor's position.  The file must not be truncated while the
+// stream exists.
+class PROTOBUF_EXPORT MmapInputStream final : public ZeroCopyInputStream {
+ public:
+  struct Options {
+    // The maximum size of the buffers returned by Next().  Rounded up to a
+    // multiple of the page size.  Chunks start at multiples of this size.
+    int chunk_size = 1 << 20;
+    // How far ahead of the last chunk returned by Next() the kernel is asked
+    // to read the file in, with madvise(MADV_WILLNEED).  Zero disables
+    // prefetching.
+    int64_t prefetch_distance = int64_t{8} << 20;
+    // Whether pages before the current position are released with
+    // madvise(MADV_DONTNEED).  Reading them again after BackUp() is still
+    // allowed; they are simply faulted in again from the file.
+    bool release_consumed = true;
+  };
+
+  // Maps the file.  If that fails, GetErrno() returns the error and Next()
+  // returns false.  Does not take ownership of the file descriptor, which may
+  // be closed once the stream has been constructed.
+  explicit MmapInputStream(int file_descriptor);
+  MmapInputStream(int file_descriptor, const Options& options);
+  MmapInputStream(const MmapInputStream&) = delete;
+  MmapInputStream& operator=(const MmapInputStream&) = delete;
+  ~MmapInputStream() override;
+
+  // If mapping the file failed, this is the errno from that error.
+  // Otherwise, this is zero.
+  int GetErrno() const { return errno_; }
+
+  // implements ZeroCopyInputStream ----------------------------------
+  bool Next(const void** data, int* size) override;
+  void BackUp(int count) override;
+  bool Skip(int count) override;
+  int64_t ByteCount() const override;
+
+ private:
+  // Issues madvise() calls for the chunk ending at `chunk_end`.
+  void Advise(size_t chunk_end);
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  int errno_ = 0;
+
+  size_t page_size_;
+  size_t chunk_size_;
+  size_t prefetch_distance_;
+  bool release_consumed_;
+
+  size_t position_ = 0;
+  // The size of the buffer returned by the last call to Next(), for BackUp().
+  int last_returned_size_ = 0;
+  // The end of the range passed to MADV_WILLNEED, and the start of the range
+  // not yet passed to MADV_DONTNEED.
+  size_t prefetched_ = 0;
+  size_t released_ = 0;
+};
+
+}  // namespace io
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // !_WIN32
+
+#endif  // GOOGLE_PROTOBUF_IO_MMAP_INPUT_STREAM_H__
@@ -67,6 +67,8 @@
 
 #include "google/protobuf/io/tokenizer.h"
 
+#include <utility>
+
 #include "google/protobuf/stubs/common.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
@@ -94,10 +96,10 @@ namespace {
 // Note:  No class is allowed to contain '\0', since this is used to mark end-
 //   of-input and is handled specially.
 
-#define CHARACTER_CLASS(NAME, EXPRESSION)                     \
-  class NAME {                                                \
-   public:                                                    \
-    static inline bool InClass(char c) { return EXPRESSION; } \
+#define CHARACTER_CLASS(NAME, EXPRESSION)                        \
+  class NAME {                                                   \
+   public:                                                       \
+    static constexpr bool InClass(char c) { return EXPRESSION; } \
   }
 
 CHARACTER_CLASS(Whitespace, c == ' ' || c == '\n' || c == '\t' || c == '\r' ||
@@ -123,6 +125,11 @@ CHARACTER_CLASS(Escape, c == 'a' || c == 'b' || c == 'f' || c == 'n' ||
                             c == 'r' || c == 't' || c == 'v' || c == '\\' ||
                             c == '?' || c == '\'' || c == '\"');
 
+// Characters inside a string literal that need no special handling, whatever
+// the delimiter is.
+CHARACTER_CLASS(PlainStringChar, c != '\0' && c != '\n' && c != '\\' &&
+                                     c != '\"' && c != '\'');
+
 #undef CHARACTER_CLASS
 
 // Given a char, interpret it as a numeric digit and return its value.
@@ -355,8 +362,39 @@ inline bool Tokenizer::TryConsume(char c) {
 
 template <typename CharacterClass>
 inline void Tokenizer::ConsumeZeroOrMore() {
+  // Rather than calling NextChar() for every character, consume the whole run
+  // that is left in the current buffer at once and only go through Refresh()
+  // when the run reaches the end of the buffer.  current_char_ is always
+  // buffer_[buffer_pos_] while it is in the class, since '\0' never is.
   while (CharacterClass::InClass(current_char_)) {
-    NextChar();
+    int pos = buffer_pos_;
+    if constexpr (!CharacterClass::InClass('\n') &&
+                  !CharacterClass::InClass('\t')) {
+      // Every character is one column wide.
+      const int start = pos;
+      do {
+        ++pos;
+      } while (pos < buffer_size_ && CharacterClass::InClass(buffer_[pos]));
+      column_ += pos - start;
+    } else {
+      do {
+        if (buffer_[pos] == '\n') {
+          ++line_;
+          column_ = 0;
+        } else if (buffer_[pos] == '\t') {
+          column_ += kTabWidth - column_ % kTabWidth;
+        } else {
+          ++column_;
+        }
+        ++pos;
+      } while (pos < buffer_size_ && CharacterClass::InClass(buffer_[pos]));
+    }
+    buffer_pos_ = pos;
+    if (pos < buffer_size_) {
+      current_char_ = buffer_[pos];
+      return;
+    }
+    Refresh();
   }
 }
 
@@ -365,9 +403,7 @@ inline void Tokenizer::ConsumeOneOrMore(const char* error) {
   if (!CharacterClass::InClass(current_char_)) {
     AddError(error);
   } else {
-    do {
-      NextChar();
-    } while (CharacterClass::InClass(current_char_));
+    ConsumeZeroOrMore<CharacterClass>();
   }
 }
 
@@ -433,7 +469,12 @@ void Tokenizer::ConsumeString(char delimiter) {
           NextChar();
           return;
         }
-        NextChar();
+        if (LookingAt<PlainStringChar>()) {
+          ConsumeZeroOrMore<PlainStringChar>();
+        } else {
+          // The other kind of quote.
+          NextChar();
+        }
         break;
       }
     }
@@ -607,7 +648,9 @@ bool Tokenizer::TryConsumeNewline() {
 // -------------------------------------------------------------------
 
 bool Tokenizer::Next() {
-  previous_ = current_;
+  // Every field of current_ is reset below, so swapping rather than copying
+  // lets the text buffers be reused instead of copied for every token.
+  std::swap(previous_, current_);
 
   while (!read_error_) {
     StartToken();
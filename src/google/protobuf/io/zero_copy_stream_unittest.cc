@@ -54,8 +54,10 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "google/protobuf/io/async_file_stream.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/io_win32.h"
+#include "google/protobuf/io/mmap_input_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "google/protobuf/port.h"
 #include "google/protobuf/test_util2.h"
@@ -690,6 +692,80 @@ TEST_F(IoTest, GzipInputByteCountAfterClosedConcatenatedStreams) {
     EXPECT_EQ(total_size, gz_input.ByteCount());
   }
 }
+
+TEST_F(IoTest, ParallelGzipIo) {
+  for (GzipOutputStream::Format format :
+       {GzipOutputStream::GZIP, GzipOutputStream::ZLIB}) {
+    for (int num_threads : {1, 4}) {
+      for (int block_size : {1, 1000, 128 * 1024}) {
+        for (int i = 0; i < kBlockSizeCount; i++) {
+          std::string compressed;
+          {
+            StringOutputStream output(&compressed);
+            ParallelGzipOutputStream::Options options;
+            options.format = format;
+            options.num_threads = num_threads;
+            options.block_size = block_size;
+            ParallelGzipOutputStream gzout(&output, options);
+            WriteStuffLarge(&gzout);
+            EXPECT_TRUE(gzout.Close());
+            EXPECT_EQ(Z_OK, gzout.ZlibErrorCode());
+          }
+          {
+            ArrayInputStream input(compressed.data(), compressed.size(),
+                                   kBlockSizes[i]);
+            GzipInputStream gzin(&input, format == GzipOutputStream::ZLIB
+                                             ? GzipInputStream::ZLIB
+                                             : GzipInputStream::GZIP);
+            ReadStuffLarge(&gzin);
+            // The trailer checksum was verified.
+            EXPECT_EQ(Z_STREAM_END, gzin.ZlibErrorCode());
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(IoTest, ParallelGzipIoWithFlush) {
+  std::string compressed;
+  StringOutputStream output(&compressed);
+  ParallelGzipOutputStream::Options options;
+  options.num_threads = 4;
+  ParallelGzipOutputStream gzout(&output, options);
+  WriteString(&gzout, "Hello world!\n");
+  EXPECT_TRUE(gzout.Flush());
+
+  // Everything written so far can be decompressed.
+  {
+    ArrayInputStream input(compressed.data(), compressed.size());
+    GzipInputStream gzin(&input);
+    ReadString(&gzin, "Hello world!\n");
+  }
+
+  WriteString(&gzout, "Goodbye.");
+  EXPECT_TRUE(gzout.Close());
+  ArrayInputStream input(compressed.data(), compressed.size());
+  GzipInputStream gzin(&input);
+  ReadString(&gzin, "Hello world!\nGoodbye.");
+  uint8_t byte;
+  EXPECT_EQ(ReadFromInput(&gzin, &byte, 1), 0);
+  EXPECT_EQ(Z_STREAM_END, gzin.ZlibErrorCode());
+}
+
+TEST_F(IoTest, ParallelGzipEmpty) {
+  std::string compressed;
+  {
+    StringOutputStream output(&compressed);
+    ParallelGzipOutputStream gzout(&output);
+    EXPECT_TRUE(gzout.Close());
+  }
+  ArrayInputStream input(compressed.data(), compressed.size());
+  GzipInputStream gzin(&input);
+  uint8_t byte;
+  EXPECT_EQ(ReadFromInput(&gzin, &byte, 1), 0);
+  EXPECT_EQ(Z_STREAM_END, gzin.ZlibErrorCode());
+}
 #endif
 
 // There is no string input, only string output.  Also, it doesn't support
@@ -1497,6 +1573,161 @@ TEST_F(IoTest, BlockingFileIoWithTimeout) {
     EXPECT_EQ(EAGAIN, input.GetErrno());
   }
 }
+
+TEST_F(IoTest, AsyncFileIo) {
+  std::string filename =
+      absl::StrCat(::testing::TempDir(), "/zero_copy_stream_test_file");
+
+  for (int num_blocks : {1, 2, 4}) {
+    for (bool direct_io : {false, true}) {
+      int file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0777);
+      ASSERT_GE(file, 0);
+
+      {
+        AsyncFileOutputStream::Options options;
+        options.block_size = 4096;
+        options.num_blocks = num_blocks;
+        AsyncFileOutputStream output(file, options);
+        WriteStuffLarge(&output);
+        EXPECT_TRUE(output.Flush());
+        EXPECT_EQ(0, output.GetErrno());
+      }
+
+      ASSERT_NE(lseek(file, 0, SEEK_SET), (off_t)-1);
+
+      {
+        // Direct I/O is not supported by every file system, in which case the
+        // stream falls back to ordinary reads.
+        AsyncFileInputStream::Options options;
+        options.block_size = 4096;
+        options.num_blocks = num_blocks;
+        options.direct_io = direct_io;
+        AsyncFileInputStream input(file, options);
+        ReadStuffLarge(&input);
+        EXPECT_EQ(0, input.GetErrno());
+      }
+
+      close(file);
+    }
+  }
+}
+
+TEST_F(IoTest, AsyncPipeIo) {
+  int files[2];
+  ASSERT_EQ(pipe(files), 0);
+
+  std::thread write_thread([this, &files] {
+    {
+      AsyncFileOutputStream output(files[1]);
+      WriteStuff(&output);
+      EXPECT_TRUE(output.Flush());
+      EXPECT_EQ(0, output.GetErrno());
+    }
+    close(files[1]);
+  });
+
+  {
+    AsyncFileInputStream input(files[0]);
+    ReadStuff(&input);
+    EXPECT_EQ(0, input.GetErrno());
+  }
+  write_thread.join();
+  close(files[0]);
+}
+
+TEST_F(IoTest, AsyncFileReadError) {
+  // -1 = invalid file descriptor.
+  AsyncFileInputStream input(-1);
+
+  const void* buffer;
+  int size;
+  EXPECT_FALSE(input.Next(&buffer, &size));
+  EXPECT_EQ(EBADF, input.GetErrno());
+}
+
+TEST_F(IoTest, AsyncFileWriteError) {
+  // -1 = invalid file descriptor.
+  AsyncFileOutputStream output(-1);
+
+  void* buffer;
+  int size;
+
+  // The first call to Next() succeeds because nothing has been written yet.
+  ASSERT_TRUE(output.Next(&buffer, &size));
+  memset(buffer, 0, size);
+
+  EXPECT_FALSE(output.Flush());
+  EXPECT_EQ(EBADF, output.GetErrno());
+  EXPECT_FALSE(output.Next(&buffer, &size));
+}
+
+TEST_F(IoTest, MmapIo) {
+  std::string filename =
+      absl::StrCat(::testing::TempDir(), "/zero_copy_stream_test_file");
+
+  int file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0777);
+  ASSERT_GE(file, 0);
+  {
+    FileOutputStream output(file);
+    WriteStuffLarge(&output);
+    EXPECT_TRUE(output.Flush());
+  }
+
+  const long page_size = sysconf(_SC_PAGESIZE);
+  for (int chunk_size : {1, 5000, 1 << 20}) {
+    for (int64_t prefetch_distance : {0, 10000, 1 << 20}) {
+      for (bool release_consumed : {false, true}) {
+        MmapInputStream::Options options;
+        options.chunk_size = chunk_size;
+        options.prefetch_distance = prefetch_distance;
+        options.release_consumed = release_consumed;
+        {
+          MmapInputStream input(file, options);
+          ReadStuffLarge(&input);
+          EXPECT_EQ(0, input.GetErrno());
+        }
+        {
+          // Every chunk but the last ends on a page boundary.
+          MmapInputStream input(file, options);
+          const void* data;
+          int size;
+          while (input.Next(&data, &size)) {
+            if (input.ByteCount() < 200055) {
+              EXPECT_EQ(input.ByteCount() % page_size, 0);
+            }
+          }
+          EXPECT_EQ(input.ByteCount(), 200055);
+        }
+      }
+    }
+  }
+
+  close(file);
+}
+
+TEST_F(IoTest, MmapEmptyFile) {
+  std::string filename =
+      absl::StrCat(::testing::TempDir(), "/zero_copy_stream_test_file");
+  int file = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0777);
+  ASSERT_GE(file, 0);
+
+  MmapInputStream input(file);
+  close(file);
+  const void* data;
+  int size;
+  EXPECT_FALSE(input.Next(&data, &size));
+  EXPECT_EQ(0, input.GetErrno());
+}
+
+TEST_F(IoTest, MmapReadError) {
+  // -1 = invalid file descriptor.
+  MmapInputStream input(-1);
+
+  const void* buffer;
+  int size;
+  EXPECT_FALSE(input.Next(&buffer, &size));
+  EXPECT_EQ(EBADF, input.GetErrno());
+}
 #endif
 
 #if HAVE_ZLIB
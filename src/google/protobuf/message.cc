@@ -143,6 +143,21 @@ std::string Message::InitializationErrorString() const {
   return absl::StrJoin(errors, ", ");
 }
 
+void Message::MergeFromShared(const Message& from) {
+  Arena* arena = GetArena();
+  if (arena == nullptr || arena != from.GetArena()) {
+    MergeFrom(from);
+  } else {
+    ReflectionOps::MergeShared(from, this);
+  }
+}
+
+void Message::CopyFromShared(const Message& from) {
+  if (&from == this) return;
+  Clear();
+  MergeFromShared(from);
+}
+
 void Message::CheckInitialized() const {
   ABSL_CHECK(IsInitialized())
       << "Message of type \"" << GetDescriptor()->full_name()
@@ -292,6 +292,18 @@ class PROTOBUF_EXPORT Message : public MessageLite {
   // exact same class).
   void MergeFrom(const Message& from);
 
+  // Like CopyFrom() and MergeFrom(), but singular string and bytes fields of
+  // `from` and of its submessages are shared instead of copied.  A shared
+  // value is copied on its first mutation through this message, so this
+  // message can be modified freely.  This makes copying a large message of
+  // which only a few fields are changed afterwards much cheaper.
+  //
+  // Values are only shared if both messages are on the same arena, otherwise
+  // these are equivalent to CopyFrom() and MergeFrom().  `from` must not be
+  // modified while any of its values are still shared.
+  void CopyFromShared(const Message& from);
+  void MergeFromShared(const Message& from);
+
   // Verifies that IsInitialized() returns true.  ABSL_CHECK-fails otherwise,
   // with a nice error message.
   void CheckInitialized() const;
@@ -1299,6 +1311,12 @@ class PROTOBUF_EXPORT Reflection final {
     return schema_.IsFieldMicroString(field);
   }
 
+  // Makes the singular string `field` of `to` share the value of the same
+  // field in `from` instead of copying it, see ArenaStringPtr::InitShared().
+  // Returns false without changing `to` if the field can't be shared.
+  bool ShareString(const Message& from, Message* to,
+                   const FieldDescriptor* field) const;
+
   // For implicit-presence (including repeated) fields, returns true if the
   // field is populated, i.e., nonzero/nonempty. False otherwise.
   bool IsImplicitPresenceFieldNonEmpty(const Message& message,
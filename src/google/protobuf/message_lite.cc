@@ -335,6 +335,8 @@ bool MessageLite::MergeFromImpl(io::CodedInputStream* input,
   ctx.TrackCorrectEnding();
   ctx.data().pool = input->GetExtensionPool();
   ctx.data().factory = input->GetExtensionFactory();
+  ctx.data().keep_unknown_fields_as_wire_bytes =
+      input->KeepsUnknownFieldsAsWireBytes();
   ptr = internal::TcParser::ParseLoop(this, ptr, &ctx, GetTcParseTable());
   if (ABSL_PREDICT_FALSE(!ptr)) return false;
   ctx.BackUp(ptr);
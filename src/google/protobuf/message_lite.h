@@ -22,6 +22,7 @@
 #ifndef GOOGLE_PROTOBUF_MESSAGE_LITE_H__
 #define GOOGLE_PROTOBUF_MESSAGE_LITE_H__
 
+#include <atomic>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
@@ -250,6 +251,30 @@ class PROTOBUF_EXPORT CachedSize {
 #endif
 };
 
+class ExtensionTable;
+
+// The ExtensionTable of a type, built lazily and stored in its ClassData.
+//
+// Like CachedSize, ExtensionTableCache is copy-constructible so that ClassData
+// can be constant initialized from a copy.  A copy starts out empty.
+class PROTOBUF_EXPORT ExtensionTableCache {
+ public:
+  constexpr ExtensionTableCache() noexcept : table_(nullptr) {}
+  constexpr ExtensionTableCache(const ExtensionTableCache&) noexcept
+      : table_(nullptr) {}
+  ExtensionTableCache& operator=(const ExtensionTableCache&) = delete;
+
+  const ExtensionTable* Get() const noexcept {
+    return table_.load(std::memory_order_acquire);
+  }
+  void Set(const ExtensionTable* table) const noexcept {
+    table_.store(table, std::memory_order_release);
+  }
+
+ private:
+  mutable std::atomic<const ExtensionTable*> table_;
+};
+
 struct ClassData;
 
 // Returns the ClassData for the given message.
@@ -390,6 +415,9 @@ struct PROTOBUF_EXPORT ClassData {
   // char[] just beyond the ClassData.
   bool is_lite;
   bool is_dynamic = false;
+  // The extensions registered for this type.  Built on the first extension
+  // lookup; see extension_set.cc.
+  ExtensionTableCache extension_table;
 
   // In normal mode we have the small constructor to avoid the cost in
   // codegen.
@@ -61,10 +61,10 @@ class LazyField;
 PROTOBUF_EXPORT void WriteVarint(uint32_t num, uint64_t val, std::string* s);
 PROTOBUF_EXPORT void WriteLengthDelimited(uint32_t num, absl::string_view val,
                                           std::string* s);
-// Inline because it is just forwarding to s->WriteVarint
-inline void WriteVarint(uint32_t num, uint64_t val, UnknownFieldSet* unknown);
-inline void WriteLengthDelimited(uint32_t num, absl::string_view val,
+PROTOBUF_EXPORT void WriteVarint(uint32_t num, uint64_t val,
                                  UnknownFieldSet* unknown);
+PROTOBUF_EXPORT void WriteLengthDelimited(uint32_t num, absl::string_view val,
+                                          UnknownFieldSet* unknown);
 
 
 // The basic abstraction the parser is designed for is a slight modification
@@ -559,6 +559,8 @@ class PROTOBUF_EXPORT ParseContext : public EpsCopyInputStream {
   struct Data {
     const DescriptorPool* pool = nullptr;
     MessageFactory* factory = nullptr;
+    // See io::CodedInputStream::SetKeepUnknownFieldsAsWireBytes().
+    bool keep_unknown_fields_as_wire_bytes = false;
   };
 
   template <typename... T>
@@ -50,6 +50,14 @@ void ReflectionOps::Copy(const Message& from, Message* to) {
 }
 
 void ReflectionOps::Merge(const Message& from, Message* to) {
+  MergeImpl(from, to, /*share=*/false);
+}
+
+void ReflectionOps::MergeShared(const Message& from, Message* to) {
+  MergeImpl(from, to, /*share=*/true);
+}
+
+void ReflectionOps::MergeImpl(const Message& from, Message* to, bool share) {
   ABSL_CHECK_NE(&from, to);
 
   const Descriptor* descriptor = from.GetDescriptor();
@@ -106,13 +114,16 @@ void ReflectionOps::Merge(const Message& from, Message* to) {
           case FieldDescriptor::CPPTYPE_MESSAGE:
             const Message& from_child =
                 from_reflection->GetRepeatedMessage(from, field, j);
-            if (from_reflection == to_reflection) {
-              to_reflection
-                  ->AddMessage(to, field,
-                               from_child.GetReflection()->GetMessageFactory())
-                  ->MergeFrom(from_child);
+            Message* to_child =
+                from_reflection == to_reflection
+                    ? to_reflection->AddMessage(
+                          to, field,
+                          from_child.GetReflection()->GetMessageFactory())
+                    : to_reflection->AddMessage(to, field);
+            if (share) {
+              MergeImpl(from_child, to_child, share);
             } else {
-              to_reflection->AddMessage(to, field)->MergeFrom(from_child);
+              to_child->MergeFrom(from_child);
             }
             break;
         }
@@ -132,21 +143,31 @@ void ReflectionOps::Merge(const Message& from, Message* to) {
         HANDLE_TYPE(FLOAT, Float);
         HANDLE_TYPE(DOUBLE, Double);
         HANDLE_TYPE(BOOL, Bool);
-        HANDLE_TYPE(STRING, String);
         HANDLE_TYPE(ENUM, Enum);
 #undef HANDLE_TYPE
 
-        case FieldDescriptor::CPPTYPE_MESSAGE:
+        case FieldDescriptor::CPPTYPE_STRING:
+          if (!share || !to_reflection->ShareString(from, to, field)) {
+            to_reflection->SetString(to, field,
+                                     from_reflection->GetString(from, field));
+          }
+          break;
+
+        case FieldDescriptor::CPPTYPE_MESSAGE: {
           const Message& from_child = from_reflection->GetMessage(from, field);
-          if (from_reflection == to_reflection) {
-            to_reflection
-                ->MutableMessage(
-                    to, field, from_child.GetReflection()->GetMessageFactory())
-                ->MergeFrom(from_child);
+          Message* to_child =
+              from_reflection == to_reflection
+                  ? to_reflection->MutableMessage(
+                        to, field,
+                        from_child.GetReflection()->GetMessageFactory())
+                  : to_reflection->MutableMessage(to, field);
+          if (share) {
+            MergeImpl(from_child, to_child, share);
           } else {
-            to_reflection->MutableMessage(to, field)->MergeFrom(from_child);
+            to_child->MergeFrom(from_child);
           }
           break;
+        }
       }
     }
   }
@@ -44,6 +44,9 @@ class PROTOBUF_EXPORT ReflectionOps {
 
   static void Copy(const Message& from, Message* to);
   static void Merge(const Message& from, Message* to);
+  // Like Merge(), but shares singular string fields of `from` and of its
+  // submessages where possible.  See Message::MergeFromShared().
+  static void MergeShared(const Message& from, Message* to);
   static void Clear(Message* message);
   static bool IsInitialized(const Message& message);
   static bool IsInitialized(const Message& message, bool check_fields,
@@ -56,6 +59,9 @@ class PROTOBUF_EXPORT ReflectionOps {
   static void FindInitializationErrors(const Message& message,
                                        const std::string& prefix,
                                        std::vector<std::string>* errors);
+
+ private:
+  static void MergeImpl(const Message& from, Message* to, bool share);
 };
 
 }  // namespace internal
@@ -19,6 +19,7 @@
 
 #include <gtest/gtest.h>
 #include "absl/strings/str_join.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/generated_message_util.h"
 #include "google/protobuf/test_util.h"
@@ -182,6 +183,64 @@ TEST(ReflectionOpsTest, MergeFromSelf) {
 
 #endif  // GTEST_HAS_DEATH_TEST
 
+TEST(ReflectionOpsTest, CopyFromShared) {
+  Arena arena;
+  auto* base = Arena::Create<unittest::TestAllTypes>(&arena);
+  TestUtil::SetAllFields(base);
+
+  auto* copy = Arena::Create<unittest::TestAllTypes>(&arena);
+  copy->CopyFromShared(*base);
+  TestUtil::ExpectAllFieldsSet(*copy);
+  EXPECT_EQ(&copy->optional_string(), &base->optional_string());
+  EXPECT_EQ(&copy->optional_bytes(), &base->optional_bytes());
+
+  // Mutations copy the shared value first.
+  copy->set_optional_string("changed");
+  copy->mutable_optional_bytes()->append("!");
+  EXPECT_EQ(copy->optional_string(), "changed");
+  EXPECT_EQ(copy->optional_bytes(), base->optional_bytes() + "!");
+  EXPECT_NE(&copy->optional_bytes(), &base->optional_bytes());
+
+  copy->Clear();
+  TestUtil::ExpectAllFieldsSet(*base);
+}
+
+TEST(ReflectionOpsTest, MergeFromSharedSubmessages) {
+  Arena arena;
+  auto* base = Arena::Create<unittest::NestedTestAllTypes>(&arena);
+  base->mutable_child()->mutable_payload()->set_optional_string("child");
+  base->add_repeated_child()->mutable_payload()->set_optional_string("first");
+  base->add_repeated_child()->mutable_payload()->set_optional_string("second");
+
+  auto* copy = Arena::Create<unittest::NestedTestAllTypes>(&arena);
+  copy->add_repeated_child()->mutable_payload()->set_optional_string("zero");
+  copy->MergeFromShared(*base);
+  ASSERT_EQ(copy->repeated_child_size(), 3);
+  EXPECT_EQ(copy->repeated_child(0).payload().optional_string(), "zero");
+  EXPECT_EQ(&copy->child().payload().optional_string(),
+            &base->child().payload().optional_string());
+  EXPECT_EQ(&copy->repeated_child(2).payload().optional_string(),
+            &base->repeated_child(1).payload().optional_string());
+
+  copy->mutable_repeated_child(1)
+      ->mutable_payload()
+      ->mutable_optional_string()
+      ->append("!");
+  EXPECT_EQ(copy->repeated_child(1).payload().optional_string(), "first!");
+  EXPECT_EQ(base->repeated_child(0).payload().optional_string(), "first");
+}
+
+TEST(ReflectionOpsTest, CopyFromSharedWithoutArena) {
+  unittest::TestAllTypes base;
+  TestUtil::SetAllFields(&base);
+
+  // Without a common arena the values are copied.
+  unittest::TestAllTypes copy;
+  copy.CopyFromShared(base);
+  TestUtil::ExpectAllFieldsSet(copy);
+  EXPECT_NE(&copy.optional_string(), &base.optional_string());
+}
+
 TEST(ReflectionOpsTest, Clear) {
   unittest::TestAllTypes message;
 
@@ -228,6 +228,14 @@ class PROTOBUF_EXPORT SourceContext final : public ::google::protobuf::Message
   ::std::string* PROTOBUF_NONNULL _internal_mutable_file_name();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.file_name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &SourceContext::clear_file_name>(
+          msg, "file_name", msg.file_name(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.SourceContext)
  private:
   class _Internal;
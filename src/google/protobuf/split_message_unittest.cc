@@ -0,0 +1,223 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+//
+// Tests split messages, using TestSplit from unittest_split.proto, which is
+// generated with --cpp_opt=split_map_file=unittest_split_map.txt.  TestSplit
+// has fields with the names and numbers of TestAllTypes, so its contents are
+// checked by converting it to a TestAllTypes.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "google/protobuf/arena.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/unittest_split.pb.h"
+#include "google/protobuf/util/message_differencer.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::proto2_unittest::TestAllTypes;
+using ::proto2_unittest_split::TestSplit;
+
+// Returns a TestAllTypes with all the fields that TestSplit also has set.
+TestAllTypes AllSplitFields() {
+  TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  const Reflection* reflection = message.GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(message, &fields);
+  for (const FieldDescriptor* field : fields) {
+    if (TestSplit::descriptor()->FindFieldByNumber(field->number()) ==
+        nullptr) {
+      reflection->ClearField(&message, field);
+    }
+  }
+  return message;
+}
+
+void SetAllSplitFields(TestSplit* message) {
+  ASSERT_TRUE(message->ParseFromString(AllSplitFields().SerializeAsString()));
+  EXPECT_TRUE(message->unknown_fields().empty());
+}
+
+void ExpectAllSplitFieldsSet(const TestSplit& message) {
+  TestAllTypes converted;
+  ASSERT_TRUE(converted.ParseFromString(message.SerializeAsString()));
+  EXPECT_TRUE(util::MessageDifferencer::Equals(converted, AllSplitFields()))
+      << converted.DebugString();
+  EXPECT_EQ(message.ByteSizeLong(), converted.ByteSizeLong());
+}
+
+void ExpectClear(const TestSplit& message) {
+  EXPECT_EQ(message.ByteSizeLong(), 0);
+  EXPECT_FALSE(message.has_optional_int64());
+  EXPECT_FALSE(message.has_optional_foreign_message());
+  EXPECT_EQ(message.repeated_int32_size(), 0);
+  EXPECT_EQ(message.repeatedgroup_size(), 0);
+  EXPECT_EQ(message.default_int32(), 41);
+  EXPECT_EQ(message.default_string(), "hello");
+}
+
+TEST(SplitMessageTest, FieldsInSplitMap) {
+  // The split struct is shared with the default instance until a split field
+  // is set.
+  TestSplit message;
+  EXPECT_TRUE(message.optional_string().empty());
+  EXPECT_EQ(message.default_int32(), 41);
+  EXPECT_EQ(message.default_string(), "hello");
+  EXPECT_EQ(message.repeated_int32_size(), 0);
+
+  message.set_optional_int32(1);
+  EXPECT_EQ(message.default_int32(), 41);
+  message.set_default_int32(2);
+  message.add_repeated_string("a");
+  EXPECT_EQ(message.optional_int32(), 1);
+  EXPECT_EQ(message.default_int32(), 2);
+  EXPECT_EQ(message.repeated_string(0), "a");
+
+  message.Clear();
+  EXPECT_FALSE(message.has_default_int32());
+  EXPECT_EQ(message.default_int32(), 41);
+  EXPECT_EQ(message.repeated_string_size(), 0);
+}
+
+TEST(SplitMessageTest, ParseAndSerialize) {
+  TestSplit message;
+  ExpectClear(message);
+  SetAllSplitFields(&message);
+  ExpectAllSplitFieldsSet(message);
+  EXPECT_EQ(message.optional_int64(), 102);
+  EXPECT_EQ(message.optional_foreign_message().c(), 119);
+  ASSERT_EQ(message.repeated_int32_size(), 2);
+  EXPECT_EQ(message.repeated_int32(1), 301);
+  EXPECT_EQ(message.oneof_bytes(), "604");
+
+  // Parsing again replaces the split fields instead of appending to them.
+  SetAllSplitFields(&message);
+  ExpectAllSplitFieldsSet(message);
+
+  message.Clear();
+  ExpectClear(message);
+}
+
+TEST(SplitMessageTest, Arena) {
+  Arena arena;
+  auto* message = Arena::Create<TestSplit>(&arena);
+  SetAllSplitFields(message);
+  ExpectAllSplitFieldsSet(*message);
+  message->Clear();
+  ExpectClear(*message);
+}
+
+TEST(SplitMessageTest, CopyAndMove) {
+  TestSplit message;
+  SetAllSplitFields(&message);
+
+  TestSplit copy(message);
+  ExpectAllSplitFieldsSet(copy);
+  TestSplit assigned;
+  assigned.set_optional_int64(1);
+  assigned = message;
+  ExpectAllSplitFieldsSet(assigned);
+
+  Arena arena;
+  auto* arena_copy = Arena::Create<TestSplit>(&arena, message);
+  ExpectAllSplitFieldsSet(*arena_copy);
+  TestSplit heap_copy(*arena_copy);
+  ExpectAllSplitFieldsSet(heap_copy);
+
+  TestSplit moved(std::move(copy));
+  ExpectAllSplitFieldsSet(moved);
+  ExpectAllSplitFieldsSet(message);
+}
+
+TEST(SplitMessageTest, Merge) {
+  TestSplit message;
+  SetAllSplitFields(&message);
+  TestSplit merged;
+  merged.MergeFrom(TestSplit::default_instance());
+  ExpectClear(merged);
+  merged.MergeFrom(message);
+  ExpectAllSplitFieldsSet(merged);
+  merged.MergeFrom(message);
+
+  TestAllTypes expected = AllSplitFields();
+  expected.MergeFrom(AllSplitFields());
+  TestAllTypes converted;
+  ASSERT_TRUE(converted.ParseFromString(merged.SerializeAsString()));
+  EXPECT_TRUE(util::MessageDifferencer::Equals(converted, expected))
+      << converted.DebugString();
+}
+
+TEST(SplitMessageTest, Swap) {
+  TestSplit message1;
+  TestSplit message2;
+  SetAllSplitFields(&message1);
+  message1.Swap(&message2);
+  ExpectClear(message1);
+  ExpectAllSplitFieldsSet(message2);
+
+  // Swapping with a message on another arena copies.
+  Arena arena;
+  auto* arena_message = Arena::Create<TestSplit>(&arena);
+  arena_message->Swap(&message2);
+  ExpectAllSplitFieldsSet(*arena_message);
+  ExpectClear(message2);
+}
+
+TEST(SplitMessageTest, Reflection) {
+  TestSplit message;
+  SetAllSplitFields(&message);
+
+  // Copying between a generated and a dynamic message goes through
+  // reflection on both sides.
+  DynamicMessageFactory factory;
+  std::unique_ptr<Message> dynamic(
+      factory.GetPrototype(TestSplit::descriptor())->New());
+  dynamic->CopyFrom(message);
+  TestSplit copy;
+  copy.CopyFrom(*dynamic);
+  ExpectAllSplitFieldsSet(copy);
+
+  const Reflection* reflection = copy.GetReflection();
+  std::vector<const FieldDescriptor*> fields;
+  reflection->ListFields(copy, &fields);
+  for (const FieldDescriptor* field : fields) {
+    reflection->ClearField(&copy, field);
+  }
+  ExpectClear(copy);
+}
+
+TEST(SplitMessageTest, MapNextToSplitFields) {
+  TestSplit message;
+  SetAllSplitFields(&message);
+  (*message.mutable_map_int32_string())[1] = "one";
+
+  TestSplit copy;
+  ASSERT_TRUE(copy.ParseFromString(message.SerializeAsString()));
+  EXPECT_EQ(copy.map_int32_string().at(1), "one");
+  copy.clear_map_int32_string();
+  ExpectAllSplitFieldsSet(copy);
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
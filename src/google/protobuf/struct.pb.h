@@ -288,6 +288,14 @@ class PROTOBUF_EXPORT ListValue final : public ::google::protobuf::Message
   const ::google::protobuf::Value& values(int index) const;
   ::google::protobuf::Value* PROTOBUF_NONNULL add_values();
   const ::google::protobuf::RepeatedPtrField<::google::protobuf::Value>& values() const;
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.values_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &ListValue::clear_values>(
+          msg, "values", msg.values(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.ListValue)
  private:
   class _Internal;
@@ -486,6 +494,14 @@ class PROTOBUF_EXPORT Struct final : public ::google::protobuf::Message
   ::google::protobuf::Map<::std::string, ::google::protobuf::Value>* PROTOBUF_NONNULL _internal_mutable_fields();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.fields_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated | ::google::protobuf::internal::kVisitMap, &Struct::clear_fields>(
+          msg, "fields", msg.fields(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Struct)
  private:
   class _Internal;
@@ -816,6 +832,39 @@ class PROTOBUF_EXPORT Value final : public ::google::protobuf::Message
   public:
   void clear_kind();
   KindCase kind_case() const;
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (msg.has_null_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_null_value>(
+          msg, "null_value", msg.null_value(), visitor);
+    }
+    if (msg.has_number_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_number_value>(
+          msg, "number_value", msg.number_value(), visitor);
+    }
+    if (msg.has_string_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_string_value>(
+          msg, "string_value", msg.string_value(), visitor);
+    }
+    if (msg.has_bool_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_bool_value>(
+          msg, "bool_value", msg.bool_value(), visitor);
+    }
+    if (msg.has_struct_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_struct_value>(
+          msg, "struct_value", msg.struct_value(), visitor);
+    }
+    if (msg.has_list_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitOneof, &Value::clear_list_value>(
+          msg, "list_value", msg.list_value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Value)
  private:
   class _Internal;
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <random>
@@ -343,6 +344,7 @@ class TextFormat::Parser::ParserImpl {
   // false if an error occurs (an error will also be logged to
   // ABSL_LOG(ERROR)).
   bool Parse(Message* output) {
+    const FieldDescriptor* last_field = nullptr;
     // Consume fields until we cannot do so anymore.
     while (true) {
       if (LookingAtType(io::Tokenizer::TYPE_END)) {
@@ -358,7 +360,7 @@ class TextFormat::Parser::ParserImpl {
         return !had_errors_;
       }
 
-      DO(ConsumeField(output));
+      DO(ConsumeField(output, &last_field));
     }
   }
 
@@ -430,8 +432,9 @@ class TextFormat::Parser::ParserImpl {
   // This method checks to see that the end delimiter at the conclusion of
   // the consumption matches the starting delimiter passed in here.
   bool ConsumeMessage(Message* message, const std::string& delimiter) {
+    const FieldDescriptor* last_field = nullptr;
     while (!LookingAt(">") && !LookingAt("}")) {
-      DO(ConsumeField(message));
+      DO(ConsumeField(message, &last_field));
     }
 
     // Confirm that we have a valid ending delimiter.
@@ -450,9 +453,29 @@ class TextFormat::Parser::ParserImpl {
     return true;
   }
 
+  // Looks up a non-extension field by name.  Text format written by a program
+  // usually lists fields in declaration order and repeated fields next to each
+  // other, so the field named after `last_field` is tried first: either
+  // `last_field` itself or the one declared right after it.  This only costs
+  // a string comparison, instead of a hash table lookup.
+  static const FieldDescriptor* FindFieldByName(
+      const Descriptor* descriptor, absl::string_view name,
+      const FieldDescriptor* last_field) {
+    if (last_field != nullptr) {
+      if (last_field->name() == name) return last_field;
+      int next = last_field->index() + 1;
+      if (next < descriptor->field_count() &&
+          descriptor->field(next)->name() == name) {
+        return descriptor->field(next);
+      }
+    }
+    return descriptor->FindFieldByName(name);
+  }
+
   // Consumes the current field (as returned by the tokenizer) on the
-  // passed in message.
-  bool ConsumeField(Message* message) {
+  // passed in message.  `last_field` holds the previous regular field parsed
+  // in the same message, if any, and is updated.
+  bool ConsumeField(Message* message, const FieldDescriptor** last_field) {
     const Reflection* reflection = message->GetReflection();
     const Descriptor* descriptor = message->GetDescriptor();
 
@@ -564,7 +587,7 @@ class TextFormat::Parser::ParserImpl {
           field = descriptor->FindFieldByNumber(field_number);
         }
       } else {
-        field = descriptor->FindFieldByName(field_name);
+        field = FindFieldByName(descriptor, field_name, *last_field);
         // Group-like delimited fields will accept both the capitalized type
         // names as well.
         if (field == nullptr) {
@@ -624,6 +647,8 @@ class TextFormat::Parser::ParserImpl {
       return skip_parsing(SkipFieldMessage());
     }
 
+    if (!field->is_extension()) *last_field = field;
+
     if (field->options().deprecated()) {
       ReportWarning(absl::StrCat("text format contains deprecated field \"",
                                  field_name, "\""));
@@ -2155,6 +2180,8 @@ TextFormat::Printer::Printer()
       print_message_fields_in_index_order_(false),
       expand_any_(false),
       truncate_string_field_longer_than_(0LL),
+      builtin_default_printer_(false),
+      utf8_string_escaping_(false),
       finder_(nullptr) {
   SetUseUtf8StringEscaping(false);
 }
@@ -2162,17 +2189,21 @@ TextFormat::Printer::Printer()
 void TextFormat::Printer::SetUseUtf8StringEscaping(bool as_utf8) {
   SetDefaultFieldValuePrinter(as_utf8 ? new FastFieldValuePrinterUtf8Escaping()
                                       : new DebugStringFieldValuePrinter());
+  builtin_default_printer_ = true;
+  utf8_string_escaping_ = as_utf8;
 }
 
 void TextFormat::Printer::SetDefaultFieldValuePrinter(
     const FieldValuePrinter* printer) {
   default_field_value_printer_ =
       std::make_unique<FieldValuePrinterWrapper>(printer);
+  builtin_default_printer_ = false;
 }
 
 void TextFormat::Printer::SetDefaultFieldValuePrinter(
     const FastFieldValuePrinter* printer) {
   default_field_value_printer_.reset(printer);
+  builtin_default_printer_ = false;
 }
 
 bool TextFormat::Printer::RegisterFieldValuePrinter(
@@ -2692,10 +2723,86 @@ void TextFormat::Printer::PrintFieldName(const Message& message,
   }
 
   const FastFieldValuePrinter* printer = GetFieldPrinter(field);
+  if (builtin_default_printer_ &&
+      printer == default_field_value_printer_.get()) {
+    // None of the built-in printers override this, so skip the virtual call.
+    printer->FastFieldValuePrinter::PrintFieldName(message, reflection, field,
+                                                   generator);
+    return;
+  }
   printer->PrintFieldName(message, field_index, field_count, reflection, field,
                           generator);
 }
 
+namespace {
+
+// Prints `src` escaped exactly like absl::CEscape(), but without building the
+// escaped copy.  The output is collected in a small buffer, so that bytes
+// fields, where most characters need escaping, are still printed in chunks.
+void PrintCEscaped(absl::string_view src,
+                   TextFormat::BaseTextGenerator* generator) {
+  char buffer[256];
+  size_t buffer_size = 0;
+  const auto flush = [&] {
+    if (buffer_size > 0) generator->Print(buffer, buffer_size);
+    buffer_size = 0;
+  };
+  const auto append = [&](const char* data, size_t size) {
+    if (size == 0) return;
+    if (buffer_size + size > sizeof(buffer)) {
+      flush();
+      if (size > sizeof(buffer)) {
+        generator->Print(data, size);
+        return;
+      }
+    }
+    memcpy(buffer + buffer_size, data, size);
+    buffer_size += size;
+  };
+
+  size_t run_start = 0;
+  for (size_t i = 0; i < src.size(); ++i) {
+    unsigned char c = src[i];
+    char octal[4];
+    absl::string_view escape;
+    switch (c) {
+      case '\n':
+        escape = "\\n";
+        break;
+      case '\r':
+        escape = "\\r";
+        break;
+      case '\t':
+        escape = "\\t";
+        break;
+      case '\"':
+        escape = "\\\"";
+        break;
+      case '\'':
+        escape = "\\'";
+        break;
+      case '\\':
+        escape = "\\\\";
+        break;
+      default:
+        if (absl::ascii_isprint(c)) continue;
+        octal[0] = '\\';
+        octal[1] = '0' + (c >> 6);
+        octal[2] = '0' + ((c >> 3) & 7);
+        octal[3] = '0' + (c & 7);
+        escape = absl::string_view(octal, sizeof(octal));
+        break;
+    }
+    append(src.data() + run_start, i - run_start);
+    append(escape.data(), escape.size());
+    run_start = i + 1;
+  }
+  append(src.data() + run_start, src.size() - run_start);
+  flush();
+}
+
+}  // namespace
+
 void TextFormat::Printer::PrintFieldValue(const Message& message,
                                           const Reflection* reflection,
                                           const FieldDescriptor* field,
@@ -2710,6 +2817,12 @@ void TextFormat::Printer::PrintFieldValue(const Message& message,
     return;
   }
 
+  // The output of the built-in printers is reproduced here for the types
+  // where they would build a temporary string, that is integers, strings and
+  // enums, so these are printed without it.
+  const bool builtin_printer = builtin_default_printer_ &&
+                               printer == default_field_value_printer_.get();
+
   switch (field->cpp_type()) {
 #define OUTPUT_FIELD(CPPTYPE, METHOD)                                \
   case FieldDescriptor::CPPTYPE_##CPPTYPE:                           \
@@ -2720,15 +2833,31 @@ void TextFormat::Printer::PrintFieldValue(const Message& message,
         generator);                                                  \
     break
 
-    OUTPUT_FIELD(INT32, Int32);
-    OUTPUT_FIELD(INT64, Int64);
-    OUTPUT_FIELD(UINT32, UInt32);
-    OUTPUT_FIELD(UINT64, UInt64);
     OUTPUT_FIELD(FLOAT, Float);
     OUTPUT_FIELD(DOUBLE, Double);
     OUTPUT_FIELD(BOOL, Bool);
 #undef OUTPUT_FIELD
 
+#define OUTPUT_INTEGER_FIELD(CPPTYPE, METHOD)                          \
+  case FieldDescriptor::CPPTYPE_##CPPTYPE: {                           \
+    auto value = field->is_repeated()                                  \
+                     ? reflection->GetRepeated##METHOD(message, field, \
+                                                       index)          \
+                     : reflection->Get##METHOD(message, field);        \
+    if (builtin_printer) {                                             \
+      generator->PrintString(absl::AlphaNum(value).Piece());           \
+    } else {                                                           \
+      printer->Print##METHOD(value, generator);                        \
+    }                                                                  \
+    break;                                                             \
+  }
+
+    OUTPUT_INTEGER_FIELD(INT32, Int32);
+    OUTPUT_INTEGER_FIELD(INT64, Int64);
+    OUTPUT_INTEGER_FIELD(UINT32, UInt32);
+    OUTPUT_INTEGER_FIELD(UINT64, UInt64);
+#undef OUTPUT_INTEGER_FIELD
+
     case FieldDescriptor::CPPTYPE_STRING: {
       std::string scratch;
       const std::string& value =
@@ -2745,7 +2874,16 @@ void TextFormat::Printer::PrintFieldValue(const Message& message,
                           "...<truncated>...";
         value_to_print = &truncated_value;
       }
-      if (field->type() == FieldDescriptor::TYPE_STRING) {
+      if (builtin_printer) {
+        if (utf8_string_escaping_ &&
+            field->type() == FieldDescriptor::TYPE_STRING) {
+          HardenedPrintString(*value_to_print, generator);
+        } else {
+          generator->PrintLiteral("\"");
+          PrintCEscaped(*value_to_print, generator);
+          generator->PrintLiteral("\"");
+        }
+      } else if (field->type() == FieldDescriptor::TYPE_STRING) {
         printer->PrintString(*value_to_print, generator);
       } else {
         ABSL_DCHECK_EQ(field->type(), FieldDescriptor::TYPE_BYTES);
@@ -2762,8 +2900,13 @@ void TextFormat::Printer::PrintFieldValue(const Message& message,
       const EnumValueDescriptor* enum_desc =
           field->enum_type()->FindValueByNumber(enum_value);
       if (enum_desc != nullptr) {
-        printer->PrintEnum(enum_value, internal::NameOfEnumAsString(enum_desc),
-                           generator);
+        if (builtin_printer) {
+          generator->PrintString(internal::NameOfEnumAsString(enum_desc));
+        } else {
+          printer->PrintEnum(enum_value,
+                             internal::NameOfEnumAsString(enum_desc),
+                             generator);
+        }
       } else {
         // Ordinarily, enum_desc should not be null, because proto2 has the
         // invariant that set enum field values must be in-range, but with the
@@ -2771,7 +2914,11 @@ void TextFormat::Printer::PrintFieldValue(const Message& message,
         // it is possible for the user to force an unknown integer value.  So we
         // simply use the integer value itself as the enum value name in this
         // case.
-        printer->PrintEnum(enum_value, absl::StrCat(enum_value), generator);
+        if (builtin_printer) {
+          generator->PrintString(absl::AlphaNum(enum_value).Piece());
+        } else {
+          printer->PrintEnum(enum_value, absl::StrCat(enum_value), generator);
+        }
       }
       break;
     }
@@ -527,6 +527,7 @@ class PROTOBUF_EXPORT TextFormat {
 
     const FastFieldValuePrinter* GetFieldPrinter(
         const FieldDescriptor* field) const {
+      if (custom_printers_.empty()) return default_field_value_printer_.get();
       auto it = custom_printers_.find(field);
       return it == custom_printers_.end() ? default_field_value_printer_.get()
                                           : it->second.get();
@@ -550,6 +551,12 @@ class PROTOBUF_EXPORT TextFormat {
     int64_t truncate_string_field_longer_than_;
 
     std::unique_ptr<const FastFieldValuePrinter> default_field_value_printer_;
+    // True while default_field_value_printer_ is one of the built-in printers
+    // installed by SetUseUtf8StringEscaping(), whose output
+    // PrintFieldValue() reproduces.
+    bool builtin_default_printer_;
+    // Whether that built-in printer escapes strings as UTF-8.
+    bool utf8_string_escaping_;
     absl::flat_hash_map<const FieldDescriptor*,
                         std::unique_ptr<const FastFieldValuePrinter>>
         custom_printers_;
@@ -35,6 +35,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "google/protobuf/descriptor.h"
 #include "google/protobuf/io/tokenizer.h"
@@ -651,6 +652,92 @@ TEST_F(TextFormatTest, DefaultCustomFieldPrinter) {
   EXPECT_EQ("optional_uint32: 42u\nrepeated_uint32: [1u, 2u, 3u]\n", text);
 }
 
+TEST_F(TextFormatTest, BuiltinPrinterMatchesFieldValuePrinter) {
+  // With the built-in printers, field values are formatted directly instead
+  // of through FastFieldValuePrinter; the output must not change.
+  TestUtil::SetAllFields(&proto_);
+  proto_.set_optional_string("esc\"aped\n\t\\ \x01\x7f\xc3\xa9 'quote'");
+  proto_.set_optional_bytes(std::string("\0\xff\x80 bytes", 10));
+  // Long values are printed in several chunks.
+  std::string binary(1000, '\0');
+  for (size_t i = 0; i < binary.size(); ++i) binary[i] = static_cast<char>(i);
+  proto_.add_repeated_bytes(binary);
+  proto_.add_repeated_bytes(std::string(1000, 'x') + "\n");
+  proto_.add_repeated_int64(std::numeric_limits<int64_t>::min());
+  proto_.add_repeated_uint64(std::numeric_limits<uint64_t>::max());
+  proto_.add_repeated_double(std::numeric_limits<double>::quiet_NaN());
+  proto_.GetReflection()->AddEnumValue(
+      &proto_,
+      unittest::TestAllTypes::descriptor()->FindFieldByName(
+          "repeated_nested_enum"),
+      12345);
+
+  for (int truncate : {0, 12}) {
+    for (bool single_line : {false, true}) {
+      TextFormat::Printer builtin;
+      builtin.SetSingleLineMode(single_line);
+      builtin.SetTruncateStringFieldLongerThan(truncate);
+
+      // Any printer installed by the user takes the virtual path.
+      TextFormat::Printer generic;
+      generic.SetSingleLineMode(single_line);
+      generic.SetTruncateStringFieldLongerThan(truncate);
+      generic.SetDefaultFieldValuePrinter(
+          new TextFormat::FastFieldValuePrinter());
+
+      std::string expected, actual;
+      ASSERT_TRUE(generic.PrintToString(proto_, &expected));
+      ASSERT_TRUE(builtin.PrintToString(proto_, &actual));
+      EXPECT_EQ(expected, actual);
+    }
+  }
+}
+
+// Escapes strings like SetUseUtf8StringEscaping(true) does for valid UTF-8.
+class Utf8EscapingFieldValuePrinter : public TextFormat::FastFieldValuePrinter {
+ public:
+  void PrintString(const std::string& val,
+                   TextFormat::BaseTextGenerator* generator) const override {
+    generator->PrintString(
+        absl::StrCat("\"", absl::Utf8SafeCEscape(val), "\""));
+  }
+  void PrintBytes(const std::string& val,
+                  TextFormat::BaseTextGenerator* generator) const override {
+    FastFieldValuePrinter::PrintString(val, generator);
+  }
+};
+
+TEST_F(TextFormatTest, BuiltinPrinterMatchesUtf8EscapingPrinter) {
+  TestUtil::SetAllFields(&proto_);
+  proto_.set_optional_string(
+      "esc\"aped\n\t\\ \x01\x7f\xc3\xa9 \xe2\x82\xac 'quote'");
+  proto_.set_optional_bytes(std::string("\0\xff\xc3\xa9 bytes", 11));
+
+  for (bool single_line : {false, true}) {
+    TextFormat::Printer builtin;
+    builtin.SetSingleLineMode(single_line);
+    builtin.SetUseUtf8StringEscaping(true);
+
+    TextFormat::Printer generic;
+    generic.SetSingleLineMode(single_line);
+    generic.SetDefaultFieldValuePrinter(new Utf8EscapingFieldValuePrinter());
+
+    std::string expected, actual;
+    ASSERT_TRUE(generic.PrintToString(proto_, &expected));
+    ASSERT_TRUE(builtin.PrintToString(proto_, &actual));
+    EXPECT_EQ(expected, actual);
+  }
+
+  // Invalid UTF-8 is escaped byte by byte.
+  unittest::TestAllTypes message;
+  message.set_optional_string("\xc3(\xe9");
+  TextFormat::Printer printer;
+  printer.SetUseUtf8StringEscaping(true);
+  std::string text;
+  ASSERT_TRUE(printer.PrintToString(message, &text));
+  EXPECT_EQ(text, "optional_string: \"\\303(\\351\"\n");
+}
+
 class CustomInt32FieldValuePrinter : public TextFormat::FieldValuePrinter {
  public:
   std::string PrintInt32(int32_t val) const override {
@@ -2244,6 +2331,44 @@ TEST_F(TextFormatParserTest, MessageDelimiters) {
                 "Expected identifier, got: ", 4, 1);
 }
 
+TEST_F(TextFormatParserTest, AnyFieldOrder) {
+  // The parser guesses the next field from the previous one; make sure a
+  // wrong guess falls back to a full lookup.
+  unittest::TestAllTypes expected;
+  expected.set_optional_int32(1);
+  expected.set_optional_int64(2);
+  expected.set_optional_uint32(3);
+  expected.add_repeated_int32(4);
+  expected.add_repeated_int32(5);
+  expected.mutable_optional_nested_message()->set_bb(6);
+  expected.add_repeated_nested_message()->set_bb(7);
+  expected.add_repeated_nested_message()->set_bb(8);
+
+  for (absl::string_view input : {
+           // Declaration order.
+           "optional_int32: 1 optional_int64: 2 optional_uint32: 3 "
+           "optional_nested_message { bb: 6 } "
+           "repeated_int32: 4 repeated_int32: 5 "
+           "repeated_nested_message { bb: 7 } "
+           "repeated_nested_message { bb: 8 }",
+           // Reverse order, with repeated fields interleaved.
+           "repeated_nested_message { bb: 7 } repeated_int32: 4 "
+           "repeated_nested_message { bb: 8 } repeated_int32: 5 "
+           "optional_nested_message { bb: 6 } optional_uint32: 3 "
+           "optional_int64: 2 optional_int32: 1",
+           // Skipping fields.
+           "optional_int32: 1 optional_uint32: 3 optional_int64: 2 "
+           "repeated_int32: 4 optional_nested_message { bb: 6 } "
+           "repeated_int32: 5 repeated_nested_message { bb: 7 } "
+           "repeated_nested_message { bb: 8 }",
+       }) {
+    SCOPED_TRACE(input);
+    unittest::TestAllTypes message;
+    ASSERT_TRUE(TextFormat::ParseFromString(input, &message));
+    EXPECT_EQ(expected.SerializeAsString(), message.SerializeAsString());
+  }
+}
+
 TEST_F(TextFormatParserTest, UnknownExtension) {
   // Non-matching delimiters.
   ExpectFailure("[blahblah]: 123",
@@ -234,6 +234,19 @@ class PROTOBUF_EXPORT Timestamp final : public ::google::protobuf::Message
   void _internal_set_nanos(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.seconds())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT64,
+                                 ::google::protobuf::internal::kVisitSingular, &Timestamp::clear_seconds>(
+          msg, "seconds", msg.seconds(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.nanos())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Timestamp::clear_nanos>(
+          msg, "nanos", msg.nanos(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Timestamp)
  private:
   class _Internal;
@@ -407,6 +407,19 @@ class PROTOBUF_EXPORT Option final : public ::google::protobuf::Message
   ::google::protobuf::Any* PROTOBUF_NONNULL _internal_mutable_value();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Option::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.has_value()) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &Option::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Option)
  private:
   class _Internal;
@@ -786,6 +799,59 @@ class PROTOBUF_EXPORT Field final : public ::google::protobuf::Message
   void _internal_set_packed(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.kind())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_kind>(
+          msg, "kind", msg.kind(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.cardinality())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_cardinality>(
+          msg, "cardinality", msg.cardinality(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.number())) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_number>(
+          msg, "number", msg.number(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.type_url())) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_type_url>(
+          msg, "type_url", msg.type_url(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.oneof_index())) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_oneof_index>(
+          msg, "oneof_index", msg.oneof_index(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.packed())) {
+      ::google::protobuf::internal::VisitGeneratedField<8, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_packed>(
+          msg, "packed", msg.packed(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<9, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Field::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.json_name())) {
+      ::google::protobuf::internal::VisitGeneratedField<10, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_json_name>(
+          msg, "json_name", msg.json_name(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.default_value())) {
+      ::google::protobuf::internal::VisitGeneratedField<11, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Field::clear_default_value>(
+          msg, "default_value", msg.default_value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Field)
  private:
   class _Internal;
@@ -1022,6 +1088,24 @@ class PROTOBUF_EXPORT EnumValue final : public ::google::protobuf::Message
   void _internal_set_number(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValue::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.number())) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &EnumValue::clear_number>(
+          msg, "number", msg.number(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &EnumValue::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.EnumValue)
  private:
   class _Internal;
@@ -1327,6 +1411,44 @@ class PROTOBUF_EXPORT Type final : public ::google::protobuf::Message
   void _internal_set_syntax(::google::protobuf::Syntax value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Type::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.fields_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Type::clear_fields>(
+          msg, "fields", msg.fields(), visitor);
+    }
+    if (msg.oneofs_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitRepeated, &Type::clear_oneofs>(
+          msg, "oneofs", msg.oneofs(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Type::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.has_source_context()) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &Type::clear_source_context>(
+          msg, "source_context", msg.source_context(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.syntax())) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Type::clear_syntax>(
+          msg, "syntax", msg.syntax(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.edition())) {
+      ::google::protobuf::internal::VisitGeneratedField<7, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Type::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Type)
  private:
   class _Internal;
@@ -1612,6 +1734,39 @@ class PROTOBUF_EXPORT Enum final : public ::google::protobuf::Message
   void _internal_set_syntax(::google::protobuf::Syntax value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.name())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Enum::clear_name>(
+          msg, "name", msg.name(), visitor);
+    }
+    if (msg.enumvalue_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<2, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Enum::clear_enumvalue>(
+          msg, "enumvalue", msg.enumvalue(), visitor);
+    }
+    if (msg.options_size() > 0) {
+      ::google::protobuf::internal::VisitGeneratedField<3, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitRepeated, &Enum::clear_options>(
+          msg, "options", msg.options(), visitor);
+    }
+    if (msg.has_source_context()) {
+      ::google::protobuf::internal::VisitGeneratedField<4, ::google::protobuf::internal::WireFormatLite::TYPE_MESSAGE,
+                                 ::google::protobuf::internal::kVisitSingular, &Enum::clear_source_context>(
+          msg, "source_context", msg.source_context(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.syntax())) {
+      ::google::protobuf::internal::VisitGeneratedField<5, ::google::protobuf::internal::WireFormatLite::TYPE_ENUM,
+                                 ::google::protobuf::internal::kVisitSingular, &Enum::clear_syntax>(
+          msg, "syntax", msg.syntax(), visitor);
+    }
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.edition())) {
+      ::google::protobuf::internal::VisitGeneratedField<6, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &Enum::clear_edition>(
+          msg, "edition", msg.edition(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Enum)
  private:
   class _Internal;
@@ -11,6 +11,7 @@
 
 #include "google/protobuf/unknown_field_set.h"
 
+#include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <string>
@@ -37,25 +38,90 @@ namespace protobuf {
 
 void UnknownFieldSet::ClearFallback() {
   auto& fields = this->fields();
-  ABSL_DCHECK(!fields.empty());
-  if (arena() == nullptr) {
-    int n = fields.size();
-    do {
-      fields[--n].Delete();
-    } while (n > 0);
+  if (!fields.empty()) {
+    if (arena() == nullptr) {
+      int n = fields.size();
+      do {
+        fields[--n].Delete();
+      } while (n > 0);
+    }
+    fields.Clear();
+  }
+  if (v2_data_ != nullptr) {
+    v2_data_->clear();
+    ResetDecodedV2Data();
   }
-  fields.Clear();
+}
+
+namespace {
+
+UnknownFieldSet* DecodeWireBytes(absl::string_view data, Arena* arena) {
+  UnknownFieldSet* decoded = Arena::Create<UnknownFieldSet>(arena);
+  const char* ptr;
+  internal::ParseContext ctx(io::CodedInputStream::GetDefaultRecursionLimit(),
+                             false, &ptr, data);
+  // The bytes were checked when they were parsed, unless that parse failed
+  // part way, in which case we keep whatever can be decoded.
+  ptr = internal::UnknownGroupParse(decoded, ptr, &ctx);
+  ABSL_DLOG_IF(WARNING, ptr == nullptr || !ctx.EndedAtLimit())
+      << "Failed to decode unknown fields.";
+  return decoded;
+}
+
+}  // namespace
+
+const UnknownFieldSet* UnknownFieldSet::DecodeV2Data() const {
+  // Only the arena is needed from the non-const accessor.
+  Arena* arena = const_cast<UnknownFieldSet*>(this)->arena();
+  UnknownFieldSet* decoded = DecodeWireBytes(V2Data(), arena);
+  UnknownFieldSet* expected = nullptr;
+  if (!decoded_v2_data_.compare_exchange_strong(expected, decoded,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+    // Another thread got there first.
+    if (arena == nullptr) delete decoded;
+    return expected;
+  }
+  return decoded;
+}
+
+void UnknownFieldSet::MaterializeV2DataSlow() {
+  UnknownFieldSet* decoded =
+      decoded_v2_data_.exchange(nullptr, std::memory_order_relaxed);
+  if (decoded == nullptr) decoded = DecodeWireBytes(V2Data(), arena());
+  v2_data_->clear();
+
+  auto& fields = this->fields();
+  auto& decoded_fields = decoded->fields();
+  if (fields.empty()) {
+    fields.Swap(&decoded_fields);
+  } else {
+    fields.MergeFrom(decoded_fields);
+    decoded_fields.Clear();
+  }
+  if (arena() == nullptr) delete decoded;
+}
+
+void UnknownFieldSet::ResetDecodedV2Data() {
+  UnknownFieldSet* decoded =
+      decoded_v2_data_.exchange(nullptr, std::memory_order_relaxed);
+  if (decoded != nullptr && arena() == nullptr) delete decoded;
 }
 
 void UnknownFieldSet::MergeFrom(const UnknownFieldSet& other) {
-  int other_field_count = other.field_count();
-  if (other_field_count > 0) {
+  if (!other.fields().empty()) {
+    // The fields of `other` go after any wire bytes we already have.
+    MaterializeV2Data();
     auto& fields = this->fields();
-    fields.Reserve(fields.size() + other_field_count);
+    fields.Reserve(fields.size() + other.fields().size());
     for (auto elem : other.fields()) {
       fields.Add(elem.DeepCopy(arena()));
     }
   }
+  if (!other.V2Data().empty()) {
+    const absl::string_view data = other.V2Data();
+    MutableV2Data()->append(data.data(), data.size());
+  }
 }
 
 // A specialized MergeFrom for performance when we are merging from an UFS that
@@ -66,13 +132,26 @@ void UnknownFieldSet::MergeFromAndDestroy(UnknownFieldSet* other) {
     return;
   }
 
-  auto& fields = this->fields();
   auto& other_fields = other->fields();
-  if (fields.empty()) {
-    fields.Swap(&other_fields);
-  } else {
-    fields.MergeFrom(other_fields);
-    other_fields.Clear();
+  if (!other_fields.empty()) {
+    MaterializeV2Data();
+    auto& fields = this->fields();
+    if (fields.empty()) {
+      fields.Swap(&other_fields);
+    } else {
+      fields.MergeFrom(other_fields);
+      other_fields.Clear();
+    }
+  }
+  if (!other->V2Data().empty()) {
+    std::string* data = MutableV2Data();
+    if (data->empty()) {
+      data->swap(*other->v2_data_);
+    } else {
+      data->append(*other->v2_data_);
+    }
+    other->v2_data_->clear();
+    other->ResetDecodedV2Data();
   }
 }
 
@@ -82,10 +161,20 @@ void UnknownFieldSet::MergeToInternalMetadata(
 }
 
 size_t UnknownFieldSet::SpaceUsedExcludingSelfLong() const {
+  size_t total_size = 0;
+  if (v2_data_ != nullptr) {
+    total_size += sizeof(*v2_data_) +
+                  internal::StringSpaceUsedExcludingSelfLong(*v2_data_);
+  }
+  if (const UnknownFieldSet* decoded =
+          decoded_v2_data_.load(std::memory_order_acquire)) {
+    total_size += decoded->SpaceUsedLong();
+  }
+
   auto& fields = this->fields();
-  if (fields.empty()) return 0;
+  if (fields.empty()) return total_size;
 
-  size_t total_size = fields.SpaceUsedExcludingSelfLong();
+  total_size += fields.SpaceUsedExcludingSelfLong();
 
   for (const UnknownField& field : fields) {
     switch (field.type()) {
@@ -109,6 +198,7 @@ size_t UnknownFieldSet::SpaceUsedLong() const {
 }
 
 void UnknownFieldSet::AddVarint(int number, uint64_t value) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_VARINT);
@@ -116,6 +206,7 @@ void UnknownFieldSet::AddVarint(int number, uint64_t value) {
 }
 
 void UnknownFieldSet::AddFixed32(int number, uint32_t value) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_FIXED32);
@@ -123,6 +214,7 @@ void UnknownFieldSet::AddFixed32(int number, uint32_t value) {
 }
 
 void UnknownFieldSet::AddFixed64(int number, uint64_t value) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_FIXED64);
@@ -135,6 +227,7 @@ void UnknownFieldSet::AddLengthDelimited(int number, const absl::Cord& value) {
 
 template <int&...>
 void UnknownFieldSet::AddLengthDelimited(int number, std::string&& value) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_LENGTH_DELIMITED);
@@ -144,6 +237,7 @@ void UnknownFieldSet::AddLengthDelimited(int number, std::string&& value) {
 template void UnknownFieldSet::AddLengthDelimited(int, std::string&&);
 
 std::string* UnknownFieldSet::AddLengthDelimited(int number) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_LENGTH_DELIMITED);
@@ -152,6 +246,7 @@ std::string* UnknownFieldSet::AddLengthDelimited(int number) {
 }
 
 UnknownFieldSet* UnknownFieldSet::AddGroup(int number) {
+  MaterializeV2Data();
   auto& field = *fields().Add();
   field.number_ = number;
   field.SetType(UnknownField::TYPE_GROUP);
@@ -160,10 +255,14 @@ UnknownFieldSet* UnknownFieldSet::AddGroup(int number) {
 }
 
 void UnknownFieldSet::AddField(const UnknownField& field) {
-  fields().Add(field.DeepCopy(arena()));
+  // `field` may point into our decoded wire bytes, so copy it first.
+  UnknownField copy = field.DeepCopy(arena());
+  MaterializeV2Data();
+  fields().Add(copy);
 }
 
 void UnknownFieldSet::DeleteSubrange(int start, int num) {
+  MaterializeV2Data();
   auto& fields = this->fields();
   if (arena() == nullptr) {
     // Delete the specified fields.
@@ -175,6 +274,7 @@ void UnknownFieldSet::DeleteSubrange(int start, int num) {
 }
 
 void UnknownFieldSet::DeleteByNumber(int number) {
+  MaterializeV2Data();
   auto& fields = this->fields();
   int left = 0;  // The number of fields left after deletion.
   for (int i = 0; i < fields.size(); ++i) {
@@ -327,10 +427,37 @@ class UnknownFieldParserHelper {
     unknown_->AddFixed32(num, value);
   }
 
+  // Returns the buffer new fields should be appended to as wire bytes, or
+  // nullptr if they should be added as UnknownFields.  Once a set has wire
+  // bytes, new fields always go after them.
+  static std::string* WireBytes(UnknownFieldSet* unknown, bool keep) {
+    if (unknown->V2Data().empty() && !keep) return nullptr;
+    return unknown->MutableV2Data();
+  }
+
  private:
   UnknownFieldSet* unknown_;
 };
 
+void WriteVarint(uint32_t num, uint64_t val, UnknownFieldSet* unknown) {
+  if (std::string* wire_bytes =
+          UnknownFieldParserHelper::WireBytes(unknown, /*keep=*/false)) {
+    WriteVarint(num, val, wire_bytes);
+  } else {
+    unknown->AddVarint(num, val);
+  }
+}
+
+void WriteLengthDelimited(uint32_t num, absl::string_view val,
+                          UnknownFieldSet* unknown) {
+  if (std::string* wire_bytes =
+          UnknownFieldParserHelper::WireBytes(unknown, /*keep=*/false)) {
+    WriteLengthDelimited(num, val, wire_bytes);
+  } else {
+    unknown->AddLengthDelimited(num, val);
+  }
+}
+
 const char* UnknownGroupParse(UnknownFieldSet* unknown, const char* ptr,
                               ParseContext* ctx) {
   UnknownFieldParserHelper field_parser(unknown);
@@ -339,6 +466,10 @@ const char* UnknownGroupParse(UnknownFieldSet* unknown, const char* ptr,
 
 const char* UnknownFieldParse(uint64_t tag, UnknownFieldSet* unknown,
                               const char* ptr, ParseContext* ctx) {
+  if (std::string* wire_bytes = UnknownFieldParserHelper::WireBytes(
+          unknown, ctx->data().keep_unknown_fields_as_wire_bytes)) {
+    return UnknownFieldParse(static_cast<uint32_t>(tag), wire_bytes, ptr, ctx);
+  }
   UnknownFieldParserHelper field_parser(unknown);
   return FieldParser(tag, field_parser, ptr, ctx);
 }
@@ -17,12 +17,14 @@
 
 #include <assert.h>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <type_traits>
 #include <utility>
 
+#include "absl/base/optimization.h"
 #include "absl/log/absl_check.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
@@ -272,6 +274,24 @@ class PROTOBUF_EXPORT UnknownFieldSet {
   void ClearFallback();
   void SwapSlow(UnknownFieldSet* other);
 
+  // The wire bytes in v2_data_ logically follow the fields in fields_.  Const
+  // accessors see them through a lazily decoded copy, which is published
+  // atomically because concurrent readers may race to create it.  Mutating
+  // methods, including appending more bytes, first move the decoded fields
+  // into fields_ instead.
+  const UnknownFieldSet& DecodedV2Data() const {
+    const UnknownFieldSet* decoded =
+        decoded_v2_data_.load(std::memory_order_acquire);
+    if (ABSL_PREDICT_FALSE(decoded == nullptr)) decoded = DecodeV2Data();
+    return *decoded;
+  }
+  const UnknownFieldSet* DecodeV2Data() const;
+  void MaterializeV2Data() {
+    if (ABSL_PREDICT_FALSE(!V2Data().empty())) MaterializeV2DataSlow();
+  }
+  void MaterializeV2DataSlow();
+  void ResetDecodedV2Data();
+
   template <typename MessageType,
             typename std::enable_if_t<
                 std::is_base_of<Message, MessageType>::value, int> = 0>
@@ -301,10 +321,17 @@ class PROTOBUF_EXPORT UnknownFieldSet {
     if (!v2_data_) {
       v2_data_ = Arena::Create<std::string>(arena());
     }
+    if (decoded_v2_data_.load(std::memory_order_relaxed) != nullptr) {
+      // Keep what has already been decoded rather than dropping it (which
+      // leaks it on an arena) and decoding every byte again, so that reading
+      // between appends stays linear in the total size.
+      MaterializeV2DataSlow();
+    }
     return v2_data_;
   }
 
   std::string* v2_data_ = nullptr;
+  mutable std::atomic<UnknownFieldSet*> decoded_v2_data_{nullptr};
 #ifdef PROTOBUF_INTERNAL_REMOVE_ARENA_PTRS_REPEATED_FIELD
   internal::RepeatedFieldWithArena<UnknownField> fields_;
 #else
@@ -314,13 +341,12 @@ class PROTOBUF_EXPORT UnknownFieldSet {
 
 namespace internal {
 
-inline void WriteVarint(uint32_t num, uint64_t val, UnknownFieldSet* unknown) {
-  unknown->AddVarint(num, val);
-}
-inline void WriteLengthDelimited(uint32_t num, absl::string_view val,
-                                 UnknownFieldSet* unknown) {
-  unknown->AddLengthDelimited(num, val);
-}
+// These append to the wire bytes of `unknown` if it has any, and add an
+// UnknownField otherwise.
+PROTOBUF_EXPORT void WriteVarint(uint32_t num, uint64_t val,
+                                 UnknownFieldSet* unknown);
+PROTOBUF_EXPORT void WriteLengthDelimited(uint32_t num, absl::string_view val,
+                                          UnknownFieldSet* unknown);
 
 PROTOBUF_EXPORT
 const char* UnknownGroupParse(UnknownFieldSet* unknown, const char* ptr,
@@ -351,17 +377,24 @@ inline const UnknownFieldSet& UnknownFieldSet::default_instance() {
 inline void UnknownFieldSet::ClearAndFreeMemory() { Clear(); }
 
 inline void UnknownFieldSet::Clear() {
-  if (!fields().empty()) {
+  if (!fields().empty() || v2_data_ != nullptr) {
     ClearFallback();
   }
-  if (v2_data_ != nullptr) v2_data_->clear();
 }
 
-inline bool UnknownFieldSet::empty() const { return fields().empty(); }
+inline bool UnknownFieldSet::empty() const {
+  return fields().empty() && V2Data().empty();
+}
 
 inline void UnknownFieldSet::Swap(UnknownFieldSet* x) {
   if (arena() == x->arena()) {
     fields().Swap(&x->fields());
+    std::swap(v2_data_, x->v2_data_);
+    UnknownFieldSet* decoded =
+        decoded_v2_data_.load(std::memory_order_relaxed);
+    decoded_v2_data_.store(x->decoded_v2_data_.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    x->decoded_v2_data_.store(decoded, std::memory_order_relaxed);
   } else {
     // We might need to do a deep copy, so use Merge instead
     SwapSlow(x);
@@ -369,12 +402,21 @@ inline void UnknownFieldSet::Swap(UnknownFieldSet* x) {
 }
 
 inline int UnknownFieldSet::field_count() const {
-  return static_cast<int>(fields().size());
+  int count = static_cast<int>(fields().size());
+  if (ABSL_PREDICT_FALSE(!V2Data().empty())) {
+    count += DecodedV2Data().field_count();
+  }
+  return count;
 }
 inline const UnknownField& UnknownFieldSet::field(int index) const {
+  const int size = static_cast<int>(fields().size());
+  if (ABSL_PREDICT_FALSE(index >= size)) {
+    return DecodedV2Data().field(index - size);
+  }
   return (fields())[static_cast<size_t>(index)];
 }
 inline UnknownField* UnknownFieldSet::mutable_field(int index) {
+  MaterializeV2Data();
   return &(fields())[static_cast<size_t>(index)];
 }
 
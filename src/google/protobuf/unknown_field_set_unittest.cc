@@ -47,6 +47,12 @@ struct UnknownFieldSetTestPeer {
   static auto AddLengthDelimited(UnknownFieldSet& set, int number) {
     return set.AddLengthDelimited(number);
   }
+  static absl::string_view WireBytes(const UnknownFieldSet& set) {
+    return set.V2Data();
+  }
+  static bool IsDecoded(const UnknownFieldSet& set) {
+    return set.decoded_v2_data_.load() != nullptr;
+  }
 };
 }  // namespace internal
 
@@ -879,6 +885,147 @@ TEST(UnknownFieldTest, SettersOverrideTheDataProperly) {
   EXPECT_EQ(message.optional_string(), "5555");
 }
 
+class UnknownFieldSetWireBytesTest : public UnknownFieldSetTest {
+ protected:
+  void SetUp() override {
+    UnknownFieldSetTest::SetUp();
+    empty_message_.Clear();
+    ASSERT_TRUE(MergeKeepingWireBytes(all_fields_data_, &empty_message_));
+    unknown_fields_ = empty_message_.mutable_unknown_fields();
+  }
+
+  static bool MergeKeepingWireBytes(const std::string& data,
+                                    Message* message) {
+    io::CodedInputStream input(
+        reinterpret_cast<const uint8_t*>(data.data()),
+        static_cast<int>(data.size()));
+    input.SetKeepUnknownFieldsAsWireBytes(true);
+    return message->MergeFromCodedStream(&input) &&
+           input.ConsumedEntireMessage();
+  }
+
+  using Peer = internal::UnknownFieldSetTestPeer;
+};
+
+TEST_F(UnknownFieldSetWireBytesTest, RoundTripWithoutDecoding) {
+  const UnknownFieldSet& unknown_fields = empty_message_.unknown_fields();
+  EXPECT_FALSE(unknown_fields.empty());
+  EXPECT_TRUE(Peer::WireBytes(unknown_fields) == all_fields_data_);
+
+  std::string data;
+  ASSERT_TRUE(empty_message_.SerializeToString(&data));
+  EXPECT_TRUE(data == all_fields_data_);
+  EXPECT_EQ(empty_message_.ByteSizeLong(), all_fields_data_.size());
+  EXPECT_FALSE(Peer::IsDecoded(unknown_fields));
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, DecodesOnAccess) {
+  unittest::TestEmptyMessage decoded_message;
+  ASSERT_TRUE(decoded_message.ParseFromString(all_fields_data_));
+  const UnknownFieldSet& expected = decoded_message.unknown_fields();
+  EXPECT_TRUE(Peer::WireBytes(expected).empty());
+
+  const UnknownFieldSet& unknown_fields = empty_message_.unknown_fields();
+  ASSERT_EQ(unknown_fields.field_count(), expected.field_count());
+  EXPECT_TRUE(Peer::IsDecoded(unknown_fields));
+  EXPECT_EQ(empty_message_.DebugString(), decoded_message.DebugString());
+  ASSERT_NE(GetField("optional_int32"), nullptr);
+  EXPECT_EQ(GetField("optional_int32")->varint(), all_fields_.optional_int32());
+  ASSERT_NE(GetField("optionalgroup"), nullptr);
+  EXPECT_EQ(GetField("optionalgroup")->group().field(0).varint(),
+            all_fields_.optionalgroup().a());
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, MutationDecodes) {
+  const int field_count = unknown_fields_->field_count();
+  unknown_fields_->AddVarint(123456, 654321);
+  EXPECT_TRUE(Peer::WireBytes(*unknown_fields_).empty());
+  EXPECT_FALSE(Peer::IsDecoded(*unknown_fields_));
+  ASSERT_EQ(unknown_fields_->field_count(), field_count + 1);
+  EXPECT_EQ(unknown_fields_->field(field_count).number(), 123456);
+
+  // Parsing more data appends it after the decoded fields.
+  ASSERT_TRUE(MergeKeepingWireBytes(all_fields_data_, &empty_message_));
+  EXPECT_TRUE(Peer::WireBytes(*unknown_fields_) == all_fields_data_);
+  EXPECT_EQ(unknown_fields_->field_count(), 2 * field_count + 1);
+  EXPECT_EQ(unknown_fields_->field(field_count).number(), 123456);
+
+  unknown_fields_->DeleteByNumber(123456);
+  std::string data;
+  ASSERT_TRUE(empty_message_.SerializeToString(&data));
+  EXPECT_TRUE(data == all_fields_data_ + all_fields_data_);
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, AppendAfterReadKeepsDecodedFields) {
+  Arena arena;
+  auto* message = Arena::Create<unittest::TestEmptyMessage>(&arena);
+  const int field_count = unknown_fields_->field_count();
+  for (int i = 1; i <= 3; ++i) {
+    ASSERT_TRUE(MergeKeepingWireBytes(all_fields_data_, message));
+    const UnknownFieldSet& unknown_fields = message->unknown_fields();
+    // Only the newly appended bytes are left to decode.
+    EXPECT_TRUE(Peer::WireBytes(unknown_fields) == all_fields_data_);
+    EXPECT_FALSE(Peer::IsDecoded(unknown_fields));
+    ASSERT_EQ(unknown_fields.field_count(), i * field_count);
+    EXPECT_TRUE(Peer::IsDecoded(unknown_fields));
+    EXPECT_EQ(unknown_fields.field((i - 1) * field_count).number(),
+              unknown_fields_->field(0).number());
+  }
+
+  std::string data;
+  ASSERT_TRUE(message->SerializeToString(&data));
+  EXPECT_TRUE(data == all_fields_data_ + all_fields_data_ + all_fields_data_);
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, OnlyScopedToTheStream) {
+  // Other parses, including ones of the same message, still create
+  // UnknownFields.
+  unittest::TestEmptyMessage message;
+  ASSERT_TRUE(message.ParseFromString(all_fields_data_));
+  EXPECT_TRUE(Peer::WireBytes(message.unknown_fields()).empty());
+  ASSERT_TRUE(message.MergeFromString(all_fields_data_));
+  EXPECT_TRUE(Peer::WireBytes(message.unknown_fields()).empty());
+
+  // Once a set holds wire bytes, later parses append to them.
+  ASSERT_TRUE(empty_message_.MergeFromString(all_fields_data_));
+  EXPECT_TRUE(Peer::WireBytes(*unknown_fields_) ==
+              all_fields_data_ + all_fields_data_);
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, MergeAndSwapKeepWireBytes) {
+  unittest::TestEmptyMessage other;
+  other.MergeFrom(empty_message_);
+  other.MergeFrom(empty_message_);
+  EXPECT_TRUE(Peer::WireBytes(other.unknown_fields()) ==
+              all_fields_data_ + all_fields_data_);
+
+  unittest::TestEmptyMessage swapped;
+  swapped.Swap(&other);
+  EXPECT_TRUE(other.unknown_fields().empty());
+  EXPECT_EQ(swapped.unknown_fields().field_count(),
+            2 * unknown_fields_->field_count());
+
+  swapped.Clear();
+  EXPECT_TRUE(swapped.unknown_fields().empty());
+  EXPECT_EQ(swapped.unknown_fields().field_count(), 0);
+}
+
+TEST_F(UnknownFieldSetWireBytesTest, Arena) {
+  Arena arena;
+  auto* message = Arena::Create<unittest::TestEmptyMessage>(&arena);
+  ASSERT_TRUE(MergeKeepingWireBytes(all_fields_data_, message));
+  EXPECT_TRUE(Peer::WireBytes(message->unknown_fields()) == all_fields_data_);
+  EXPECT_EQ(message->unknown_fields().field_count(),
+            unknown_fields_->field_count());
+  message->mutable_unknown_fields()->AddFixed32(123456, 1);
+
+  std::string data;
+  ASSERT_TRUE(message->SerializeToString(&data));
+  unittest::TestAllTypes parsed;
+  ASSERT_TRUE(parsed.ParseFromString(data));
+  EXPECT_EQ(parsed.unknown_fields().field_count(), 1);
+}
+
 }  // namespace
 }  // namespace protobuf
 }  // namespace google
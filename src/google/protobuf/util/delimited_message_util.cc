@@ -10,7 +10,19 @@
 
 #include "google/protobuf/util/delimited_message_util.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arena.h"
 #include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/message_lite.h"
 
 namespace google {
 namespace protobuf {
@@ -101,6 +113,179 @@ bool SerializeDelimitedToCodedStream(const MessageLite& message,
   return true;
 }
 
+namespace {
+
+// Sizes are written with WriteVarint32() and limited to INT_MAX.
+constexpr int kMaxSizeBytes = 5;
+
+// Decodes the size prefix of a record from [ptr, end).  Returns the length of
+// the prefix, 0 if it is incomplete, or -1 if it is malformed.
+int DecodeSize(const char* ptr, const char* end, uint32_t* size) {
+  uint64_t value = 0;
+  for (int i = 0; i < kMaxSizeBytes; ++i) {
+    if (ptr + i == end) return 0;
+    const uint8_t byte = static_cast<uint8_t>(ptr[i]);
+    value |= uint64_t{byte & 0x7Fu} << (7 * i);
+    if (byte < 0x80) {
+      if (value > INT_MAX) return -1;
+      *size = static_cast<uint32_t>(value);
+      return i + 1;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
+DelimitedMessageReader::DelimitedMessageReader(io::ZeroCopyInputStream* input)
+    : input_(input) {}
+
+DelimitedMessageReader::DelimitedMessageReader(int file_descriptor,
+                                               int block_size)
+    : owned_input_(
+          std::make_unique<io::FileInputStream>(file_descriptor, block_size)),
+      input_(owned_input_.get()) {}
+
+DelimitedMessageReader::~DelimitedMessageReader() {
+  if (end_ != pos_) input_->BackUp(static_cast<int>(end_ - pos_));
+}
+
+bool DelimitedMessageReader::Refill() {
+  const void* data;
+  int size;
+  do {
+    if (!input_->Next(&data, &size)) return false;
+  } while (size == 0);
+  pos_ = static_cast<const char*>(data);
+  end_ = pos_ + size;
+  return true;
+}
+
+bool DelimitedMessageReader::ReadBufferedRecord(absl::string_view* record) {
+  uint32_t size;
+  const int prefix = DecodeSize(pos_, end_, &size);
+  if (prefix <= 0 || static_cast<size_t>(end_ - pos_ - prefix) < size) {
+    return false;
+  }
+  *record = absl::string_view(pos_ + prefix, size);
+  pos_ += prefix + size;
+  return true;
+}
+
+bool DelimitedMessageReader::ReadRecordSlow(absl::string_view* record) {
+  // The size prefix itself may span buffers.
+  char prefix[kMaxSizeBytes];
+  int prefix_size = 0;
+  uint32_t size;
+  while (true) {
+    if (pos_ == end_ && !Refill()) {
+      failed_ = true;
+      clean_eof_ = prefix_size == 0;
+      return false;
+    }
+    prefix[prefix_size++] = *pos_++;
+    const int decoded = DecodeSize(prefix, prefix + prefix_size, &size);
+    if (decoded > 0) break;
+    if (decoded < 0) {
+      failed_ = true;
+      return false;
+    }
+  }
+
+  if (static_cast<size_t>(end_ - pos_) >= size) {
+    *record = absl::string_view(pos_, size);
+    pos_ += size;
+    return true;
+  }
+  // The size comes from the input, so the buffer is not reserved up front.
+  spill_.assign(pos_, end_);
+  pos_ = end_;
+  while (spill_.size() < size) {
+    if (!Refill()) {
+      // The stream ended in the middle of a record.
+      failed_ = true;
+      return false;
+    }
+    const size_t n =
+        std::min(static_cast<size_t>(size - spill_.size()),
+                 static_cast<size_t>(end_ - pos_));
+    spill_.append(pos_, n);
+    pos_ += n;
+  }
+  *record = spill_;
+  return true;
+}
+
+bool DelimitedMessageReader::ReadRecord(absl::string_view* record) {
+  if (failed_) return false;
+  return ReadBufferedRecord(record) || ReadRecordSlow(record);
+}
+
+bool DelimitedMessageReader::ReadBatch(
+    int max_records, std::vector<absl::string_view>* records) {
+  records->clear();
+  absl::string_view record;
+  if (max_records <= 0 || !ReadRecord(&record)) return false;
+  records->push_back(record);
+  // Reading more input would invalidate the records found so far.
+  while (static_cast<int>(records->size()) < max_records &&
+         ReadBufferedRecord(&record)) {
+    records->push_back(record);
+  }
+  return true;
+}
+
+bool DelimitedMessageReader::ReadMessage(MessageLite* message) {
+  absl::string_view record;
+  return ReadRecord(&record) && message->ParseFromString(record);
+}
+
+bool DelimitedMessageReader::ReadMessages(const MessageLite& prototype,
+                                          Arena* arena, int max_records,
+                                          std::vector<MessageLite*>* messages) {
+  messages->clear();
+  std::vector<absl::string_view> records;
+  if (!ReadBatch(max_records, &records)) return false;
+  messages->reserve(records.size());
+  bool success = true;
+  for (absl::string_view record : records) {
+    MessageLite* message = prototype.New(arena);
+    messages->push_back(message);
+    success = message->ParseFromString(record) && success;
+  }
+  return success;
+}
+
+DelimitedMessageWriter::DelimitedMessageWriter(
+    io::ZeroCopyOutputStream* output)
+    : coded_output_(output) {}
+
+DelimitedMessageWriter::DelimitedMessageWriter(int file_descriptor,
+                                               int block_size)
+    : owned_output_(
+          std::make_unique<io::FileOutputStream>(file_descriptor, block_size)),
+      coded_output_(owned_output_.get()) {}
+
+DelimitedMessageWriter::~DelimitedMessageWriter() { Flush(); }
+
+bool DelimitedMessageWriter::WriteMessage(const MessageLite& message) {
+  return SerializeDelimitedToCodedStream(message, &coded_output_) &&
+         !coded_output_.HadError();
+}
+
+bool DelimitedMessageWriter::WriteRecord(absl::string_view record) {
+  if (record.size() > INT_MAX) return false;
+  coded_output_.WriteVarint32(static_cast<uint32_t>(record.size()));
+  coded_output_.WriteRaw(record.data(), static_cast<int>(record.size()));
+  return !coded_output_.HadError();
+}
+
+bool DelimitedMessageWriter::Flush() {
+  coded_output_.Trim();
+  if (coded_output_.HadError()) return false;
+  return owned_output_ == nullptr || owned_output_->Flush();
+}
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
@@ -11,8 +11,13 @@
 #ifndef GOOGLE_PROTOBUF_UTIL_DELIMITED_MESSAGE_UTIL_H__
 #define GOOGLE_PROTOBUF_UTIL_DELIMITED_MESSAGE_UTIL_H__
 
+#include <cstdint>
+#include <memory>
 #include <ostream>
+#include <string>
+#include <vector>
 
+#include "absl/strings/string_view.h"
 #include "google/protobuf/io/coded_stream.h"
 #include "google/protobuf/io/zero_copy_stream_impl.h"
 #include "google/protobuf/message_lite.h"
@@ -76,6 +81,115 @@ bool PROTOBUF_EXPORT SerializeDelimitedToZeroCopyStream(
 bool PROTOBUF_EXPORT SerializeDelimitedToCodedStream(
     const MessageLite& message, io::CodedOutputStream* output);
 
+// Reads a stream of size-delimited messages, as written by the functions
+// above or by DelimitedMessageWriter.
+//
+// Unlike ParseDelimitedFromZeroCopyStream(), which sets up a new
+// CodedInputStream for every message, the reader finds record boundaries
+// directly in the buffers returned by the underlying stream and hands out
+// records without copying them, unless a record spans two buffers.  Records
+// can be read in batches, for example to parse them on several threads.
+//
+// Like io::CodedInputStream, the reader reads ahead of the records it has
+// returned, and hands unread data back to the stream when it is destroyed.
+class PROTOBUF_EXPORT DelimitedMessageReader {
+ public:
+  // The default size of the reads issued on a file descriptor.  Large reads
+  // amortize system call overhead and keep most records within one buffer.
+  static constexpr int kDefaultBlockSize = 1 << 20;
+
+  // Reads records from `input`, which must outlive the reader.
+  explicit DelimitedMessageReader(io::ZeroCopyInputStream* input);
+  // Reads records from the given file descriptor, in blocks of `block_size`.
+  explicit DelimitedMessageReader(int file_descriptor,
+                                  int block_size = kDefaultBlockSize);
+  DelimitedMessageReader(const DelimitedMessageReader&) = delete;
+  DelimitedMessageReader& operator=(const DelimitedMessageReader&) = delete;
+  ~DelimitedMessageReader();
+
+  // Reads the bytes of the next message into `*record`.  The bytes remain
+  // valid until the next call to any Read method.  Returns false at the end of
+  // the stream or on error; see clean_eof().
+  bool ReadRecord(absl::string_view* record);
+
+  // Reads the next records, at most `max_records` of them, into `*records`.
+  // Input is only read when no complete record is buffered, so a batch holds
+  // the records that could be found without waiting for more input.  All of
+  // the records remain valid until the next call to any Read method.  Returns
+  // false if no record could be read.
+  bool ReadBatch(int max_records, std::vector<absl::string_view>* records);
+
+  // Reads and parses the next message.  Returns false at the end of the
+  // stream, on error, or if the message could not be parsed.
+  bool ReadMessage(MessageLite* message);
+
+  // Reads a batch as with ReadBatch() and parses each record into a new
+  // message of the same type as `prototype`, allocated on `arena`.  If
+  // `arena` is null, the caller takes ownership of the messages.  Returns
+  // false if no record could be read or if any record failed to parse.
+  bool ReadMessages(const MessageLite& prototype, Arena* arena,
+                    int max_records, std::vector<MessageLite*>* messages);
+
+  // Returns true if the stream ended at a record boundary, that is, if the
+  // last Read call failed only because there were no more records.
+  bool clean_eof() const { return clean_eof_; }
+
+ private:
+  // Reads the next record if it is entirely within the current buffer.
+  bool ReadBufferedRecord(absl::string_view* record);
+  // Reads the next record from as many buffers as needed.
+  bool ReadRecordSlow(absl::string_view* record);
+  // Advances to the next non-empty buffer of the underlying stream.
+  bool Refill();
+
+  std::unique_ptr<io::ZeroCopyInputStream> owned_input_;
+  io::ZeroCopyInputStream* input_;
+  const char* pos_ = nullptr;
+  const char* end_ = nullptr;
+  // Holds a record that spans several buffers.
+  std::string spill_;
+  bool failed_ = false;
+  bool clean_eof_ = false;
+};
+
+// Writes a stream of size-delimited messages.
+//
+// The writer serializes every message straight into the buffers of the
+// underlying stream, so writing many small messages costs as little as
+// writing one large one.  When writing to a file descriptor, data is written
+// to the file in blocks of the given size.
+class PROTOBUF_EXPORT DelimitedMessageWriter {
+ public:
+  static constexpr int kDefaultBlockSize = 1 << 20;
+
+  // Writes records to `output`, which must outlive the writer.  Data may stay
+  // buffered in the writer until Flush() is called or the writer is
+  // destroyed.
+  explicit DelimitedMessageWriter(io::ZeroCopyOutputStream* output);
+  // Writes records to the given file descriptor, in blocks of `block_size`.
+  explicit DelimitedMessageWriter(int file_descriptor,
+                                  int block_size = kDefaultBlockSize);
+  DelimitedMessageWriter(const DelimitedMessageWriter&) = delete;
+  DelimitedMessageWriter& operator=(const DelimitedMessageWriter&) = delete;
+  // Flushes any buffered data.
+  ~DelimitedMessageWriter();
+
+  // Writes a message.  Returns false on error.
+  bool WriteMessage(const MessageLite& message);
+
+  // Writes an already serialized message.  Returns false on error.
+  bool WriteRecord(absl::string_view record);
+
+  // Hands all buffered data to the underlying stream, and writes it to the
+  // file when writing to a file descriptor.  Returns false if any error has
+  // occurred.
+  bool Flush();
+
+ private:
+  std::unique_ptr<io::FileOutputStream> owned_output_;
+  io::CodedOutputStream coded_output_;
+};
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
@@ -11,9 +11,14 @@
 #include "google/protobuf/util/delimited_message_util.h"
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "google/protobuf/testing/googletest.h"
 #include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
 #include "google/protobuf/test_util.h"
 #include "google/protobuf/unittest.pb.h"
 #include "google/protobuf/unittest_import.pb.h"
@@ -89,6 +94,113 @@ TEST(DelimitedMessageUtilTest, FailsAtEndOfStream) {
   }
 }
 
+// Writes `count` ForeignMessages with increasing `c`, using both WriteRecord()
+// and WriteMessage().
+std::string WriteForeignMessages(int count) {
+  std::string output;
+  {
+    io::StringOutputStream stream(&output);
+    DelimitedMessageWriter writer(&stream);
+    for (int i = 0; i < count; ++i) {
+      proto2_unittest::ForeignMessage message;
+      message.set_c(i);
+      if (i % 10 == 0) {
+        EXPECT_TRUE(writer.WriteRecord(message.SerializeAsString()));
+      } else {
+        EXPECT_TRUE(writer.WriteMessage(message));
+      }
+    }
+  }
+  return output;
+}
+
+TEST(DelimitedMessageUtilTest, ReaderReadsWriterOutput) {
+  const std::string data = WriteForeignMessages(1000);
+
+  // Small blocks make records and their size prefixes span buffers.
+  for (int block_size : {1, 3, 7, 64, -1}) {
+    SCOPED_TRACE(block_size);
+    io::ArrayInputStream stream(data.data(), static_cast<int>(data.size()),
+                                block_size);
+    DelimitedMessageReader reader(&stream);
+    proto2_unittest::ForeignMessage message;
+    for (int i = 0; i < 1000; ++i) {
+      ASSERT_TRUE(reader.ReadMessage(&message));
+      EXPECT_EQ(message.c(), i);
+    }
+    EXPECT_FALSE(reader.ReadMessage(&message));
+    EXPECT_TRUE(reader.clean_eof());
+  }
+}
+
+TEST(DelimitedMessageUtilTest, ReaderMatchesParseDelimited) {
+  std::stringstream stream;
+  proto2_unittest::TestAllTypes message1;
+  TestUtil::SetAllFields(&message1);
+  EXPECT_TRUE(SerializeDelimitedToOstream(message1, &stream));
+  EXPECT_TRUE(SerializeDelimitedToOstream(message1, &stream));
+
+  io::IstreamInputStream zstream(&stream);
+  DelimitedMessageReader reader(&zstream);
+  std::vector<absl::string_view> records;
+  ASSERT_TRUE(reader.ReadBatch(10, &records));
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0], message1.SerializeAsString());
+  EXPECT_EQ(records[1], message1.SerializeAsString());
+  EXPECT_FALSE(reader.ReadBatch(10, &records));
+  EXPECT_TRUE(reader.clean_eof());
+}
+
+TEST(DelimitedMessageUtilTest, ReaderBatches) {
+  const std::string data = WriteForeignMessages(1000);
+  io::ArrayInputStream stream(data.data(), static_cast<int>(data.size()), 100);
+  DelimitedMessageReader reader(&stream);
+
+  Arena arena;
+  std::vector<MessageLite*> messages;
+  int count = 0;
+  const auto& prototype = proto2_unittest::ForeignMessage::default_instance();
+  while (reader.ReadMessages(prototype, &arena, 16, &messages)) {
+    ASSERT_FALSE(messages.empty());
+    EXPECT_LE(messages.size(), 16);
+    for (MessageLite* message : messages) {
+      EXPECT_EQ(message->GetArena(), &arena);
+      EXPECT_EQ(
+          static_cast<proto2_unittest::ForeignMessage*>(message)->c(),
+          count++);
+    }
+  }
+  EXPECT_EQ(count, 1000);
+  EXPECT_TRUE(reader.clean_eof());
+}
+
+TEST(DelimitedMessageUtilTest, ReaderFailsOnTruncatedRecord) {
+  std::string data = WriteForeignMessages(2);
+  data.pop_back();
+  io::ArrayInputStream stream(data.data(), static_cast<int>(data.size()));
+  DelimitedMessageReader reader(&stream);
+  absl::string_view record;
+  EXPECT_TRUE(reader.ReadRecord(&record));
+  EXPECT_FALSE(reader.ReadRecord(&record));
+  EXPECT_FALSE(reader.clean_eof());
+}
+
+TEST(DelimitedMessageUtilTest, ReaderBacksUpUnreadData) {
+  std::string data = WriteForeignMessages(1);
+  data += "trailer";
+  io::ArrayInputStream stream(data.data(), static_cast<int>(data.size()));
+  {
+    DelimitedMessageReader reader(&stream);
+    absl::string_view record;
+    EXPECT_TRUE(reader.ReadRecord(&record));
+  }
+  const void* rest;
+  int size;
+  ASSERT_TRUE(stream.Next(&rest, &size));
+  EXPECT_EQ(absl::string_view(static_cast<const char*>(rest), size),
+            "trailer");
+}
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/container/btree_map.h"
@@ -232,7 +233,6 @@ class FieldMaskTree {
     return TrimMessage(&root_, message);
   }
 
- private:
   struct Node {
     Node() = default;
     Node(const Node&) = delete;
@@ -247,6 +247,10 @@ class FieldMaskTree {
     absl::btree_map<std::string, std::unique_ptr<Node>> children;
   };
 
+  const Node& root() const { return root_; }
+
+ private:
+
   // Merge a sub-tree to mask. This method adds the field paths represented
   // by all leaf nodes descended from "node" to mask.
   void MergeToFieldMask(absl::string_view prefix, const Node* node,
@@ -424,38 +428,15 @@ void FieldMaskTree::MergeLeafNodesToTree(absl::string_view prefix,
   }
 }
 
-void FieldMaskTree::MergeMessage(const Node* node, const Message& source,
-                                 const FieldMaskUtil::MergeOptions& options,
-                                 Message* destination) {
-  ABSL_DCHECK(!node->children.empty());
+// Merges a single field, as specified by a leaf of the mask, from one message
+// to another.
+void MergeField(const FieldDescriptor* field, const Message& source,
+                const FieldMaskUtil::MergeOptions& options,
+                Message* destination) {
   const Reflection* source_reflection = source.GetReflection();
   const Reflection* destination_reflection = destination->GetReflection();
-  const Descriptor* descriptor = source.GetDescriptor();
-  for (const auto& kv : node->children) {
-    absl::string_view field_name = kv.first;
-    const Node* child = kv.second.get();
-    const FieldDescriptor* field = descriptor->FindFieldByName(field_name);
-    if (field == nullptr) {
-      ABSL_LOG(ERROR) << "Cannot find field \"" << field_name
-                      << "\" in message " << descriptor->full_name();
-      continue;
-    }
-    if (!child->children.empty()) {
-      // Sub-paths are only allowed for singular message fields.
-      if (field->is_repeated() ||
-          field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
-        ABSL_LOG(ERROR) << "Field \"" << field_name << "\" in message "
-                        << descriptor->full_name()
-                        << " is not a singular message field and cannot "
-                        << "have sub-fields.";
-        continue;
-      }
-      MergeMessage(child, source_reflection->GetMessage(source, field), options,
-                   destination_reflection->MutableMessage(destination, field));
-      continue;
-    }
-    if (!field->is_repeated()) {
-      switch (field->cpp_type()) {
+  if (!field->is_repeated()) {
+    switch (field->cpp_type()) {
 #define COPY_VALUE(TYPE, Name)                                              \
   case FieldDescriptor::CPPTYPE_##TYPE: {                                   \
     if (source_reflection->HasField(source, field)) {                       \
@@ -466,32 +447,32 @@ void FieldMaskTree::MergeMessage(const Node* node, const Message& source,
     }                                                                       \
     break;                                                                  \
   }
-        COPY_VALUE(BOOL, Bool)
-        COPY_VALUE(INT32, Int32)
-        COPY_VALUE(INT64, Int64)
-        COPY_VALUE(UINT32, UInt32)
-        COPY_VALUE(UINT64, UInt64)
-        COPY_VALUE(FLOAT, Float)
-        COPY_VALUE(DOUBLE, Double)
-        COPY_VALUE(ENUM, Enum)
-        COPY_VALUE(STRING, String)
+      COPY_VALUE(BOOL, Bool)
+      COPY_VALUE(INT32, Int32)
+      COPY_VALUE(INT64, Int64)
+      COPY_VALUE(UINT32, UInt32)
+      COPY_VALUE(UINT64, UInt64)
+      COPY_VALUE(FLOAT, Float)
+      COPY_VALUE(DOUBLE, Double)
+      COPY_VALUE(ENUM, Enum)
+      COPY_VALUE(STRING, String)
 #undef COPY_VALUE
-        case FieldDescriptor::CPPTYPE_MESSAGE: {
-          if (options.replace_message_fields()) {
-            destination_reflection->ClearField(destination, field);
-          }
-          if (source_reflection->HasField(source, field)) {
-            destination_reflection->MutableMessage(destination, field)
-                ->MergeFrom(source_reflection->GetMessage(source, field));
-          }
-          break;
+      case FieldDescriptor::CPPTYPE_MESSAGE: {
+        if (options.replace_message_fields()) {
+          destination_reflection->ClearField(destination, field);
         }
+        if (source_reflection->HasField(source, field)) {
+          destination_reflection->MutableMessage(destination, field)
+              ->MergeFrom(source_reflection->GetMessage(source, field));
+        }
+        break;
       }
-    } else {
-      if (options.replace_repeated_fields()) {
-        destination_reflection->ClearField(destination, field);
-      }
-      switch (field->cpp_type()) {
+    }
+  } else {
+    if (options.replace_repeated_fields()) {
+      destination_reflection->ClearField(destination, field);
+    }
+    switch (field->cpp_type()) {
 #define COPY_REPEATED_VALUE(TYPE, Name)                            \
   case FieldDescriptor::CPPTYPE_##TYPE: {                          \
     int size = source_reflection->FieldSize(source, field);        \
@@ -502,25 +483,24 @@ void FieldMaskTree::MergeMessage(const Node* node, const Message& source,
     }                                                              \
     break;                                                         \
   }
-        COPY_REPEATED_VALUE(BOOL, Bool)
-        COPY_REPEATED_VALUE(INT32, Int32)
-        COPY_REPEATED_VALUE(INT64, Int64)
-        COPY_REPEATED_VALUE(UINT32, UInt32)
-        COPY_REPEATED_VALUE(UINT64, UInt64)
-        COPY_REPEATED_VALUE(FLOAT, Float)
-        COPY_REPEATED_VALUE(DOUBLE, Double)
-        COPY_REPEATED_VALUE(ENUM, Enum)
-        COPY_REPEATED_VALUE(STRING, String)
+      COPY_REPEATED_VALUE(BOOL, Bool)
+      COPY_REPEATED_VALUE(INT32, Int32)
+      COPY_REPEATED_VALUE(INT64, Int64)
+      COPY_REPEATED_VALUE(UINT32, UInt32)
+      COPY_REPEATED_VALUE(UINT64, UInt64)
+      COPY_REPEATED_VALUE(FLOAT, Float)
+      COPY_REPEATED_VALUE(DOUBLE, Double)
+      COPY_REPEATED_VALUE(ENUM, Enum)
+      COPY_REPEATED_VALUE(STRING, String)
 #undef COPY_REPEATED_VALUE
-        case FieldDescriptor::CPPTYPE_MESSAGE: {
-          int size = source_reflection->FieldSize(source, field);
-          for (int i = 0; i < size; ++i) {
-            destination_reflection->AddMessage(destination, field)
-                ->MergeFrom(
-                    source_reflection->GetRepeatedMessage(source, field, i));
-          }
-          break;
+      case FieldDescriptor::CPPTYPE_MESSAGE: {
+        int size = source_reflection->FieldSize(source, field);
+        for (int i = 0; i < size; ++i) {
+          destination_reflection->AddMessage(destination, field)
+              ->MergeFrom(
+                  source_reflection->GetRepeatedMessage(source, field, i));
         }
+        break;
       }
     }
   }
@@ -560,6 +540,39 @@ void FieldMaskTree::AddRequiredFieldPath(Node* node,
   }
 }
 
+void FieldMaskTree::MergeMessage(const Node* node, const Message& source,
+                                 const FieldMaskUtil::MergeOptions& options,
+                                 Message* destination) {
+  ABSL_DCHECK(!node->children.empty());
+  const Descriptor* descriptor = source.GetDescriptor();
+  for (const auto& kv : node->children) {
+    absl::string_view field_name = kv.first;
+    const Node* child = kv.second.get();
+    const FieldDescriptor* field = descriptor->FindFieldByName(field_name);
+    if (field == nullptr) {
+      ABSL_LOG(ERROR) << "Cannot find field \"" << field_name
+                      << "\" in message " << descriptor->full_name();
+      continue;
+    }
+    if (!child->children.empty()) {
+      // Sub-paths are only allowed for singular message fields.
+      if (field->is_repeated() ||
+          field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+        ABSL_LOG(ERROR) << "Field \"" << field_name << "\" in message "
+                        << descriptor->full_name()
+                        << " is not a singular message field and cannot "
+                        << "have sub-fields.";
+        continue;
+      }
+      MergeMessage(
+          child, source.GetReflection()->GetMessage(source, field), options,
+          destination->GetReflection()->MutableMessage(destination, field));
+      continue;
+    }
+    MergeField(field, source, options, destination);
+  }
+}
+
 bool FieldMaskTree::TrimMessage(const Node* node, Message* message) {
   ABSL_DCHECK(!node->children.empty());
   const Reflection* reflection = message->GetReflection();
@@ -596,6 +609,157 @@ bool FieldMaskTree::TrimMessage(const Node* node, Message* message) {
 
 }  // namespace
 
+struct FieldMaskUtil::CompiledFieldMask::MergeNode {
+  struct Field {
+    const FieldDescriptor* field;
+    // The node for the field's sub-mask, or -1 to merge the whole field.
+    int child;
+  };
+  std::vector<Field> fields;
+};
+
+struct FieldMaskUtil::CompiledFieldMask::TrimNode {
+  // What to do with each field, indexed by FieldDescriptor::index().
+  static constexpr int kClear = -2;
+  static constexpr int kKeep = -1;
+  // kClear, kKeep, or the node for the field's sub-mask.
+  std::vector<int> fields;
+};
+
+FieldMaskUtil::CompiledFieldMask::CompiledFieldMask(
+    const Descriptor* descriptor, const FieldMask& mask)
+    : CompiledFieldMask(descriptor, mask, TrimOptions()) {}
+
+FieldMaskUtil::CompiledFieldMask::CompiledFieldMask(
+    const Descriptor* descriptor, const FieldMask& mask,
+    const TrimOptions& trim_options)
+    : descriptor_(ABSL_DIE_IF_NULL(descriptor)) {
+  FieldMaskTree tree;
+  tree.MergeFromFieldMask(mask);
+  // Do nothing if the tree is empty.
+  if (tree.root().children.empty()) return;
+
+  // Flattens the tree into `merge_nodes_`, returning the index of the node.
+  const auto compile_merge = [&](const auto& self,
+                                 const FieldMaskTree::Node& node,
+                                 const Descriptor* type) -> int {
+    ABSL_DCHECK(!node.children.empty());
+    const int index = static_cast<int>(merge_nodes_.size());
+    merge_nodes_.emplace_back();
+    for (const auto& kv : node.children) {
+      absl::string_view field_name = kv.first;
+      const FieldMaskTree::Node& child = *kv.second;
+      const FieldDescriptor* field = type->FindFieldByName(field_name);
+      if (field == nullptr) {
+        ABSL_LOG(ERROR) << "Cannot find field \"" << field_name
+                        << "\" in message " << type->full_name();
+        continue;
+      }
+      int child_index = -1;
+      if (!child.children.empty()) {
+        // Sub-paths are only allowed for singular message fields.
+        if (field->is_repeated() ||
+            field->cpp_type() != FieldDescriptor::CPPTYPE_MESSAGE) {
+          ABSL_LOG(ERROR) << "Field \"" << field_name << "\" in message "
+                          << type->full_name()
+                          << " is not a singular message field and cannot "
+                          << "have sub-fields.";
+          continue;
+        }
+        child_index = self(self, child, field->message_type());
+      }
+      merge_nodes_[index].fields.push_back({field, child_index});
+    }
+    return index;
+  };
+  compile_merge(compile_merge, tree.root(), descriptor_);
+
+  // If keep_required_fields is true, implicitly add required fields of
+  // a message present in the tree to prevent from trimming.
+  if (trim_options.keep_required_fields()) {
+    tree.AddRequiredFieldPath(descriptor_);
+  }
+  // Flattens the tree into `trim_nodes_`, returning the index of the node.
+  const auto compile_trim = [&](const auto& self,
+                                const FieldMaskTree::Node& node,
+                                const Descriptor* type) -> int {
+    ABSL_DCHECK(!node.children.empty());
+    const int index = static_cast<int>(trim_nodes_.size());
+    trim_nodes_.emplace_back();
+    std::vector<int> fields(type->field_count(), TrimNode::kClear);
+    for (int i = 0; i < type->field_count(); ++i) {
+      const FieldDescriptor* field = type->field(i);
+      auto it = node.children.find(field->name());
+      if (it == node.children.end()) continue;
+      fields[i] = TrimNode::kKeep;
+      if (!it->second->children.empty() && !field->is_repeated() &&
+          field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+        fields[i] = self(self, *it->second, field->message_type());
+      }
+    }
+    // Recursion may have reallocated `trim_nodes_`.
+    trim_nodes_[index].fields = std::move(fields);
+    return index;
+  };
+  compile_trim(compile_trim, tree.root(), descriptor_);
+}
+
+FieldMaskUtil::CompiledFieldMask::~CompiledFieldMask() = default;
+
+void FieldMaskUtil::CompiledFieldMask::MergeMessageTo(
+    const Message& source, const MergeOptions& options,
+    Message* destination) const {
+  ABSL_CHECK(source.GetDescriptor() == descriptor_);
+  ABSL_CHECK(destination->GetDescriptor() == descriptor_);
+  if (merge_nodes_.empty()) return;
+  MergeMessage(0, source, options, destination);
+}
+
+void FieldMaskUtil::CompiledFieldMask::MergeMessage(
+    int node, const Message& source, const MergeOptions& options,
+    Message* destination) const {
+  for (const MergeNode::Field& entry : merge_nodes_[node].fields) {
+    if (entry.child < 0) {
+      MergeField(entry.field, source, options, destination);
+      continue;
+    }
+    MergeMessage(
+        entry.child,
+        source.GetReflection()->GetMessage(source, entry.field), options,
+        destination->GetReflection()->MutableMessage(destination, entry.field));
+  }
+}
+
+bool FieldMaskUtil::CompiledFieldMask::TrimMessage(Message* message) const {
+  ABSL_CHECK(ABSL_DIE_IF_NULL(message)->GetDescriptor() == descriptor_);
+  if (trim_nodes_.empty()) return false;
+  return TrimMessage(0, message);
+}
+
+bool FieldMaskUtil::CompiledFieldMask::TrimMessage(int node,
+                                                   Message* message) const {
+  const Reflection* reflection = message->GetReflection();
+  // Only set fields need to be looked at, and ListFields() finds them from
+  // the has-bits without visiting every field of the type.
+  std::vector<const FieldDescriptor*> set_fields;
+  reflection->ListFields(*message, &set_fields);
+  const std::vector<int>& fields = trim_nodes_[node].fields;
+  bool modified = false;
+  for (const FieldDescriptor* field : set_fields) {
+    if (field->is_extension()) continue;
+    const int action = fields[field->index()];
+    if (action == TrimNode::kClear) {
+      reflection->ClearField(message, field);
+      modified = true;
+    } else if (action != TrimNode::kKeep) {
+      modified =
+          TrimMessage(action, reflection->MutableMessage(message, field)) ||
+          modified;
+    }
+  }
+  return modified;
+}
+
 void FieldMaskUtil::ToCanonicalForm(const FieldMask& mask, FieldMask* out) {
   FieldMaskTree tree;
   tree.MergeFromFieldMask(mask);
@@ -662,7 +826,8 @@ void FieldMaskUtil::MergeMessageTo(const Message& source, const FieldMask& mask,
                                    Message* destination) {
   ABSL_CHECK(source.GetDescriptor() == destination->GetDescriptor());
   // Build a FieldMaskTree and walk through the tree to merge all specified
-  // fields.
+  // fields.  Compiling a CompiledFieldMask only pays off when the mask is
+  // applied more than once.
   FieldMaskTree tree;
   tree.MergeFromFieldMask(mask);
   tree.MergeMessage(source, options, destination);
@@ -158,6 +158,8 @@ class PROTOBUF_EXPORT FieldMaskUtil {
   static bool TrimMessage(const FieldMask& mask, Message* message,
                           const TrimOptions& options);
 
+  class CompiledFieldMask;
+
  private:
   friend class SnakeCaseCamelCaseTest;
   // Converts a field name from snake_case to camelCase:
@@ -233,6 +235,56 @@ class PROTOBUF_EXPORT FieldMaskUtil::TrimOptions {
   bool keep_required_fields_;
 };
 
+// A FieldMask resolved against a message type, for applying the same mask to
+// many messages.  MergeMessageTo() and TrimMessage() above parse the mask and
+// look up every field by name on each call; a CompiledFieldMask does that once
+// and then only walks a flat list of field descriptors per message.
+//
+// Example:
+//   static const auto* const kReadMask =
+//       new FieldMaskUtil::CompiledFieldMask(Response::descriptor(), mask);
+//   kReadMask->TrimMessage(&response);
+//
+// A CompiledFieldMask is immutable after construction and may be used from
+// multiple threads at once.
+class PROTOBUF_EXPORT FieldMaskUtil::CompiledFieldMask {
+ public:
+  // Compiles `mask` for messages of type `descriptor`.  Paths that do not name
+  // a field of the type are ignored.
+  CompiledFieldMask(const Descriptor* descriptor, const FieldMask& mask);
+  // As above, with TrimOptions that will be applied by TrimMessage().
+  CompiledFieldMask(const Descriptor* descriptor, const FieldMask& mask,
+                    const TrimOptions& trim_options);
+  CompiledFieldMask(const CompiledFieldMask&) = delete;
+  CompiledFieldMask& operator=(const CompiledFieldMask&) = delete;
+  ~CompiledFieldMask();
+
+  const Descriptor* descriptor() const { return descriptor_; }
+
+  // Same as FieldMaskUtil::MergeMessageTo() with the compiled mask.  Both
+  // messages must be of type descriptor().
+  void MergeMessageTo(const Message& source, const MergeOptions& options,
+                      Message* destination) const;
+
+  // Same as FieldMaskUtil::TrimMessage() with the compiled mask and the
+  // TrimOptions given at construction.  The message must be of type
+  // descriptor().  Returns true if the message is modified.
+  bool TrimMessage(Message* message) const;
+
+ private:
+  struct MergeNode;
+  struct TrimNode;
+
+  void MergeMessage(int node, const Message& source,
+                    const MergeOptions& options, Message* destination) const;
+  bool TrimMessage(int node, Message* message) const;
+
+  const Descriptor* descriptor_;
+  // Node 0 is the root; both are empty if the mask is empty.
+  std::vector<MergeNode> merge_nodes_;
+  std::vector<TrimNode> trim_nodes_;
+};
+
 }  // namespace util
 }  // namespace protobuf
 }  // namespace google
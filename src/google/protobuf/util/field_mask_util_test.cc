@@ -804,6 +804,72 @@ TEST(FieldMaskUtilTest, TrimMessageReturnValue) {
   // supported.
 }
 
+TEST(FieldMaskUtilTest, CompiledFieldMask) {
+  FieldMask payload_mask;
+  FieldMaskUtil::FromString(
+      "payload.optional_int32,payload.optional_foreign_message", &payload_mask);
+  FieldMaskUtil::CompiledFieldMask compiled_payload(
+      NestedTestAllTypes::descriptor(), payload_mask);
+  EXPECT_EQ(compiled_payload.descriptor(), NestedTestAllTypes::descriptor());
+
+  // Applying a compiled mask repeatedly gives the same results as the
+  // uncompiled functions.
+  for (int i = 0; i < 3; ++i) {
+    NestedTestAllTypes src;
+    TestUtil::SetAllFields(src.mutable_payload());
+    TestUtil::SetAllFields(src.mutable_child()->mutable_payload());
+    src.mutable_payload()->set_optional_int32(i);
+
+    NestedTestAllTypes expected = src;
+    NestedTestAllTypes trimmed = src;
+    EXPECT_EQ(FieldMaskUtil::TrimMessage(payload_mask, &expected),
+              compiled_payload.TrimMessage(&trimmed));
+    EXPECT_EQ(expected.DebugString(), trimmed.DebugString());
+    EXPECT_EQ(trimmed.payload().optional_int32(), i);
+    EXPECT_FALSE(trimmed.has_child());
+    EXPECT_FALSE(compiled_payload.TrimMessage(&trimmed));
+
+    FieldMaskUtil::MergeOptions options;
+    NestedTestAllTypes expected_dst;
+    NestedTestAllTypes dst;
+    dst.mutable_payload()->set_optional_int64(1);
+    expected_dst = dst;
+    FieldMaskUtil::MergeMessageTo(src, payload_mask, options, &expected_dst);
+    compiled_payload.MergeMessageTo(src, options, &dst);
+    EXPECT_EQ(expected_dst.DebugString(), dst.DebugString());
+    EXPECT_EQ(dst.payload().optional_int32(), i);
+    EXPECT_EQ(dst.payload().optional_int64(), 1);
+  }
+}
+
+TEST(FieldMaskUtilTest, CompiledFieldMaskKeepRequiredFields) {
+  TestRequiredMessage msg;
+  msg.mutable_required_message()->set_a(1);
+  msg.mutable_required_message()->set_b(2);
+  msg.mutable_required_message()->set_c(3);
+  msg.mutable_required_message()->set_dummy4(4);
+
+  FieldMask mask;
+  FieldMaskUtil::FromString("required_message.dummy4", &mask);
+  FieldMaskUtil::TrimOptions options;
+  options.set_keep_required_fields(true);
+  FieldMaskUtil::CompiledFieldMask compiled(TestRequiredMessage::descriptor(),
+                                            mask, options);
+  EXPECT_FALSE(compiled.TrimMessage(&msg));
+  EXPECT_TRUE(msg.IsInitialized());
+
+  msg.mutable_required_message()->set_dummy5(5);
+  EXPECT_TRUE(compiled.TrimMessage(&msg));
+  EXPECT_FALSE(msg.required_message().has_dummy5());
+  EXPECT_EQ(msg.required_message().dummy4(), 4);
+
+  // The TrimOptions do not affect merging.
+  TestRequiredMessage dst;
+  compiled.MergeMessageTo(msg, FieldMaskUtil::MergeOptions(), &dst);
+  EXPECT_EQ(dst.required_message().dummy4(), 4);
+  EXPECT_FALSE(dst.required_message().has_a());
+}
+
 
 }  // namespace
 }  // namespace util
@@ -12,16 +12,20 @@
 #include "google/protobuf/util/message_differencer.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "google/protobuf/descriptor.pb.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/strings/escaping.h"
@@ -136,6 +140,10 @@ class MessageDifferencer::MultipleFieldsMapKeyComparator
       delete;
   MultipleFieldsMapKeyComparator& operator=(
       const MultipleFieldsMapKeyComparator&) = delete;
+  const std::vector<std::vector<const FieldDescriptor*> >& key_field_paths()
+      const {
+    return key_field_paths_;
+  }
   bool IsMatch(const Message& message1, const Message& message2,
                int unpacked_any,
                const std::vector<SpecificField>& parent_fields) const override {
@@ -1882,8 +1890,216 @@ bool MaximumMatcher::FindArgumentPathDFS(int v, std::vector<bool>* visited) {
   return false;
 }
 
+// Below this many candidates, hashing every element costs more than simply
+// comparing them all.
+constexpr int kMinElementsToMatchByHash = 16;
+
+// Hashes repeated field elements so that any two elements MessageDifferencer
+// can consider a match hash to the same value.  Only values the default field
+// comparator compares exactly contribute: repeated fields, Any, ignored fields
+// and, unless floats are compared exactly, floating point fields are skipped.
+// Scalars hash their value whether or not they are set, which holds for both
+// EQUAL and EQUIVALENT comparison; singular messages are only hashed when
+// their presence is compared too.
+class ElementHasher {
+ public:
+  ElementHasher(
+      const absl::flat_hash_set<const FieldDescriptor*>& ignored_fields,
+      bool hash_floats, bool hash_message_presence)
+      : ignored_fields_(ignored_fields),
+        hash_floats_(hash_floats),
+        hash_message_presence_(hash_message_presence) {}
+
+  // Hashes element `index` of `repeated_field`, or only its key if
+  // `key_field_paths` is non-null.
+  size_t HashElement(
+      const Message& message, const FieldDescriptor* repeated_field, int index,
+      const std::vector<std::vector<const FieldDescriptor*> >* key_field_paths)
+      const {
+    if (key_field_paths == nullptr) {
+      return HashValue(message, repeated_field, index);
+    }
+    const Message& element =
+        message.GetReflection()->GetRepeatedMessage(message, repeated_field,
+                                                    index);
+    size_t hash = 0;
+    for (const auto& path : *key_field_paths) {
+      // Mirrors MultipleFieldsMapKeyComparator: keys whose intermediate
+      // messages are absent match each other, and repeated keys are compared
+      // with their own settings, so neither contributes.
+      const Message* key_message = &element;
+      for (size_t i = 0; key_message != nullptr && i + 1 < path.size(); ++i) {
+        const Reflection* reflection = key_message->GetReflection();
+        key_message = reflection->HasField(*key_message, path[i])
+                          ? &reflection->GetMessage(*key_message, path[i])
+                          : nullptr;
+      }
+      if (key_message != nullptr && !path.back()->is_repeated()) {
+        hash = absl::HashOf(hash, HashValue(*key_message, path.back(), -1));
+      }
+    }
+    return hash;
+  }
+
+ private:
+  // Hashes the value of `field`, or its element at `index` if it is repeated.
+  size_t HashValue(const Message& message, const FieldDescriptor* field,
+                   int index) const {
+    const Reflection* reflection = message.GetReflection();
+    const bool repeated = field->is_repeated();
+    switch (field->cpp_type()) {
+#define HASH_VALUE(CPPTYPE, METHOD)                                       \
+  case FieldDescriptor::CPPTYPE_##CPPTYPE:                                \
+    return absl::HashOf(                                                  \
+        repeated ? reflection->GetRepeated##METHOD(message, field, index) \
+                 : reflection->Get##METHOD(message, field));
+
+      HASH_VALUE(INT32, Int32);
+      HASH_VALUE(INT64, Int64);
+      HASH_VALUE(UINT32, UInt32);
+      HASH_VALUE(UINT64, UInt64);
+      HASH_VALUE(BOOL, Bool);
+      HASH_VALUE(ENUM, EnumValue);
+#undef HASH_VALUE
+
+      case FieldDescriptor::CPPTYPE_FLOAT:
+        return HashDouble(
+            repeated ? reflection->GetRepeatedFloat(message, field, index)
+                     : reflection->GetFloat(message, field));
+      case FieldDescriptor::CPPTYPE_DOUBLE:
+        return HashDouble(
+            repeated ? reflection->GetRepeatedDouble(message, field, index)
+                     : reflection->GetDouble(message, field));
+      case FieldDescriptor::CPPTYPE_STRING: {
+        std::string scratch;
+        return absl::HashOf(
+            repeated ? reflection->GetRepeatedStringReference(message, field,
+                                                              index, &scratch)
+                     : reflection->GetStringReference(message, field,
+                                                      &scratch));
+      }
+      case FieldDescriptor::CPPTYPE_MESSAGE:
+        return HashMessage(
+            repeated ? reflection->GetRepeatedMessage(message, field, index)
+                     : reflection->GetMessage(message, field));
+    }
+    return 0;
+  }
+
+  size_t HashDouble(double value) const {
+    // 0.0 == -0.0, and NaNs may be treated as equal.
+    if (!hash_floats_ || value == 0 || std::isnan(value)) return 0;
+    return absl::HashOf(value);
+  }
+
+  size_t HashMessage(const Message& message) const {
+    const Descriptor* descriptor = message.GetDescriptor();
+    // Any is compared by its unpacked payload, not its serialized bytes.
+    if (descriptor->full_name() == internal::kAnyFullTypeName) return 0;
+    const Reflection* reflection = message.GetReflection();
+    size_t hash = 0;
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      const FieldDescriptor* field = descriptor->field(i);
+      if (field->is_repeated() || ignored_fields_.contains(field)) continue;
+      if (field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE) {
+        if (!hash_message_presence_) continue;
+        if (!reflection->HasField(message, field)) {
+          hash = absl::HashOf(hash, field->number());
+          continue;
+        }
+      }
+      hash = absl::HashOf(hash, HashValue(message, field, -1));
+    }
+    return hash;
+  }
+
+  const absl::flat_hash_set<const FieldDescriptor*>& ignored_fields_;
+  const bool hash_floats_;
+  const bool hash_message_presence_;
+};
+
 }  // namespace
 
+bool MessageDifferencer::MatchRepeatedFieldIndicesByHash(
+    const Message& message1, const Message& message2, int unpacked_any,
+    const FieldDescriptor* repeated_field,
+    const MapKeyComparator* key_comparator,
+    const std::vector<SpecificField>& parent_fields, int start_offset,
+    bool early_return, std::vector<int>* match_list1,
+    std::vector<int>* match_list2, bool* success) {
+  // Custom comparators and ignore criteria may consider arbitrary values
+  // equal, so there is no hash that is consistent with them.
+  if (field_comparator_kind_ != kFCDefault || !ignore_criteria_.empty()) {
+    return false;
+  }
+  const std::vector<std::vector<const FieldDescriptor*> >* key_field_paths =
+      nullptr;
+  if (key_comparator != nullptr) {
+    // Only the comparators created by TreatAsMap*() are known to compare
+    // nothing but their key fields.
+    auto it = std::find(owned_key_comparators_.begin(),
+                        owned_key_comparators_.end(), key_comparator);
+    if (it == owned_key_comparators_.end()) return false;
+    key_field_paths =
+        &static_cast<const MultipleFieldsMapKeyComparator*>(key_comparator)
+             ->key_field_paths();
+  }
+
+  const ElementHasher hasher(
+      ignored_fields_,
+      field_comparator_.default_impl->float_comparison() ==
+          DefaultFieldComparator::EXACT,
+      message_field_comparison_ == EQUAL && !force_compare_no_presence_ &&
+          force_compare_no_presence_fields_.empty());
+
+  struct Bucket {
+    std::vector<int> indices;
+    // Entries before `next` have all been matched already.
+    size_t next = 0;
+  };
+  absl::flat_hash_map<size_t, Bucket> buckets;
+  const int count1 = static_cast<int>(match_list1->size());
+  const int count2 = static_cast<int>(match_list2->size());
+  for (int j = start_offset; j < count2; ++j) {
+    buckets[hasher.HashElement(message2, repeated_field, j, key_field_paths)]
+        .indices.push_back(j);
+  }
+
+  // Visits the same candidates in the same order as the full scan in
+  // MatchRepeatedFieldIndices(), minus those whose hash rules out a match, so
+  // the resulting matching is identical.
+  *success = true;
+  for (int i = start_offset; i < count1; ++i) {
+    int matched_j = -1;
+    auto it = buckets.find(
+        hasher.HashElement(message1, repeated_field, i, key_field_paths));
+    if (it != buckets.end()) {
+      Bucket& bucket = it->second;
+      while (bucket.next < bucket.indices.size() &&
+             match_list2->at(bucket.indices[bucket.next]) != -1) {
+        ++bucket.next;
+      }
+      for (size_t k = bucket.next; k < bucket.indices.size(); ++k) {
+        const int j = bucket.indices[k];
+        if (match_list2->at(j) != -1) continue;
+        if (IsMatch(repeated_field, key_comparator, &message1, &message2,
+                    unpacked_any, parent_fields, nullptr, i, j)) {
+          matched_j = j;
+          break;
+        }
+      }
+    }
+    if (matched_j != -1) {
+      match_list1->at(i) = matched_j;
+      match_list2->at(matched_j) = i;
+    } else {
+      *success = false;
+      if (early_return) break;
+    }
+  }
+  return true;
+}
+
 bool MessageDifferencer::MatchRepeatedFieldIndices(
     const Message& message1, const Message& message2, int unpacked_any,
     const FieldDescriptor* repeated_field,
@@ -1970,6 +2186,18 @@ bool MessageDifferencer::MatchRepeatedFieldIndices(
         }
       }
     }
+    // Comparing every remaining pair is quadratic; for larger fields, only
+    // compare elements whose hashes agree.
+    if (!is_treated_as_smart_set &&
+        count2 - start_offset >= kMinElementsToMatchByHash &&
+        MatchRepeatedFieldIndicesByHash(
+            message1, message2, unpacked_any, repeated_field, key_comparator,
+            parent_fields, start_offset, reporter == nullptr, match_list1,
+            match_list2, &success)) {
+      if (!success && reporter == nullptr) return false;
+      // Every element has been visited; skip the scan below.
+      start_offset = count1;
+    }
     for (int i = start_offset; i < count1; ++i) {
       // Indicates any matched elements for this repeated field.
       bool match = false;
@@ -921,6 +921,20 @@ class PROTOBUF_EXPORT MessageDifferencer {
       const std::vector<SpecificField>& parent_fields,
       std::vector<int>* match_list1, std::vector<int>* match_list2);
 
+  // Matches the elements of the repeated fields from start_offset on like the
+  // greedy scan in MatchRepeatedFieldIndices(), but only compares elements
+  // whose hashes agree.  Returns false, without touching the match lists, if
+  // the current settings could let elements with different hashes match.
+  // Otherwise sets *success to whether every element of message1 was matched,
+  // stopping at the first unmatched one if early_return is set.
+  bool MatchRepeatedFieldIndicesByHash(
+      const Message& message1, const Message& message2, int unpacked_any,
+      const FieldDescriptor* repeated_field,
+      const MapKeyComparator* key_comparator,
+      const std::vector<SpecificField>& parent_fields, int start_offset,
+      bool early_return, std::vector<int>* match_list1,
+      std::vector<int>* match_list2, bool* success);
+
   // Checks if index is equal to new_index in all the specific fields.
   static bool CheckPathChanged(const std::vector<SpecificField>& parent_fields);
 
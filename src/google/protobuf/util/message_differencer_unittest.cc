@@ -1998,6 +1998,55 @@ TEST(MessageDifferencerTest, RepeatedFieldSmartList_RecursivePerformance) {
   EXPECT_LE(comparator.compare_count(), kDepth * kDepth);
 }
 
+TEST(MessageDifferencerTest, RepeatedFieldSetTest_Large) {
+  // Large enough for elements to be matched by hash rather than by comparing
+  // every pair.
+  constexpr int kSize = 1000;
+  proto2_unittest::TestDiffMessage msg1;
+  proto2_unittest::TestDiffMessage msg2;
+  for (int i = 0; i < kSize; ++i) {
+    proto2_unittest::TestDiffMessage::Item* item = msg1.add_item();
+    item->set_a(i);
+    item->set_b(absl::StrCat(i));
+  }
+  for (int i = kSize - 1; i >= 0; --i) {
+    *msg2.add_item() = msg1.item(i);
+  }
+  // Duplicates must each find their own match.
+  *msg1.add_item() = msg1.item(0);
+  *msg2.add_item() = msg1.item(0);
+
+  util::MessageDifferencer differencer;
+  differencer.TreatAsSet(GetFieldDescriptor(msg1, "item"));
+  EXPECT_TRUE(differencer.Compare(msg1, msg2));
+
+  msg2.mutable_item(kSize - 1 - 500)->set_b("x");
+  EXPECT_FALSE(differencer.Compare(msg1, msg2));
+  std::string output;
+  differencer.set_report_moves(false);
+  differencer.ReportDifferencesToString(&output);
+  EXPECT_FALSE(differencer.Compare(msg1, msg2));
+  EXPECT_EQ(
+      "added: item[499]: { a: 500 b: \"x\" }\n"
+      "deleted: item[500]: { a: 500 b: \"500\" }\n",
+      output);
+
+  // Ignored fields must not affect which elements are matched.
+  util::MessageDifferencer differencer2;
+  differencer2.TreatAsSet(GetFieldDescriptor(msg1, "item"));
+  differencer2.IgnoreField(GetFieldDescriptor(msg1, "item.b"));
+  EXPECT_TRUE(differencer2.Compare(msg1, msg2));
+
+  util::MessageDifferencer differencer3;
+  differencer3.TreatAsMap(GetFieldDescriptor(msg1, "item"),
+                          GetFieldDescriptor(msg1, "item.a"));
+  output.clear();
+  differencer3.set_report_moves(false);
+  differencer3.ReportDifferencesToString(&output);
+  EXPECT_FALSE(differencer3.Compare(msg1, msg2));
+  EXPECT_EQ("modified: item[500].b: \"500\" -> \"x\"\n", output);
+}
+
 TEST(MessageDifferencerTest, RepeatedFieldMapTest_Partial) {
   proto2_unittest::TestDiffMessage msg1;
   // message msg1 {
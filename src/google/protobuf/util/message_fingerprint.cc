@@ -0,0 +1,655 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/util/message_fingerprint.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/arenastring.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/endian.h"
+#include "google/protobuf/extension_set.h"
+#include "google/protobuf/generated_message_tctable_decl.h"
+#include "google/protobuf/generated_message_tctable_impl.h"
+#include "google/protobuf/has_bits.h"
+#include "google/protobuf/inlined_string_field.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/map.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/message_lite.h"
+#include "google/protobuf/micro_string.h"
+#include "google/protobuf/repeated_field.h"
+#include "google/protobuf/repeated_ptr_field.h"
+#include "google/protobuf/unknown_field_set.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace util {
+namespace {
+
+using ::google::protobuf::internal::TcParser;
+using ::google::protobuf::internal::TcParseTableBase;
+using FieldEntry = TcParseTableBase::FieldEntry;
+namespace fl = ::google::protobuf::internal::field_layout;
+
+// Fingerprints must not depend on the process, so absl::Hash, which is
+// randomly seeded, can not be used.  This is CityHash's Hash128to64().
+constexpr uint64_t kSeed = 0x9ae16a3b2f90404fULL;
+
+inline uint64_t Mix(uint64_t hash, uint64_t value) {
+  constexpr uint64_t kMul = 0x9ddfea08eb382d69ULL;
+  uint64_t a = (value ^ hash) * kMul;
+  a ^= (a >> 47);
+  uint64_t b = (hash ^ a) * kMul;
+  b ^= (b >> 47);
+  return b * kMul;
+}
+
+// Hashes a byte string eight bytes at a time, independently of how it is
+// split across calls to Update().
+class ByteHasher {
+ public:
+  explicit ByteHasher(size_t size) : hash_(Mix(kSeed, size)) {}
+
+  void Update(absl::string_view bytes) {
+    const char* p = bytes.data();
+    const char* end = p + bytes.size();
+    while (p != end && pending_bytes_ != 0) Push(*p++);
+    for (; end - p >= 8; p += 8) {
+      uint64_t word;
+      memcpy(&word, p, sizeof(word));
+      hash_ = Mix(hash_, internal::little_endian::ToHost(word));
+    }
+    while (p != end) Push(*p++);
+  }
+
+  // The size is part of the seed, so zero-padding the tail is unambiguous.
+  uint64_t Finish() const {
+    return pending_bytes_ == 0 ? hash_ : Mix(hash_, pending_);
+  }
+
+ private:
+  void Push(char c) {
+    pending_ |= uint64_t{static_cast<uint8_t>(c)} << (8 * pending_bytes_);
+    if (++pending_bytes_ == 8) {
+      hash_ = Mix(hash_, pending_);
+      pending_ = 0;
+      pending_bytes_ = 0;
+    }
+  }
+
+  uint64_t hash_;
+  uint64_t pending_ = 0;
+  int pending_bytes_ = 0;
+};
+
+uint64_t HashBytes(absl::string_view bytes) {
+  ByteHasher hasher(bytes.size());
+  hasher.Update(bytes);
+  return hasher.Finish();
+}
+
+uint64_t HashCord(const absl::Cord& cord) {
+  ByteHasher hasher(cord.size());
+  for (absl::string_view chunk : cord.Chunks()) hasher.Update(chunk);
+  return hasher.Finish();
+}
+
+const TcParseTableBase* GetTable(const Message& msg) {
+  const internal::ClassData* data = internal::GetClassData(msg);
+  if (data->tc_table != nullptr) return data->tc_table;
+  return data->full().descriptor_methods->get_tc_table(msg);
+}
+
+// Calls `f(entry, field_number)` for every field entry of `table`, in field
+// number order, until `f` returns false.  Returns whether it never did.  This
+// walks the same lookup structures as TcParser::FieldNumber().
+template <typename F>
+bool ForEachField(const TcParseTableBase* table, F f) {
+  const FieldEntry* entry = table->field_entries_begin();
+  const auto visit_bitmap = [&](uint32_t field_bitmap,
+                                uint32_t base_field_number) {
+    for (; field_bitmap != 0; field_bitmap &= field_bitmap - 1) {
+      if (!f(*entry++, base_field_number + absl::countr_zero(field_bitmap))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!visit_bitmap(~table->skipmap32, 1)) return false;
+
+  for (const uint16_t* lookup_table = table->field_lookup_begin();
+       lookup_table[0] != 0xFFFF || lookup_table[1] != 0xFFFF;) {
+    uint32_t fstart = lookup_table[0] | (lookup_table[1] << 16);
+    lookup_table += 2;
+    const uint16_t num_skip_entries = *lookup_table++;
+    for (uint16_t i = 0; i < num_skip_entries; ++i) {
+      if (!visit_bitmap(static_cast<uint16_t>(~*lookup_table),
+                        fstart + 16 * i)) {
+        return false;
+      }
+      lookup_table += 2;
+    }
+  }
+  return true;
+}
+
+// Returns whether the fields described by `entry` can be read directly.  This
+// only depends on the message type, never on the message's contents, so every
+// message of a type takes the same path.
+bool IsSupported(const FieldEntry& entry) {
+  const uint16_t type_card = entry.type_card;
+  const uint16_t rep = type_card & fl::kRepMask;
+  switch (type_card & fl::kFkMask) {
+    case fl::kFkVarint:
+    case fl::kFkPackedVarint:
+    case fl::kFkFixed:
+    case fl::kFkPackedFixed:
+      return true;
+    case fl::kFkString:
+      if ((type_card & fl::kFcMask) == fl::kFcRepeated) {
+        return rep == fl::kRepSString || rep == fl::kRepCord;
+      }
+      return rep == fl::kRepAString || rep == fl::kRepIString ||
+             rep == fl::kRepMString || rep == fl::kRepCord;
+    case fl::kFkMessage:
+      // Lazy fields may hold unparsed bytes.
+      return rep == fl::kRepMessage || rep == fl::kRepGroup;
+    case fl::kFkMap:
+      return true;
+    default:
+      // Weak fields have no type card and are parsed by the fallback.
+      return false;
+  }
+}
+
+// Unknown fields and extensions are not described by the table; messages with
+// either are compared by their serialized form.  Reading the unknown fields
+// only loads the internal metadata.
+bool NeedsSerialization(const Message& msg, const TcParseTableBase* table) {
+  if (!msg.GetReflection()->GetUnknownFields(msg).empty()) return true;
+  return table->extension_offset != 0 &&
+         !TcParser::RefAt<internal::ExtensionSet>(&msg,
+                                                  table->extension_offset)
+              .IsEmpty();
+}
+
+std::string SerializeDeterministically(const Message& msg) {
+  std::string bytes;
+  io::StringOutputStream output(&bytes);
+  io::CodedOutputStream coded_output(&output);
+  coded_output.SetSerializationDeterministic(true);
+  msg.SerializePartialToCodedStream(&coded_output);
+  coded_output.Trim();
+  return bytes;
+}
+
+// Returns the object holding the field: the message itself, or its split
+// part for split fields.
+const void* FieldBase(const Message& msg, const TcParseTableBase* table,
+                      const FieldEntry& entry) {
+  if ((entry.type_card & fl::kSplitMask) == fl::kSplitFalse) return &msg;
+  return TcParser::RefAt<const void*>(
+      &msg, table->field_aux(internal::kSplitOffsetAuxIdx)->offset);
+}
+
+bool IsSplit(const FieldEntry& entry) {
+  return (entry.type_card & fl::kSplitMask) == fl::kSplitTrue;
+}
+
+// A singular string value, either flat or a Cord.  Both values of a field
+// always have the same representation.
+struct StringValue {
+  absl::string_view flat;
+  const absl::Cord* cord = nullptr;
+
+  bool empty() const { return cord != nullptr ? cord->empty() : flat.empty(); }
+  bool operator==(const StringValue& other) const {
+    return cord != nullptr ? *cord == *other.cord : flat == other.flat;
+  }
+  uint64_t Hash() const {
+    return cord != nullptr ? HashCord(*cord) : HashBytes(flat);
+  }
+};
+
+StringValue GetString(const void* base, const FieldEntry& entry) {
+  switch (entry.type_card & fl::kRepMask) {
+    case fl::kRepAString:
+      return {TcParser::RefAt<internal::ArenaStringPtr>(base, entry.offset)
+                  .Get()};
+    case fl::kRepIString:
+      return {TcParser::RefAt<internal::InlinedStringField>(base, entry.offset)
+                  .Get()};
+    case fl::kRepMString:
+      return {TcParser::RefAt<internal::MicroString>(base, entry.offset).Get()};
+    case fl::kRepCord:
+      // Oneof Cords are allocated separately.
+      if ((entry.type_card & fl::kFcMask) == fl::kFcOneof) {
+        return {{}, TcParser::RefAt<const absl::Cord*>(base, entry.offset)};
+      }
+      return {{}, &TcParser::RefAt<absl::Cord>(base, entry.offset)};
+    default:
+      internal::Unreachable();
+  }
+}
+
+const Message* GetMessage(const void* base, const FieldEntry& entry) {
+  return DownCastMessage<Message>(
+      TcParser::RefAt<const MessageLite*>(base, entry.offset));
+}
+
+// Numeric values are compared and hashed by their bits, zero-extended to 64
+// bits.
+uint64_t GetNumber(const void* base, const FieldEntry& entry) {
+  switch (entry.type_card & fl::kRepMask) {
+    case fl::kRep8Bits:
+      return TcParser::RefAt<uint8_t>(base, entry.offset);
+    case fl::kRep32Bits:
+      return TcParser::RefAt<uint32_t>(base, entry.offset);
+    default:
+      return TcParser::RefAt<uint64_t>(base, entry.offset);
+  }
+}
+
+bool HoldsZeroValue(const void* base, const FieldEntry& entry) {
+  switch (entry.type_card & fl::kFkMask) {
+    case fl::kFkString:
+      return GetString(base, entry).empty();
+    case fl::kFkMessage:
+      return TcParser::RefAt<const MessageLite*>(base, entry.offset) == nullptr;
+    default:
+      return GetNumber(base, entry) == 0;
+  }
+}
+
+// Returns whether a non-repeated field is set.  Fields without presence are
+// set unless they hold their zero value, which is also what decides whether
+// they are serialized.
+bool IsPresent(const Message& msg, const void* base, const FieldEntry& entry,
+               uint32_t field_number) {
+  switch (entry.type_card & fl::kFcMask) {
+    case fl::kFcOneof:
+      // The _oneof_case_ value offset is stored in the has-bit index.
+      return TcParser::RefAt<uint32_t>(&msg, entry.has_idx) == field_number;
+    case fl::kFcOptional:
+      if (entry.has_idx != internal::kNoHasbit) {
+        const auto has_idx = static_cast<uint32_t>(entry.has_idx);
+        if (((TcParser::RefAt<uint32_t>(&msg, has_idx / 32 * 4) >>
+              (has_idx % 32)) &
+             1) == 0) {
+          return false;
+        }
+        // Fields without presence may also have a has-bit, which is only a
+        // hint: set_x(0) sets it too.  The descriptor is only consulted for
+        // zero values, which is where the two kinds of fields differ.
+        return !HoldsZeroValue(base, entry) ||
+               msg.GetDescriptor()->FindFieldByNumber(field_number)
+                   ->has_presence();
+      }
+      break;
+    default:
+      break;
+  }
+  return !HoldsZeroValue(base, entry);
+}
+
+// A map entry with its key and value reduced to bits, bytes or a message.
+struct MapEntryValue {
+  uint64_t key_number = 0;
+  absl::string_view key_string;
+  uint64_t value_number = 0;
+  absl::string_view value_string;
+  const Message* value_message = nullptr;
+};
+
+template <typename T>
+void SetMapValue(const T& value, uint64_t& number, absl::string_view& string,
+                 const Message** message) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    string = value;
+  } else if constexpr (std::is_same_v<T, MessageLite>) {
+    *message = DownCastMessage<Message>(&value);
+  } else if constexpr (std::is_same_v<T, float>) {
+    number = absl::bit_cast<uint32_t>(value);
+  } else if constexpr (std::is_same_v<T, double>) {
+    number = absl::bit_cast<uint64_t>(value);
+  } else {
+    number = static_cast<uint64_t>(value);
+  }
+}
+
+std::vector<MapEntryValue> GetMapEntries(const internal::UntypedMapBase& map) {
+  std::vector<MapEntryValue> entries;
+  entries.reserve(map.size());
+  map.VisitAllNodes([&](const auto* key, const auto* value) {
+    MapEntryValue& entry = entries.emplace_back();
+    const Message* unused = nullptr;
+    SetMapValue(*key, entry.key_number, entry.key_string, &unused);
+    SetMapValue(*value, entry.value_number, entry.value_string,
+                &entry.value_message);
+  });
+  return entries;
+}
+
+uint64_t Fingerprint(const Message& msg);
+bool Equals(const Message& msg1, const Message& msg2);
+
+uint64_t HashMapEntry(const MapEntryValue& entry) {
+  uint64_t hash =
+      Mix(Mix(kSeed, entry.key_number), HashBytes(entry.key_string));
+  hash = Mix(Mix(hash, entry.value_number), HashBytes(entry.value_string));
+  if (entry.value_message != nullptr) {
+    hash = Mix(hash, Fingerprint(*entry.value_message));
+  }
+  return hash;
+}
+
+bool MapsEqual(const internal::UntypedMapBase& map1,
+               const internal::UntypedMapBase& map2) {
+  if (map1.size() != map2.size()) return false;
+  std::vector<MapEntryValue> entries1 = GetMapEntries(map1);
+  std::vector<MapEntryValue> entries2 = GetMapEntries(map2);
+  const auto by_key = [](const MapEntryValue& a, const MapEntryValue& b) {
+    if (a.key_number != b.key_number) return a.key_number < b.key_number;
+    return a.key_string < b.key_string;
+  };
+  std::sort(entries1.begin(), entries1.end(), by_key);
+  std::sort(entries2.begin(), entries2.end(), by_key);
+  for (size_t i = 0; i < entries1.size(); ++i) {
+    const MapEntryValue& a = entries1[i];
+    const MapEntryValue& b = entries2[i];
+    if (a.key_number != b.key_number || a.key_string != b.key_string ||
+        a.value_number != b.value_number || a.value_string != b.value_string) {
+      return false;
+    }
+    if (a.value_message != nullptr &&
+        !Equals(*a.value_message, *b.value_message)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+uint64_t HashRepeatedNumbers(const RepeatedField<T>& field) {
+  uint64_t hash = Mix(kSeed, field.size());
+  for (T value : field) hash = Mix(hash, value);
+  return hash;
+}
+
+// Hashes a set field.
+uint64_t HashField(const Message& msg, const void* base,
+                   const FieldEntry& entry) {
+  const bool is_split = IsSplit(entry);
+  const uint16_t type_card = entry.type_card;
+  if ((type_card & fl::kFcMask) != fl::kFcRepeated &&
+      (type_card & fl::kFkMask) != fl::kFkMap) {
+    switch (type_card & fl::kFkMask) {
+      case fl::kFkString:
+        return GetString(base, entry).Hash();
+      case fl::kFkMessage:
+        return Fingerprint(*GetMessage(base, entry));
+      default:
+        return GetNumber(base, entry);
+    }
+  }
+
+  switch (type_card & fl::kFkMask) {
+    case fl::kFkString: {
+      uint64_t hash;
+      if ((type_card & fl::kRepMask) == fl::kRepCord) {
+        const auto& field =
+            TcParser::GetRepeatedFieldAt<RepeatedField<absl::Cord>>(
+                base, entry.offset, &msg, is_split);
+        hash = Mix(kSeed, field.size());
+        for (const absl::Cord& value : field) hash = Mix(hash, HashCord(value));
+      } else {
+        const auto& field =
+            TcParser::GetRepeatedFieldAt<RepeatedPtrField<std::string>>(
+                base, entry.offset, &msg, is_split);
+        hash = Mix(kSeed, field.size());
+        for (const std::string& value : field) {
+          hash = Mix(hash, HashBytes(value));
+        }
+      }
+      return hash;
+    }
+    case fl::kFkMessage: {
+      const auto& field =
+          TcParser::GetRepeatedFieldAt<RepeatedPtrField<Message>>(
+              base, entry.offset, &msg, is_split);
+      uint64_t hash = Mix(kSeed, field.size());
+      for (const Message& value : field) hash = Mix(hash, Fingerprint(value));
+      return hash;
+    }
+    case fl::kFkMap: {
+      // Summing the entry hashes makes the result independent of their order.
+      uint64_t hash = 0;
+      for (const MapEntryValue& map_entry :
+           GetMapEntries(TcParser::GetMapFieldAt(base, entry.offset, &msg))) {
+        hash += HashMapEntry(map_entry);
+      }
+      return hash;
+    }
+    default:
+      switch (type_card & fl::kRepMask) {
+        case fl::kRep8Bits:
+          return HashRepeatedNumbers(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint8_t>>(
+                  base, entry.offset, &msg, is_split));
+        case fl::kRep32Bits:
+          return HashRepeatedNumbers(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint32_t>>(
+                  base, entry.offset, &msg, is_split));
+        default:
+          return HashRepeatedNumbers(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint64_t>>(
+                  base, entry.offset, &msg, is_split));
+      }
+  }
+}
+
+bool IsEmptyRepeated(const Message& msg, const void* base,
+                     const FieldEntry& entry) {
+  const bool is_split = IsSplit(entry);
+  switch (entry.type_card & fl::kFkMask) {
+    case fl::kFkString:
+      if ((entry.type_card & fl::kRepMask) == fl::kRepCord) {
+        return TcParser::GetRepeatedFieldAt<RepeatedField<absl::Cord>>(
+                   base, entry.offset, &msg, is_split)
+            .empty();
+      }
+      return TcParser::GetRepeatedFieldAt<RepeatedPtrField<std::string>>(
+                 base, entry.offset, &msg, is_split)
+          .empty();
+    case fl::kFkMessage:
+      return TcParser::GetRepeatedFieldAt<RepeatedPtrField<Message>>(
+                 base, entry.offset, &msg, is_split)
+          .empty();
+    case fl::kFkMap:
+      return TcParser::GetMapFieldAt(base, entry.offset, &msg).empty();
+    default:
+      switch (entry.type_card & fl::kRepMask) {
+        case fl::kRep8Bits:
+          return TcParser::GetRepeatedFieldAt<RepeatedField<uint8_t>>(
+                     base, entry.offset, &msg, is_split)
+              .empty();
+        case fl::kRep32Bits:
+          return TcParser::GetRepeatedFieldAt<RepeatedField<uint32_t>>(
+                     base, entry.offset, &msg, is_split)
+              .empty();
+        default:
+          return TcParser::GetRepeatedFieldAt<RepeatedField<uint64_t>>(
+                     base, entry.offset, &msg, is_split)
+              .empty();
+      }
+  }
+}
+
+bool IsRepeated(const FieldEntry& entry) {
+  return (entry.type_card & fl::kFcMask) == fl::kFcRepeated ||
+         (entry.type_card & fl::kFkMask) == fl::kFkMap;
+}
+
+uint64_t Fingerprint(const Message& msg) {
+  const TcParseTableBase* table = GetTable(msg);
+  if (!NeedsSerialization(msg, table)) {
+    uint64_t hash = kSeed;
+    const bool supported =
+        ForEachField(table, [&](const FieldEntry& entry, uint32_t number) {
+          if (!IsSupported(entry)) return false;
+          const void* base = FieldBase(msg, table, entry);
+          // Unset and empty fields do not contribute, so that adding fields
+          // to a message type does not change the fingerprint of existing
+          // messages.
+          if (IsRepeated(entry) ? IsEmptyRepeated(msg, base, entry)
+                                : !IsPresent(msg, base, entry, number)) {
+            return true;
+          }
+          hash = Mix(hash, Mix(number, HashField(msg, base, entry)));
+          return true;
+        });
+    if (supported) return hash;
+  }
+  return HashBytes(SerializeDeterministically(msg));
+}
+
+template <typename T>
+bool RepeatedEqual(const T& field1, const T& field2) {
+  return std::equal(field1.begin(), field1.end(), field2.begin(), field2.end());
+}
+
+// Compares a field that is set in both messages, or a repeated field.
+bool FieldsEqual(const Message& msg1, const void* base1, const Message& msg2,
+                 const void* base2, const FieldEntry& entry) {
+  const bool is_split = IsSplit(entry);
+  const uint16_t type_card = entry.type_card;
+  if (!IsRepeated(entry)) {
+    switch (type_card & fl::kFkMask) {
+      case fl::kFkString:
+        return GetString(base1, entry) == GetString(base2, entry);
+      case fl::kFkMessage:
+        return Equals(*GetMessage(base1, entry), *GetMessage(base2, entry));
+      default:
+        return GetNumber(base1, entry) == GetNumber(base2, entry);
+    }
+  }
+
+  switch (type_card & fl::kFkMask) {
+    case fl::kFkString:
+      if ((type_card & fl::kRepMask) == fl::kRepCord) {
+        return RepeatedEqual(
+            TcParser::GetRepeatedFieldAt<RepeatedField<absl::Cord>>(
+                base1, entry.offset, &msg1, is_split),
+            TcParser::GetRepeatedFieldAt<RepeatedField<absl::Cord>>(
+                base2, entry.offset, &msg2, is_split));
+      }
+      return RepeatedEqual(
+          TcParser::GetRepeatedFieldAt<RepeatedPtrField<std::string>>(
+              base1, entry.offset, &msg1, is_split),
+          TcParser::GetRepeatedFieldAt<RepeatedPtrField<std::string>>(
+              base2, entry.offset, &msg2, is_split));
+    case fl::kFkMessage: {
+      const auto& field1 =
+          TcParser::GetRepeatedFieldAt<RepeatedPtrField<Message>>(
+              base1, entry.offset, &msg1, is_split);
+      const auto& field2 =
+          TcParser::GetRepeatedFieldAt<RepeatedPtrField<Message>>(
+              base2, entry.offset, &msg2, is_split);
+      if (field1.size() != field2.size()) return false;
+      for (int i = 0; i < field1.size(); ++i) {
+        if (!Equals(field1.Get(i), field2.Get(i))) return false;
+      }
+      return true;
+    }
+    case fl::kFkMap:
+      return MapsEqual(TcParser::GetMapFieldAt(base1, entry.offset, &msg1),
+                       TcParser::GetMapFieldAt(base2, entry.offset, &msg2));
+    default:
+      switch (type_card & fl::kRepMask) {
+        case fl::kRep8Bits:
+          return RepeatedEqual(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint8_t>>(
+                  base1, entry.offset, &msg1, is_split),
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint8_t>>(
+                  base2, entry.offset, &msg2, is_split));
+        case fl::kRep32Bits:
+          return RepeatedEqual(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint32_t>>(
+                  base1, entry.offset, &msg1, is_split),
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint32_t>>(
+                  base2, entry.offset, &msg2, is_split));
+        default:
+          return RepeatedEqual(
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint64_t>>(
+                  base1, entry.offset, &msg1, is_split),
+              TcParser::GetRepeatedFieldAt<RepeatedField<uint64_t>>(
+                  base2, entry.offset, &msg2, is_split));
+      }
+  }
+}
+
+bool Equals(const Message& msg1, const Message& msg2) {
+  if (&msg1 == &msg2) return true;
+  // A generated message and a DynamicMessage of the same type have different
+  // layouts.
+  if (internal::GetClassData(msg1) != internal::GetClassData(msg2)) {
+    return msg1.GetDescriptor() == msg2.GetDescriptor() &&
+           SerializeDeterministically(msg1) == SerializeDeterministically(msg2);
+  }
+  const TcParseTableBase* table = GetTable(msg1);
+  if (!NeedsSerialization(msg1, table) && !NeedsSerialization(msg2, table)) {
+    bool equal = true;
+    const bool supported =
+        ForEachField(table, [&](const FieldEntry& entry, uint32_t number) {
+          if (!IsSupported(entry)) return false;
+          const void* base1 = FieldBase(msg1, table, entry);
+          const void* base2 = FieldBase(msg2, table, entry);
+          if (!IsRepeated(entry)) {
+            const bool present = IsPresent(msg1, base1, entry, number);
+            if (present != IsPresent(msg2, base2, entry, number)) {
+              equal = false;
+              return false;
+            }
+            if (!present) return true;
+          }
+          equal = FieldsEqual(msg1, base1, msg2, base2, entry);
+          return equal;
+        });
+    if (supported || !equal) return equal;
+  }
+  return SerializeDeterministically(msg1) == SerializeDeterministically(msg2);
+}
+
+}  // namespace
+
+bool MessageBinaryEquals(const Message& message1, const Message& message2) {
+  return Equals(message1, message2);
+}
+
+uint64_t MessageFingerprint(const Message& message) {
+  return Fingerprint(message);
+}
+
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
@@ -0,0 +1,56 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// Fast equality checks and fingerprints for messages.
+//
+// Unlike MessageDifferencer, these functions do not walk the message through
+// reflection.  They read fields directly from memory, using the same layout
+// tables the parser uses, which makes them suitable for hot paths such as
+// deduplication and caching.
+
+#ifndef GOOGLE_PROTOBUF_UTIL_MESSAGE_FINGERPRINT_H__
+#define GOOGLE_PROTOBUF_UTIL_MESSAGE_FINGERPRINT_H__
+
+#include <cstdint>
+
+#include "google/protobuf/message.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+namespace util {
+
+// Returns true if the two messages have the same type and the same contents,
+// that is, if they would produce the same bytes under deterministic
+// serialization.  In particular:
+//  - Fields without presence that hold their default value are the same as
+//    unset fields.
+//  - Floating point values are compared bitwise, so NaN equals NaN with the
+//    same payload, but 0.0 and -0.0 differ.
+//  - Map entries are compared regardless of their order.
+//  - Unknown fields and extensions are compared too.
+PROTOBUF_EXPORT bool MessageBinaryEquals(const Message& message1,
+                                         const Message& message2);
+
+// Returns a 64-bit fingerprint of the message.  Messages for which
+// MessageBinaryEquals() returns true have the same fingerprint.
+//
+// The fingerprint depends only on the message's field numbers and values, not
+// on its memory layout, on map iteration order or on the process computing
+// it.  It may change between releases of this library, so it should not be
+// stored permanently.
+PROTOBUF_EXPORT uint64_t MessageFingerprint(const Message& message);
+
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_UTIL_MESSAGE_FINGERPRINT_H__
@@ -0,0 +1,192 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/util/message_fingerprint.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/map_test_util.h"
+#include "google/protobuf/map_unittest.pb.h"
+#include "google/protobuf/message.h"
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/unittest_proto3.pb.h"
+#include "google/protobuf/unittest_proto3_optional.pb.h"
+
+namespace google {
+namespace protobuf {
+namespace util {
+namespace {
+
+void ExpectEqual(const Message& message1, const Message& message2) {
+  EXPECT_TRUE(MessageBinaryEquals(message1, message2));
+  EXPECT_TRUE(MessageBinaryEquals(message2, message1));
+  EXPECT_EQ(MessageFingerprint(message1), MessageFingerprint(message2));
+}
+
+void ExpectNotEqual(const Message& message1, const Message& message2) {
+  EXPECT_FALSE(MessageBinaryEquals(message1, message2));
+  EXPECT_FALSE(MessageBinaryEquals(message2, message1));
+  EXPECT_NE(MessageFingerprint(message1), MessageFingerprint(message2));
+}
+
+TEST(MessageFingerprintTest, AllFields) {
+  proto2_unittest::TestAllTypes message1;
+  proto2_unittest::TestAllTypes message2;
+  ExpectEqual(message1, message2);
+
+  TestUtil::SetAllFields(&message1);
+  ExpectNotEqual(message1, message2);
+  TestUtil::SetAllFields(&message2);
+  ExpectEqual(message1, message2);
+
+  message2.set_optional_int32(message2.optional_int32() + 1);
+  ExpectNotEqual(message1, message2);
+  message2.set_optional_int32(message1.optional_int32());
+
+  message2.mutable_repeated_string()->Add("extra");
+  ExpectNotEqual(message1, message2);
+  message2.mutable_repeated_string()->RemoveLast();
+
+  message2.mutable_optional_nested_message()->set_bb(-1);
+  ExpectNotEqual(message1, message2);
+  message2.mutable_optional_nested_message()->set_bb(
+      message1.optional_nested_message().bb());
+
+  message2.set_oneof_string("oneof");
+  ExpectNotEqual(message1, message2);
+  message1.set_oneof_string("oneof");
+  ExpectEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, ExplicitPresence) {
+  proto2_unittest::TestAllTypes message1;
+  proto2_unittest::TestAllTypes message2;
+  // A field set to its default value is still set.
+  message1.set_optional_int32(0);
+  ExpectNotEqual(message1, message2);
+  message1.mutable_optional_nested_message();
+  message2.set_optional_int32(0);
+  ExpectNotEqual(message1, message2);
+  message2.mutable_optional_nested_message();
+  ExpectEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, ImplicitPresence) {
+  proto3_unittest::TestAllTypes message1;
+  proto3_unittest::TestAllTypes message2;
+  // Without presence, a zero value is the same as an unset field.
+  message1.set_optional_int32(0);
+  message1.set_optional_string("");
+  ExpectEqual(message1, message2);
+
+  message1.set_optional_int32(1);
+  ExpectNotEqual(message1, message2);
+  message2.set_optional_int32(1);
+  ExpectEqual(message1, message2);
+
+  // -0.0 is serialized, so it differs from an unset field.
+  message1.set_optional_double(-0.0);
+  ExpectNotEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, ExplicitPresenceInProto3) {
+  proto2_unittest::TestProto3Optional message1;
+  proto2_unittest::TestProto3Optional message2;
+  // An explicitly set zero is serialized, so it differs from an unset field.
+  message1.set_optional_int32(0);
+  message1.set_optional_string("");
+  ExpectNotEqual(message1, message2);
+  message2.set_optional_int32(0);
+  ExpectNotEqual(message1, message2);
+  message2.set_optional_string("");
+  ExpectEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, MapOrderIsIgnored) {
+  proto2_unittest::TestMap message1;
+  proto2_unittest::TestMap message2;
+  for (int i = 0; i < 100; ++i) {
+    (*message1.mutable_map_int32_int32())[i] = i * 2;
+    (*message1.mutable_map_string_string())[std::to_string(i)] = "value";
+    (*message1.mutable_map_int32_foreign_message())[i].set_c(i);
+  }
+  for (int i = 99; i >= 0; --i) {
+    (*message2.mutable_map_int32_int32())[i] = i * 2;
+    (*message2.mutable_map_string_string())[std::to_string(i)] = "value";
+    (*message2.mutable_map_int32_foreign_message())[i].set_c(i);
+  }
+  ExpectEqual(message1, message2);
+
+  (*message2.mutable_map_int32_foreign_message())[50].set_c(-1);
+  ExpectNotEqual(message1, message2);
+  (*message2.mutable_map_int32_foreign_message())[50].set_c(50);
+  (*message2.mutable_map_string_string())["50"] = "other";
+  ExpectNotEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, AllMapFields) {
+  proto2_unittest::TestMap message1;
+  proto2_unittest::TestMap message2;
+  MapTestUtil::SetMapFields(&message1);
+  MapTestUtil::SetMapFields(&message2);
+  ExpectEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, UnknownFields) {
+  proto2_unittest::TestAllTypes message1;
+  proto2_unittest::TestAllTypes message2;
+  TestUtil::SetAllFields(&message1);
+  TestUtil::SetAllFields(&message2);
+  message1.mutable_unknown_fields()->AddVarint(12345, 1);
+  ExpectNotEqual(message1, message2);
+  message2.mutable_unknown_fields()->AddVarint(12345, 1);
+  ExpectEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, Extensions) {
+  proto2_unittest::TestAllExtensions message1;
+  proto2_unittest::TestAllExtensions message2;
+  TestUtil::SetAllExtensions(&message1);
+  ExpectNotEqual(message1, message2);
+  TestUtil::SetAllExtensions(&message2);
+  ExpectEqual(message1, message2);
+  message2.SetExtension(proto2_unittest::optional_int32_extension, -1);
+  ExpectNotEqual(message1, message2);
+}
+
+TEST(MessageFingerprintTest, DynamicMessage) {
+  proto2_unittest::TestAllTypes generated;
+  TestUtil::SetAllFields(&generated);
+
+  DynamicMessageFactory factory;
+  std::unique_ptr<Message> dynamic1(
+      factory.GetPrototype(proto2_unittest::TestAllTypes::descriptor())->New());
+  std::unique_ptr<Message> dynamic2(dynamic1->New());
+  ASSERT_TRUE(dynamic1->ParseFromString(generated.SerializeAsString()));
+  ASSERT_TRUE(dynamic2->ParseFromString(generated.SerializeAsString()));
+
+  ExpectEqual(*dynamic1, *dynamic2);
+  ExpectEqual(generated, *dynamic1);
+
+  generated.set_optional_int32(-1);
+  ExpectNotEqual(generated, *dynamic1);
+}
+
+TEST(MessageFingerprintTest, DifferentTypes) {
+  proto2_unittest::TestAllTypes message1;
+  proto2_unittest::TestAllExtensions message2;
+  EXPECT_FALSE(MessageBinaryEquals(message1, message2));
+}
+
+}  // namespace
+}  // namespace util
+}  // namespace protobuf
+}  // namespace google
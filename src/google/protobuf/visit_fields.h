@@ -0,0 +1,65 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+// VisitFields() calls a visitor for each present field of a generated message,
+// without going through reflection.  The list of fields is generated into each
+// message class, so a call expands into direct calls of the field accessors
+// and the visitor is instantiated separately for each field:
+//
+//   size_t hash = 0;
+//   google::protobuf::VisitFields(msg, [&](auto info) {
+//     if constexpr (!info.is_repeated && !info.is_map &&
+//                   info.type() != WireFormatLite::TYPE_MESSAGE &&
+//                   info.type() != WireFormatLite::TYPE_GROUP) {
+//       hash = absl::HashOf(hash, info.number(), info.Get());
+//     }
+//   });
+//
+// The visitor receives a small object, best taken by value so that its
+// static members can be used in `if constexpr`, with the following members:
+//
+//   static constexpr int number();
+//   static constexpr WireFormatLite::FieldType type();
+//   absl::string_view name() const;      // The name of the field in the .proto.
+//   const ValueT& Get() const;           // What the getter of the field returns.
+//   void Clear() const;                  // Only for a non-const message.
+//   static constexpr bool is_repeated, is_map, is_extension, is_oneof;
+//
+// Fields are visited in declaration order.  A field is present if it would be
+// serialized: singular fields with presence that are set, singular fields
+// without presence that don't have their default value, non-empty repeated and
+// map fields and the set member of a oneof.  Extensions, unknown fields and
+// weak fields are not visited.
+//
+// This is the compile-time counterpart of the reflection-based
+// internal::VisitFields() in reflection_visit_fields.h, and works for lite
+// messages too.
+
+#ifndef GOOGLE_PROTOBUF_VISIT_FIELDS_H__
+#define GOOGLE_PROTOBUF_VISIT_FIELDS_H__
+
+#include <type_traits>
+
+#include "google/protobuf/generated_message_util.h"
+
+// Must be included last.
+#include "google/protobuf/port_def.inc"
+
+namespace google {
+namespace protobuf {
+
+template <typename MessageT, typename VisitorT>
+void VisitFields(MessageT& message, VisitorT&& visitor) {
+  std::remove_const_t<MessageT>::_InternalVisitFields(message, visitor);
+}
+
+}  // namespace protobuf
+}  // namespace google
+
+#include "google/protobuf/port_undef.inc"
+
+#endif  // GOOGLE_PROTOBUF_VISIT_FIELDS_H__
@@ -0,0 +1,173 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2008 Google Inc.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "google/protobuf/visit_fields.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "google/protobuf/descriptor.h"
+#include "google/protobuf/descriptor.pb.h"
+#include "google/protobuf/duration.pb.h"
+#include "google/protobuf/map_unittest.pb.h"
+#include "google/protobuf/struct.pb.h"
+#include "google/protobuf/test_util.h"
+#include "google/protobuf/unittest.pb.h"
+#include "google/protobuf/unittest_proto3.pb.h"
+#include "google/protobuf/wire_format_lite.h"
+
+namespace google {
+namespace protobuf {
+namespace {
+
+using ::proto2_unittest::TestAllTypes;
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using internal::WireFormatLite;
+
+template <typename MessageT>
+std::vector<int> VisitedNumbers(MessageT& message) {
+  std::vector<int> numbers;
+  VisitFields(message, [&](auto info) { numbers.push_back(info.number()); });
+  return numbers;
+}
+
+TEST(VisitFieldsTest, VisitsPresentFieldsInDeclarationOrder) {
+  TestAllTypes message;
+  EXPECT_THAT(VisitedNumbers(message), ElementsAre());
+
+  message.add_repeated_int32(1);
+  message.mutable_optional_nested_message();
+  message.set_optional_string("foo");
+  message.set_optional_int32(0);
+  EXPECT_THAT(VisitedNumbers(message), ElementsAre(1, 14, 18, 31));
+}
+
+TEST(VisitFieldsTest, MatchesListFields) {
+  TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+
+  std::vector<const FieldDescriptor*> fields;
+  message.GetReflection()->ListFields(message, &fields);
+  std::vector<int> expected;
+  for (const FieldDescriptor* field : fields) {
+    expected.push_back(field->number());
+  }
+  std::vector<int> visited = VisitedNumbers(message);
+  std::sort(visited.begin(), visited.end());
+  EXPECT_THAT(visited, ElementsAreArray(expected));
+}
+
+TEST(VisitFieldsTest, FieldInfo) {
+  TestAllTypes message;
+  message.set_optional_int32(7);
+  message.set_optional_string("foo");
+  message.add_repeated_int32(1);
+  message.add_repeated_int32(2);
+  message.set_oneof_uint32(3);
+
+  int visited = 0;
+  VisitFields(message, [&](auto info) {
+    ++visited;
+    EXPECT_FALSE(info.is_extension);
+    EXPECT_FALSE(info.is_map);
+    if constexpr (info.number() == 1) {
+      EXPECT_EQ(info.type(), WireFormatLite::TYPE_INT32);
+      EXPECT_EQ(info.name(), "optional_int32");
+      EXPECT_EQ(info.Get(), 7);
+      EXPECT_FALSE(info.is_repeated);
+      EXPECT_FALSE(info.is_oneof);
+    } else if constexpr (info.number() == 14) {
+      EXPECT_EQ(info.type(), WireFormatLite::TYPE_STRING);
+      EXPECT_EQ(info.Get(), "foo");
+    } else if constexpr (info.number() == 31) {
+      EXPECT_TRUE(info.is_repeated);
+      EXPECT_THAT(info.Get(), ElementsAre(1, 2));
+    } else if constexpr (info.number() == 111) {
+      EXPECT_EQ(info.type(), WireFormatLite::TYPE_UINT32);
+      EXPECT_TRUE(info.is_oneof);
+      EXPECT_EQ(info.Get(), 3);
+    } else {
+      ADD_FAILURE() << info.number();
+    }
+  });
+  EXPECT_EQ(visited, 4);
+}
+
+TEST(VisitFieldsTest, Map) {
+  proto2_unittest::TestMap message;
+  (*message.mutable_map_int32_int32())[1] = 2;
+
+  int visited = 0;
+  VisitFields(message, [&](auto info) {
+    ++visited;
+    EXPECT_TRUE(info.is_map);
+    EXPECT_TRUE(info.is_repeated);
+    if constexpr (info.is_map && info.number() == 1) {
+      EXPECT_EQ(info.Get().at(1), 2);
+    }
+  });
+  EXPECT_EQ(visited, 1);
+}
+
+TEST(VisitFieldsTest, ImplicitPresence) {
+  proto3_unittest::TestAllTypes message;
+  message.set_optional_int32(0);
+  message.set_optional_string("");
+  EXPECT_THAT(VisitedNumbers(message), ElementsAre());
+
+  // Like for reflection, negative zero is present.
+  message.set_optional_float(-0.0f);
+  message.set_optional_bytes("x");
+  EXPECT_THAT(VisitedNumbers(message), ElementsAre(11, 15));
+}
+
+TEST(VisitFieldsTest, CheckedInGeneratedCode) {
+  Duration duration;
+  duration.set_nanos(5);
+  EXPECT_THAT(VisitedNumbers(duration), ElementsAre(2));
+
+  Value value;
+  (*value.mutable_struct_value()->mutable_fields())["a"].set_bool_value(true);
+  EXPECT_THAT(VisitedNumbers(value), ElementsAre(5));
+  EXPECT_THAT(VisitedNumbers(value.struct_value()), ElementsAre(1));
+
+  DescriptorProto::ReservedRange range;
+  range.set_end(3);
+  EXPECT_THAT(VisitedNumbers(range), ElementsAre(2));
+}
+
+TEST(VisitFieldsTest, Clear) {
+  TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+
+  // Redact all string fields.
+  VisitFields(message, [](auto info) {
+    if constexpr (info.type() == WireFormatLite::TYPE_STRING) {
+      info.Clear();
+    }
+  });
+  EXPECT_FALSE(message.has_optional_string());
+  EXPECT_EQ(message.repeated_string_size(), 0);
+  EXPECT_TRUE(message.has_optional_bytes());
+
+  const TestAllTypes& const_message = message;
+  std::vector<absl::string_view> names;
+  VisitFields(const_message, [&](auto info) {
+    if constexpr (info.type() == WireFormatLite::TYPE_STRING) {
+      names.push_back(info.name());
+    }
+  });
+  EXPECT_THAT(names, ElementsAre());
+}
+
+}  // namespace
+}  // namespace protobuf
+}  // namespace google
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -150,9 +151,8 @@ bool WireFormat::SkipMessage(io::CodedInputStream* input,
 uint8_t* WireFormat::InternalSerializeUnknownFieldsToArray(
     const UnknownFieldSet& unknown_fields, uint8_t* target,
     io::EpsCopyOutputStream* stream) {
-  for (int i = 0; i < unknown_fields.field_count(); i++) {
-    const UnknownField& field = unknown_fields.field(i);
-
+  // Wire bytes are written as they are, without decoding them.
+  for (const UnknownField& field : unknown_fields.fields()) {
     target = stream->EnsureSpace(target);
     switch (field.type()) {
       case UnknownField::TYPE_VARINT:
@@ -182,6 +182,11 @@ uint8_t* WireFormat::InternalSerializeUnknownFieldsToArray(
         break;
     }
   }
+  const absl::string_view wire_bytes = unknown_fields.V2Data();
+  if (!wire_bytes.empty()) {
+    target = stream->WriteRaw(wire_bytes.data(),
+                              static_cast<int>(wire_bytes.size()), target);
+  }
   return target;
 }
 
@@ -223,10 +228,8 @@ uint8_t* WireFormat::InternalSerializeUnknownMessageSetItemsToArray(
 
 size_t WireFormat::ComputeUnknownFieldsSize(
     const UnknownFieldSet& unknown_fields) {
-  size_t size = 0;
-  for (int i = 0; i < unknown_fields.field_count(); i++) {
-    const UnknownField& field = unknown_fields.field(i);
-
+  size_t size = unknown_fields.V2Data().size();
+  for (const UnknownField& field : unknown_fields.fields()) {
     switch (field.type()) {
       case UnknownField::TYPE_VARINT:
         size += io::CodedOutputStream::VarintSize32(WireFormatLite::MakeTag(
@@ -1445,6 +1448,531 @@ uint8_t* WireFormat::InternalSerializeMessageSetItem(
 
 // ===================================================================
 
+namespace {
+
+// A growable buffer that is filled from the last byte to the first.  The
+// serialized data is buffer_[pos_, buffer_.size()).
+class ReverseBuffer {
+ public:
+  size_t ByteCount() const { return buffer_.size() - pos_; }
+
+  void WriteRaw(const void* data, size_t size) {
+    if (size == 0) return;
+    std::memcpy(Reserve(size), data, size);
+  }
+  void WriteString(absl::string_view value) {
+    WriteRaw(value.data(), value.size());
+  }
+  void WriteCord(const absl::Cord& value) {
+    uint8_t* ptr = Reserve(value.size());
+    for (absl::string_view chunk : value.Chunks()) {
+      std::memcpy(ptr, chunk.data(), chunk.size());
+      ptr += chunk.size();
+    }
+  }
+
+  void WriteVarint64(uint64_t value) {
+    uint8_t bytes[kMaxVarintBytes];
+    uint8_t* end = io::CodedOutputStream::WriteVarint64ToArray(value, bytes);
+    WriteRaw(bytes, end - bytes);
+  }
+  void WriteVarint32(uint32_t value) {
+    uint8_t bytes[kMaxVarint32Bytes];
+    uint8_t* end = io::CodedOutputStream::WriteVarint32ToArray(value, bytes);
+    WriteRaw(bytes, end - bytes);
+  }
+  void WriteTag(int number, WireFormatLite::WireType type) {
+    WriteVarint32(WireFormatLite::MakeTag(number, type));
+  }
+  // Writes the length prefix for everything written since ByteCount() was
+  // `start`, followed (that is, preceded on the wire) by its tag.
+  void WriteLengthDelimitedHeader(int number, size_t start) {
+    WriteVarint32(static_cast<uint32_t>(ByteCount() - start));
+    WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  }
+
+  // Value writers named after the WireFormatLite::Write##TYPE functions.
+  void WriteInt32(int32_t value) {
+    WriteVarint64(static_cast<uint64_t>(static_cast<int64_t>(value)));
+  }
+  void WriteInt64(int64_t value) {
+    WriteVarint64(static_cast<uint64_t>(value));
+  }
+  void WriteUInt32(uint32_t value) { WriteVarint32(value); }
+  void WriteUInt64(uint64_t value) { WriteVarint64(value); }
+  void WriteSInt32(int32_t value) {
+    WriteVarint32(WireFormatLite::ZigZagEncode32(value));
+  }
+  void WriteSInt64(int64_t value) {
+    WriteVarint64(WireFormatLite::ZigZagEncode64(value));
+  }
+  void WriteFixed32(uint32_t value) {
+    uint8_t bytes[sizeof(value)];
+    io::CodedOutputStream::WriteLittleEndian32ToArray(value, bytes);
+    WriteRaw(bytes, sizeof(bytes));
+  }
+  void WriteFixed64(uint64_t value) {
+    uint8_t bytes[sizeof(value)];
+    io::CodedOutputStream::WriteLittleEndian64ToArray(value, bytes);
+    WriteRaw(bytes, sizeof(bytes));
+  }
+  void WriteSFixed32(int32_t value) {
+    WriteFixed32(static_cast<uint32_t>(value));
+  }
+  void WriteSFixed64(int64_t value) {
+    WriteFixed64(static_cast<uint64_t>(value));
+  }
+  void WriteFloat(float value) {
+    WriteFixed32(WireFormatLite::EncodeFloat(value));
+  }
+  void WriteDouble(double value) {
+    WriteFixed64(WireFormatLite::EncodeDouble(value));
+  }
+  void WriteBool(bool value) { WriteVarint32(value ? 1 : 0); }
+  void WriteEnum(int value) { WriteInt32(value); }
+
+  // Moves the serialized bytes into `output`.
+  void Finish(std::string* output) {
+    buffer_.erase(0, pos_);
+    pos_ = 0;
+    output->swap(buffer_);
+  }
+
+ private:
+  static constexpr size_t kInitialSize = 256;
+  static constexpr int kMaxVarintBytes = 10;
+  static constexpr int kMaxVarint32Bytes = 5;
+
+  uint8_t* Reserve(size_t size) {
+    if (ABSL_PREDICT_FALSE(size > pos_)) Grow(size);
+    pos_ -= size;
+    return reinterpret_cast<uint8_t*>(&buffer_[pos_]);
+  }
+
+  ABSL_ATTRIBUTE_NOINLINE void Grow(size_t size) {
+    size_t used = ByteCount();
+    size_t new_size = std::max({kInitialSize, buffer_.size() * 2, used + size});
+    std::string new_buffer(new_size, '\0');
+    if (used > 0) {
+      std::memcpy(&new_buffer[new_size - used], buffer_.data() + pos_, used);
+    }
+    buffer_.swap(new_buffer);
+    pos_ = new_size - used;
+  }
+
+  std::string buffer_;
+  size_t pos_ = 0;
+};
+
+}  // namespace
+
+// Implements WireFormat::SerializeSinglePass().  Everything is visited in
+// reverse: unknown fields first, then fields from the highest number down,
+// then repeated elements from last to first.
+class WireFormat::SinglePassSerializer {
+ public:
+  explicit SinglePassSerializer(bool deterministic)
+      : deterministic_(deterministic) {}
+
+  void SerializeMessage(const Message& message);
+  void Finish(std::string* output) { out_.Finish(output); }
+
+ private:
+  void SerializeField(const FieldDescriptor* field, const Message& message);
+  void SerializeMapEntry(const FieldDescriptor* field, const MapKey& key,
+                         const MapValueConstRef& value);
+  void SerializeMapKey(const FieldDescriptor* field, const MapKey& key);
+  void SerializeMapValue(const FieldDescriptor* field,
+                         const MapValueConstRef& value);
+  void SerializeMessageSetItem(int type_id, const Message& message);
+  void SerializeUnknownFields(const UnknownFieldSet& unknown_fields);
+  void SerializeUnknownMessageSetItems(const UnknownFieldSet& unknown_fields);
+
+  void WriteMessage(int number, const Message& message) {
+    size_t start = out_.ByteCount();
+    SerializeMessage(message);
+    out_.WriteLengthDelimitedHeader(number, start);
+  }
+  void WriteGroup(int number, const Message& message) {
+    out_.WriteTag(number, WireFormatLite::WIRETYPE_END_GROUP);
+    SerializeMessage(message);
+    out_.WriteTag(number, WireFormatLite::WIRETYPE_START_GROUP);
+  }
+  void WriteBytes(int number, absl::string_view value) {
+    out_.WriteString(value);
+    out_.WriteVarint32(static_cast<uint32_t>(value.size()));
+    out_.WriteTag(number, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  }
+
+  ReverseBuffer out_;
+  const bool deterministic_;
+};
+
+void WireFormat::SinglePassSerializer::SerializeMessage(
+    const Message& message) {
+  const Descriptor* descriptor = message.GetDescriptor();
+  const Reflection* message_reflection = message.GetReflection();
+
+  if (descriptor->options().message_set_wire_format()) {
+    SerializeUnknownMessageSetItems(
+        message_reflection->GetUnknownFields(message));
+  } else {
+    SerializeUnknownFields(message_reflection->GetUnknownFields(message));
+  }
+
+  // Fields of map entry should always be serialized.
+  if (descriptor->options().map_entry()) {
+    for (int i = descriptor->field_count() - 1; i >= 0; i--) {
+      SerializeField(descriptor->field(i), message);
+    }
+    return;
+  }
+
+  std::vector<const FieldDescriptor*> fields;
+  message_reflection->ListFields(message, &fields);
+  for (auto it = fields.rbegin(); it != fields.rend(); ++it) {
+    SerializeField(*it, message);
+  }
+}
+
+void WireFormat::SinglePassSerializer::SerializeUnknownFields(
+    const UnknownFieldSet& unknown_fields) {
+  out_.WriteString(unknown_fields.V2Data());
+  const auto& fields = unknown_fields.fields();
+  for (int i = fields.size() - 1; i >= 0; i--) {
+    const UnknownField& field = fields[i];
+    switch (field.type()) {
+      case UnknownField::TYPE_VARINT:
+        out_.WriteVarint64(field.varint());
+        out_.WriteTag(field.number(), WireFormatLite::WIRETYPE_VARINT);
+        break;
+      case UnknownField::TYPE_FIXED32:
+        out_.WriteFixed32(field.fixed32());
+        out_.WriteTag(field.number(), WireFormatLite::WIRETYPE_FIXED32);
+        break;
+      case UnknownField::TYPE_FIXED64:
+        out_.WriteFixed64(field.fixed64());
+        out_.WriteTag(field.number(), WireFormatLite::WIRETYPE_FIXED64);
+        break;
+      case UnknownField::TYPE_LENGTH_DELIMITED:
+        WriteBytes(field.number(), field.length_delimited());
+        break;
+      case UnknownField::TYPE_GROUP:
+        out_.WriteTag(field.number(), WireFormatLite::WIRETYPE_END_GROUP);
+        SerializeUnknownFields(field.group());
+        out_.WriteTag(field.number(), WireFormatLite::WIRETYPE_START_GROUP);
+        break;
+    }
+  }
+}
+
+void WireFormat::SinglePassSerializer::SerializeUnknownMessageSetItems(
+    const UnknownFieldSet& unknown_fields) {
+  for (int i = unknown_fields.field_count() - 1; i >= 0; i--) {
+    const UnknownField& field = unknown_fields.field(i);
+    // The only unknown fields that are allowed to exist in a MessageSet are
+    // messages, which are length-delimited.
+    if (field.type() != UnknownField::TYPE_LENGTH_DELIMITED) continue;
+    out_.WriteVarint32(WireFormatLite::kMessageSetItemEndTag);
+    WriteBytes(WireFormatLite::kMessageSetMessageNumber,
+               field.length_delimited());
+    out_.WriteUInt32(field.number());
+    out_.WriteVarint32(WireFormatLite::kMessageSetTypeIdTag);
+    out_.WriteVarint32(WireFormatLite::kMessageSetItemStartTag);
+  }
+}
+
+void WireFormat::SinglePassSerializer::SerializeMessageSetItem(
+    int type_id, const Message& message) {
+  out_.WriteVarint32(WireFormatLite::kMessageSetItemEndTag);
+  WriteMessage(WireFormatLite::kMessageSetMessageNumber, message);
+  out_.WriteUInt32(type_id);
+  out_.WriteVarint32(WireFormatLite::kMessageSetTypeIdTag);
+  out_.WriteVarint32(WireFormatLite::kMessageSetItemStartTag);
+}
+
+void WireFormat::SinglePassSerializer::SerializeMapKey(
+    const FieldDescriptor* field, const MapKey& key) {
+  switch (field->type()) {
+    case FieldDescriptor::TYPE_DOUBLE:
+    case FieldDescriptor::TYPE_FLOAT:
+    case FieldDescriptor::TYPE_GROUP:
+    case FieldDescriptor::TYPE_MESSAGE:
+    case FieldDescriptor::TYPE_BYTES:
+    case FieldDescriptor::TYPE_ENUM:
+      ABSL_LOG(FATAL) << "Unsupported";
+      break;
+#define CASE_TYPE(FieldType, CamelFieldType, CamelCppType)             \
+  case FieldDescriptor::TYPE_##FieldType:                              \
+    out_.Write##CamelFieldType(key.Get##CamelCppType##Value());        \
+    out_.WriteTag(1, WireFormat::WireTypeForFieldType(field->type())); \
+    break;
+      CASE_TYPE(INT64, Int64, Int64)
+      CASE_TYPE(UINT64, UInt64, UInt64)
+      CASE_TYPE(INT32, Int32, Int32)
+      CASE_TYPE(FIXED64, Fixed64, UInt64)
+      CASE_TYPE(FIXED32, Fixed32, UInt32)
+      CASE_TYPE(BOOL, Bool, Bool)
+      CASE_TYPE(UINT32, UInt32, UInt32)
+      CASE_TYPE(SFIXED32, SFixed32, Int32)
+      CASE_TYPE(SFIXED64, SFixed64, Int64)
+      CASE_TYPE(SINT32, SInt32, Int32)
+      CASE_TYPE(SINT64, SInt64, Int64)
+#undef CASE_TYPE
+    case FieldDescriptor::TYPE_STRING:
+      WriteBytes(1, key.GetStringValue());
+      break;
+  }
+}
+
+void WireFormat::SinglePassSerializer::SerializeMapValue(
+    const FieldDescriptor* field, const MapValueConstRef& value) {
+  switch (field->type()) {
+#define CASE_TYPE(FieldType, CamelFieldType, CamelCppType)             \
+  case FieldDescriptor::TYPE_##FieldType:                              \
+    out_.Write##CamelFieldType(value.Get##CamelCppType##Value());      \
+    out_.WriteTag(2, WireFormat::WireTypeForFieldType(field->type())); \
+    break;
+    CASE_TYPE(INT64, Int64, Int64)
+    CASE_TYPE(UINT64, UInt64, UInt64)
+    CASE_TYPE(INT32, Int32, Int32)
+    CASE_TYPE(FIXED64, Fixed64, UInt64)
+    CASE_TYPE(FIXED32, Fixed32, UInt32)
+    CASE_TYPE(BOOL, Bool, Bool)
+    CASE_TYPE(UINT32, UInt32, UInt32)
+    CASE_TYPE(SFIXED32, SFixed32, Int32)
+    CASE_TYPE(SFIXED64, SFixed64, Int64)
+    CASE_TYPE(SINT32, SInt32, Int32)
+    CASE_TYPE(SINT64, SInt64, Int64)
+    CASE_TYPE(ENUM, Enum, Enum)
+    CASE_TYPE(DOUBLE, Double, Double)
+    CASE_TYPE(FLOAT, Float, Float)
+#undef CASE_TYPE
+    case FieldDescriptor::TYPE_STRING:
+    case FieldDescriptor::TYPE_BYTES:
+      WriteBytes(2, value.GetStringValue());
+      break;
+    case FieldDescriptor::TYPE_MESSAGE:
+      WriteMessage(2, value.GetMessageValue());
+      break;
+    case FieldDescriptor::TYPE_GROUP:
+      WriteGroup(2, value.GetMessageValue());
+      break;
+  }
+}
+
+void WireFormat::SinglePassSerializer::SerializeMapEntry(
+    const FieldDescriptor* field, const MapKey& key,
+    const MapValueConstRef& value) {
+  size_t start = out_.ByteCount();
+  SerializeMapValue(field->message_type()->map_value(), value);
+  SerializeMapKey(field->message_type()->map_key(), key);
+  out_.WriteLengthDelimitedHeader(field->number(), start);
+}
+
+void WireFormat::SinglePassSerializer::SerializeField(
+    const FieldDescriptor* field, const Message& message) {
+  const Reflection* message_reflection = message.GetReflection();
+
+  if (field->is_extension() &&
+      field->containing_type()->options().message_set_wire_format() &&
+      field->cpp_type() == FieldDescriptor::CPPTYPE_MESSAGE &&
+      !field->is_repeated()) {
+    SerializeMessageSetItem(field->number(),
+                            message_reflection->GetMessage(message, field));
+    return;
+  }
+
+  // Prefer map reflection while the map is valid, for the same reasons as
+  // WireFormat::InternalSerializeField().
+  if (field->is_map()) {
+    const MapFieldBase* map_field =
+        message_reflection->GetMapData(message, field);
+    if (map_field->IsMapValid()) {
+      if (deterministic_) {
+        std::vector<MapKey> sorted_key_list =
+            MapKeySorter::SortKey(message, message_reflection, field);
+        for (auto it = sorted_key_list.rbegin(); it != sorted_key_list.rend();
+             ++it) {
+          MapValueConstRef map_value;
+          message_reflection->LookupMapValue(message, field, *it, &map_value);
+          SerializeMapEntry(field, *it, map_value);
+        }
+      } else {
+        // Map iterators only go forward, so the entries are collected first
+        // to be written back to front, in the same order as
+        // SerializeWithCachedSizes() writes them.
+        std::vector<std::pair<MapKey, MapValueConstRef>> entries;
+        entries.reserve(message_reflection->MapSize(message, field));
+        for (ConstMapIterator it =
+                 message_reflection->ConstMapBegin(&message, field);
+             it != message_reflection->ConstMapEnd(&message, field); ++it) {
+          entries.emplace_back(it.GetKey(), it.GetValueRef());
+        }
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+          SerializeMapEntry(field, it->first, it->second);
+        }
+      }
+      return;
+    }
+  }
+
+  int count = 0;
+
+  if (field->is_repeated()) {
+    count = message_reflection->FieldSize(message, field);
+  } else if (field->containing_type()->options().map_entry()) {
+    // Map entry fields always need to be serialized.
+    count = 1;
+  } else if (message_reflection->HasField(message, field)) {
+    count = 1;
+  }
+
+  // map_entries is for maps that'll be deterministically serialized.
+  std::vector<const Message*> map_entries;
+  if (count > 1 && field->is_map() && deterministic_) {
+    map_entries =
+        DynamicMapSorter::Sort(message, count, message_reflection, field);
+  }
+
+  if (field->is_packed()) {
+    if (count == 0) return;
+    size_t start = out_.ByteCount();
+    switch (field->type()) {
+#define HANDLE_PRIMITIVE_TYPE(TYPE, TYPE_METHOD, CPPTYPE_METHOD)               \
+  case FieldDescriptor::TYPE_##TYPE:                                           \
+    for (int j = count - 1; j >= 0; j--) {                                     \
+      out_.Write##TYPE_METHOD(                                                 \
+          message_reflection->GetRepeated##CPPTYPE_METHOD(message, field, j)); \
+    }                                                                          \
+    break;
+
+      HANDLE_PRIMITIVE_TYPE(INT32, Int32, Int32)
+      HANDLE_PRIMITIVE_TYPE(INT64, Int64, Int64)
+      HANDLE_PRIMITIVE_TYPE(SINT32, SInt32, Int32)
+      HANDLE_PRIMITIVE_TYPE(SINT64, SInt64, Int64)
+      HANDLE_PRIMITIVE_TYPE(UINT32, UInt32, UInt32)
+      HANDLE_PRIMITIVE_TYPE(UINT64, UInt64, UInt64)
+      HANDLE_PRIMITIVE_TYPE(ENUM, Enum, EnumValue)
+
+      HANDLE_PRIMITIVE_TYPE(FIXED32, Fixed32, UInt32)
+      HANDLE_PRIMITIVE_TYPE(FIXED64, Fixed64, UInt64)
+      HANDLE_PRIMITIVE_TYPE(SFIXED32, SFixed32, Int32)
+      HANDLE_PRIMITIVE_TYPE(SFIXED64, SFixed64, Int64)
+
+      HANDLE_PRIMITIVE_TYPE(FLOAT, Float, Float)
+      HANDLE_PRIMITIVE_TYPE(DOUBLE, Double, Double)
+
+      HANDLE_PRIMITIVE_TYPE(BOOL, Bool, Bool)
+#undef HANDLE_PRIMITIVE_TYPE
+      default:
+        ABSL_LOG(FATAL) << "Invalid descriptor";
+    }
+    out_.WriteLengthDelimitedHeader(field->number(), start);
+    return;
+  }
+
+  auto get_message_from_field = [&message, &map_entries, message_reflection](
+                                    const FieldDescriptor* field, int j) {
+    if (!field->is_repeated()) {
+      return &message_reflection->GetMessage(message, field);
+    }
+    if (!map_entries.empty()) {
+      return map_entries[j];
+    }
+    return &message_reflection->GetRepeatedMessage(message, field, j);
+  };
+  const WireFormatLite::WireType wire_type =
+      WireFormat::WireTypeForFieldType(field->type());
+  for (int j = count - 1; j >= 0; j--) {
+    switch (field->type()) {
+#define HANDLE_PRIMITIVE_TYPE(TYPE, TYPE_METHOD, CPPTYPE_METHOD)              \
+  case FieldDescriptor::TYPE_##TYPE:                                          \
+    out_.Write##TYPE_METHOD(                                                  \
+        field->is_repeated()                                                  \
+            ? message_reflection->GetRepeated##CPPTYPE_METHOD(message, field, \
+                                                              j)              \
+            : message_reflection->Get##CPPTYPE_METHOD(message, field));       \
+    out_.WriteTag(field->number(), wire_type);                                \
+    break;
+
+      HANDLE_PRIMITIVE_TYPE(INT32, Int32, Int32)
+      HANDLE_PRIMITIVE_TYPE(INT64, Int64, Int64)
+      HANDLE_PRIMITIVE_TYPE(SINT32, SInt32, Int32)
+      HANDLE_PRIMITIVE_TYPE(SINT64, SInt64, Int64)
+      HANDLE_PRIMITIVE_TYPE(UINT32, UInt32, UInt32)
+      HANDLE_PRIMITIVE_TYPE(UINT64, UInt64, UInt64)
+      HANDLE_PRIMITIVE_TYPE(ENUM, Enum, EnumValue)
+
+      HANDLE_PRIMITIVE_TYPE(FIXED32, Fixed32, UInt32)
+      HANDLE_PRIMITIVE_TYPE(FIXED64, Fixed64, UInt64)
+      HANDLE_PRIMITIVE_TYPE(SFIXED32, SFixed32, Int32)
+      HANDLE_PRIMITIVE_TYPE(SFIXED64, SFixed64, Int64)
+
+      HANDLE_PRIMITIVE_TYPE(FLOAT, Float, Float)
+      HANDLE_PRIMITIVE_TYPE(DOUBLE, Double, Double)
+
+      HANDLE_PRIMITIVE_TYPE(BOOL, Bool, Bool)
+#undef HANDLE_PRIMITIVE_TYPE
+
+      case FieldDescriptor::TYPE_GROUP:
+        WriteGroup(field->number(), *get_message_from_field(field, j));
+        break;
+
+      case FieldDescriptor::TYPE_MESSAGE:
+        WriteMessage(field->number(), *get_message_from_field(field, j));
+        break;
+
+      case FieldDescriptor::TYPE_STRING: {
+        std::string scratch;
+        const std::string& value =
+            field->is_repeated()
+                ? message_reflection->GetRepeatedStringReference(message, field,
+                                                                 j, &scratch)
+                : message_reflection->GetStringReference(message, field,
+                                                         &scratch);
+        if (field->requires_utf8_validation()) {
+          WireFormatLite::VerifyUtf8String(value.data(), value.length(),
+                                           WireFormatLite::SERIALIZE,
+                                           field->full_name());
+        }
+        WriteBytes(field->number(), value);
+        break;
+      }
+
+      case FieldDescriptor::TYPE_BYTES: {
+        if (field->cpp_string_type() == FieldDescriptor::CppStringType::kCord &&
+            !field->is_repeated()) {
+          absl::Cord value = message_reflection->GetCord(message, field);
+          out_.WriteCord(value);
+          out_.WriteVarint32(static_cast<uint32_t>(value.size()));
+          out_.WriteTag(field->number(),
+                        WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+          break;
+        }
+        std::string scratch;
+        const std::string& value =
+            field->is_repeated()
+                ? message_reflection->GetRepeatedStringReference(message, field,
+                                                                 j, &scratch)
+                : message_reflection->GetStringReference(message, field,
+                                                         &scratch);
+        WriteBytes(field->number(), value);
+        break;
+      }
+    }
+  }
+}
+
+void WireFormat::SerializeSinglePass(const Message& message,
+                                     bool deterministic, std::string* output) {
+  SinglePassSerializer serializer(deterministic);
+  serializer.SerializeMessage(message);
+  serializer.Finish(output);
+}
+
+// ===================================================================
+
 size_t WireFormat::ByteSize(const Message& message) {
   const Descriptor* descriptor = message.GetDescriptor();
   const Reflection* message_reflection = message.GetReflection();
@@ -18,6 +18,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 #include "absl/base/casts.h"
 #include "absl/log/absl_check.h"
@@ -127,6 +128,24 @@ class PROTOBUF_EXPORT WireFormat {
   // WireFormat::SerializeWithCachedSizes() on the same object.
   static size_t ByteSize(const Message& message);
 
+  // Serializes `message` into `output` in a single pass over the message
+  // tree, without computing or caching any sizes first.
+  //
+  // SerializeWithCachedSizes() needs the size of every submessage up front
+  // to write its length prefix, so serializing via reflection normally walks
+  // the whole tree twice: once in ByteSize() and once to write the bytes.
+  // This instead writes the message back to front, so that each submessage
+  // body is already written by the time its length prefix is needed.  It is
+  // meant for messages that serialize through reflection anyway, such as
+  // DynamicMessage; generated code is faster with its own serializer.
+  //
+  // The output is the same as that of SerializeWithCachedSizes() with the
+  // same determinism setting: map entries are sorted by key if
+  // `deterministic` is true, and are otherwise in the order in which the map
+  // iterates them.  Required fields are NOT checked.
+  static void SerializeSinglePass(const Message& message, bool deterministic,
+                                  std::string* output);
+
   // -----------------------------------------------------------------
   // Helpers for dealing with unknown fields
 
@@ -251,6 +270,7 @@ class PROTOBUF_EXPORT WireFormat {
 
  private:
   struct MessageSetParser;
+  class SinglePassSerializer;
   friend class TcParser;
   // Skip a MessageSet field.
   static bool SkipMessageSetField(io::CodedInputStream* input,
@@ -567,6 +567,18 @@ class PROTOBUF_EXPORT WireFormatLite {
                                        int cached_size, uint8_t* target,
                                        io::EpsCopyOutputStream* stream);
 
+  // Like above, but call the serializer of the generated class `MessageType`
+  // directly rather than through MessageLite, so that the call is not
+  // indirect and can be inlined.
+  template <typename MessageType>
+  PROTOBUF_NDEBUG_INLINE static uint8_t* InternalWriteGroupNoVirtual(
+      int field_number, const MessageType& value, uint8_t* target,
+      io::EpsCopyOutputStream* stream);
+  template <typename MessageType>
+  PROTOBUF_NDEBUG_INLINE static uint8_t* InternalWriteMessageNoVirtual(
+      int field_number, const MessageType& value, int cached_size,
+      uint8_t* target, io::EpsCopyOutputStream* stream);
+
   // Like above, but de-virtualize the call to SerializeWithCachedSizes().
   template <typename MessageType>
   PROTOBUF_NDEBUG_INLINE static uint8_t* InternalWriteGroupNoVirtualToArray(
@@ -1484,6 +1496,29 @@ inline uint8_t* WireFormatLite::WriteBytesToArray(int field_number,
 
 // See comment on ReadGroupNoVirtual to understand the need for this template
 // parameter name.
+template <typename MessageType_WorkAroundCppLookupDefect>
+inline uint8_t* WireFormatLite::InternalWriteGroupNoVirtual(
+    int field_number, const MessageType_WorkAroundCppLookupDefect& value,
+    uint8_t* target, io::EpsCopyOutputStream* stream) {
+  target = stream->EnsureSpace(target);
+  target = WriteTagToArray(field_number, WIRETYPE_START_GROUP, target);
+  target = value.MessageType_WorkAroundCppLookupDefect::_InternalSerialize(
+      target, stream);
+  target = stream->EnsureSpace(target);
+  return WriteTagToArray(field_number, WIRETYPE_END_GROUP, target);
+}
+template <typename MessageType_WorkAroundCppLookupDefect>
+inline uint8_t* WireFormatLite::InternalWriteMessageNoVirtual(
+    int field_number, const MessageType_WorkAroundCppLookupDefect& value,
+    int cached_size, uint8_t* target, io::EpsCopyOutputStream* stream) {
+  target = stream->EnsureSpace(target);
+  target = WriteTagToArray(field_number, WIRETYPE_LENGTH_DELIMITED, target);
+  target = io::CodedOutputStream::WriteVarint32ToArray(
+      static_cast<uint32_t>(cached_size), target);
+  return value.MessageType_WorkAroundCppLookupDefect::_InternalSerialize(
+      target, stream);
+}
+
 template <typename MessageType_WorkAroundCppLookupDefect>
 inline uint8_t* WireFormatLite::InternalWriteGroupNoVirtualToArray(
     int field_number, const MessageType_WorkAroundCppLookupDefect& value,
@@ -13,17 +13,26 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 #include "absl/base/casts.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "google/protobuf/dynamic_message.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/io/zero_copy_stream_impl_lite.h"
+#include "google/protobuf/map_unittest.pb.h"
+#include "google/protobuf/message.h"
 #include "google/protobuf/repeated_ptr_field.h"
+#include "google/protobuf/test_util.h"
 #include "google/protobuf/unittest.pb.h"
 #include "google/protobuf/unittest_import.pb.h"
 #include "google/protobuf/unittest_mset.pb.h"
 #include "google/protobuf/unittest_mset_wire_format.pb.h"
 #include "google/protobuf/unittest_proto3_arena.pb.h"
+#include "google/protobuf/util/message_differencer.h"
 #include "google/protobuf/wire_format_lite.h"
 #include "google/protobuf/wire_format_unittest.h"
 #include <gtest/gtest.h>
@@ -218,6 +227,89 @@ TEST(WireFormatTest, CppTypeForWorksForAllSupportedTypes) {
             WFL::CPPTYPE_MESSAGE);
 }
 
+TEST(WireFormatTest, SerializeSinglePassDeterministicMaps) {
+  proto2_unittest::TestMap message;
+  for (int i = 0; i < 100; i++) {
+    (*message.mutable_map_int32_int32())[i * 7919 % 1000] = i;
+    (*message.mutable_map_string_string())[absl::StrCat("key", i)] =
+        absl::StrCat("value", i);
+    (*message.mutable_map_int32_foreign_message())[-i].set_c(i);
+  }
+
+  std::string expected;
+  {
+    message.ByteSizeLong();  // Updates the cached sizes.
+    io::StringOutputStream raw_output(&expected);
+    io::CodedOutputStream output(&raw_output);
+    output.SetSerializationDeterministic(true);
+    message.SerializeWithCachedSizes(&output);
+    ASSERT_FALSE(output.HadError());
+  }
+
+  std::string data;
+  WireFormat::SerializeSinglePass(message, /*deterministic=*/true, &data);
+  EXPECT_EQ(expected, data);
+
+  // Without determinism, map entries are in iteration order.
+  WireFormat::SerializeSinglePass(message, /*deterministic=*/false, &data);
+  EXPECT_EQ(message.SerializeAsString(), data);
+  proto2_unittest::TestMap parsed;
+  ASSERT_TRUE(parsed.ParseFromString(data));
+  EXPECT_TRUE(util::MessageDifferencer::Equals(message, parsed));
+}
+
+TEST(WireFormatTest, SerializeSinglePassDynamicMessage) {
+  proto2_unittest::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  const std::string expected = message.SerializeAsString();
+
+  DynamicMessageFactory factory;
+  std::unique_ptr<Message> dynamic(
+      factory.GetPrototype(proto2_unittest::TestAllTypes::descriptor())->New());
+  ASSERT_TRUE(dynamic->ParseFromString(expected));
+
+  std::string data;
+  WireFormat::SerializeSinglePass(*dynamic, /*deterministic=*/false, &data);
+  EXPECT_EQ(expected, data);
+}
+
+TEST(WireFormatTest, InternalWriteNoVirtual) {
+  proto2_unittest::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  message.ByteSizeLong();
+
+  auto serialize = [&](bool no_virtual) {
+    std::string data;
+    {
+      io::StringOutputStream output(&data);
+      uint8_t* ptr;
+      io::EpsCopyOutputStream stream(&output, /*deterministic=*/false, &ptr);
+      const auto& nested = message.optional_nested_message();
+      const auto& group = message.optionalgroup();
+      if (no_virtual) {
+        ptr = WireFormatLite::InternalWriteMessageNoVirtual(
+            18, nested, nested.GetCachedSize(), ptr, &stream);
+        ptr = WireFormatLite::InternalWriteGroupNoVirtual(16, group, ptr,
+                                                          &stream);
+      } else {
+        ptr = WireFormatLite::InternalWriteMessage(
+            18, nested, nested.GetCachedSize(), ptr, &stream);
+        ptr = WireFormatLite::InternalWriteGroup(16, group, ptr, &stream);
+      }
+      stream.Trim(ptr);
+    }
+    return data;
+  };
+
+  const std::string expected = serialize(/*no_virtual=*/false);
+  EXPECT_EQ(serialize(/*no_virtual=*/true), expected);
+
+  proto2_unittest::TestAllTypes parsed;
+  ASSERT_TRUE(parsed.ParseFromString(expected));
+  EXPECT_EQ(parsed.optional_nested_message().bb(),
+            message.optional_nested_message().bb());
+  EXPECT_EQ(parsed.optionalgroup().a(), message.optionalgroup().a());
+}
 
 }  // namespace
 }  // namespace internal
@@ -155,6 +155,27 @@ class WireFormatTest : public testing::Test,
                                 type_id, coded_output);
     coded_output->WriteTag(WireFormatLite::kMessageSetItemEndTag);
   }
+
+  // Serializes `message` with WireFormat in the usual two passes.
+  std::string SerializeWithCachedSizes(const Message& message) {
+    std::string data;
+    size_t size = WireFormat::ByteSize(message);
+    {
+      io::StringOutputStream raw_output(&data);
+      io::CodedOutputStream output(&raw_output);
+      WireFormat::SerializeWithCachedSizes(message, size, &output);
+      ABSL_CHECK(!output.HadError());
+    }
+    return data;
+  }
+
+  // Checks that SerializeSinglePass() writes exactly the same bytes.
+  void ExpectSinglePassMatches(const Message& message) {
+    std::string expected = SerializeWithCachedSizes(message);
+    std::string data;
+    WireFormat::SerializeSinglePass(message, /*deterministic=*/false, &data);
+    EXPECT_EQ(expected, data);
+  }
 };
 
 TYPED_TEST_SUITE_P(WireFormatTest);
@@ -471,6 +492,68 @@ TYPED_TEST_P(WireFormatTest, SerializeOneof) {
   EXPECT_TRUE(TestUtil::EqualsToSerialized(message, dynamic_data));
 }
 
+const int kUnknownTypeId = 1550055;
+
+TYPED_TEST_P(WireFormatTest, SerializeSinglePass) {
+  typename TestFixture::TestAllTypes message;
+  TestUtil::SetAllFields(&message);
+  this->ExpectSinglePassMatches(message);
+
+  typename TestFixture::TestAllExtensions extensions;
+  TestUtil::SetAllExtensions(&extensions);
+  this->ExpectSinglePassMatches(extensions);
+
+  typename TestFixture::TestFieldOrderings orderings;
+  TestUtil::SetAllFieldsAndExtensions(&orderings);
+  this->ExpectSinglePassMatches(orderings);
+
+  typename TestFixture::TestOneof2 oneof;
+  TestUtil::SetOneof1(&oneof);
+  this->ExpectSinglePassMatches(oneof);
+
+  // Empty messages serialize to nothing.
+  this->ExpectSinglePassMatches(typename TestFixture::TestAllTypes());
+}
+
+TYPED_TEST_P(WireFormatTest, SerializeSinglePassPacked) {
+  typename TestFixture::TestPackedTypes message;
+  TestUtil::SetPackedFields(&message);
+  this->ExpectSinglePassMatches(message);
+
+  typename TestFixture::TestPackedExtensions extensions;
+  TestUtil::SetPackedExtensions(&extensions);
+  this->ExpectSinglePassMatches(extensions);
+}
+
+TYPED_TEST_P(WireFormatTest, SerializeSinglePassUnknownFields) {
+  typename TestFixture::TestEmptyMessage message;
+  UnknownFieldSet* unknown_fields = message.mutable_unknown_fields();
+  unknown_fields->AddVarint(1, 123456789);
+  unknown_fields->AddFixed32(2, 0xdeadbeef);
+  unknown_fields->AddFixed64(3, 0x0123456789abcdef);
+  unknown_fields->AddLengthDelimited(4, std::string(300, 'x'));
+  UnknownFieldSet* group = unknown_fields->AddGroup(5);
+  group->AddVarint(1, 1);
+  group->AddGroup(2)->AddLengthDelimited(3, "nested");
+  unknown_fields->AddVarint(1, 42);
+  this->ExpectSinglePassMatches(message);
+}
+
+TYPED_TEST_P(WireFormatTest, SerializeSinglePassMessageSet) {
+  typename TestFixture::TestMessageSet message_set;
+  message_set
+      .MutableExtension(
+          TestFixture::TestMessageSetExtension1::message_set_extension)
+      ->set_i(123);
+  message_set
+      .MutableExtension(
+          TestFixture::TestMessageSetExtension2::message_set_extension)
+      ->set_str("foo");
+  message_set.mutable_unknown_fields()->AddLengthDelimited(kUnknownTypeId,
+                                                           "bar");
+  this->ExpectSinglePassMatches(message_set);
+}
+
 TYPED_TEST_P(WireFormatTest, ParseMultipleExtensionRanges) {
   // Make sure we can parse a message that contains multiple extensions ranges.
   typename TestFixture::TestFieldOrderings source;
@@ -495,8 +578,6 @@ TYPED_TEST_P(WireFormatTest, ParseMultipleExtensionRanges) {
   }
 }
 
-const int kUnknownTypeId = 1550055;
-
 TYPED_TEST_P(WireFormatTest, SerializeMessageSet) {
   // Set up a TestMessageSet with two known messages and an unknown one.
   typename TestFixture::TestMessageSet message_set;
@@ -1125,7 +1206,9 @@ REGISTER_TYPED_TEST_SUITE_P(
     ParsePackedFromUnpacked, ParseUnpackedFromPacked, ParsePackedExtensions,
     ParseOneof, OneofOnlySetLast, ByteSize, ByteSizeExtensions, ByteSizePacked,
     ByteSizePackedExtensions, ByteSizeOneof, Serialize, SerializeExtensions,
-    SerializeFieldsAndExtensions, SerializeOneof, ParseMultipleExtensionRanges,
+    SerializeFieldsAndExtensions, SerializeOneof, SerializeSinglePass,
+    SerializeSinglePassPacked, SerializeSinglePassUnknownFields,
+    SerializeSinglePassMessageSet, ParseMultipleExtensionRanges,
     SerializeMessageSet, SerializeMessageSetVariousWaysAreEqual,
     ParseMessageSet, MessageSetUnknownButValidTypeId, MessageSetInvalidTypeId,
     MessageSetNonCanonInvalidTypeId, CompatibleTypes, LargeRecursionLimit,
@@ -255,6 +255,14 @@ class PROTOBUF_EXPORT UInt64Value final : public ::google::protobuf::Message
   void _internal_set_value(::uint64_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_UINT64,
+                                 ::google::protobuf::internal::kVisitSingular, &UInt64Value::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.UInt64Value)
  private:
   class _Internal;
@@ -447,6 +455,14 @@ class PROTOBUF_EXPORT UInt32Value final : public ::google::protobuf::Message
   void _internal_set_value(::uint32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_UINT32,
+                                 ::google::protobuf::internal::kVisitSingular, &UInt32Value::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.UInt32Value)
  private:
   class _Internal;
@@ -644,6 +660,14 @@ class PROTOBUF_EXPORT StringValue final : public ::google::protobuf::Message
   ::std::string* PROTOBUF_NONNULL _internal_mutable_value();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_STRING,
+                                 ::google::protobuf::internal::kVisitSingular, &StringValue::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.StringValue)
  private:
   class _Internal;
@@ -836,6 +860,14 @@ class PROTOBUF_EXPORT Int64Value final : public ::google::protobuf::Message
   void _internal_set_value(::int64_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT64,
+                                 ::google::protobuf::internal::kVisitSingular, &Int64Value::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Int64Value)
  private:
   class _Internal;
@@ -1028,6 +1060,14 @@ class PROTOBUF_EXPORT Int32Value final : public ::google::protobuf::Message
   void _internal_set_value(::int32_t value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_INT32,
+                                 ::google::protobuf::internal::kVisitSingular, &Int32Value::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.Int32Value)
  private:
   class _Internal;
@@ -1220,6 +1260,14 @@ class PROTOBUF_EXPORT FloatValue final : public ::google::protobuf::Message
   void _internal_set_value(float value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_FLOAT,
+                                 ::google::protobuf::internal::kVisitSingular, &FloatValue::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.FloatValue)
  private:
   class _Internal;
@@ -1412,6 +1460,14 @@ class PROTOBUF_EXPORT DoubleValue final : public ::google::protobuf::Message
   void _internal_set_value(double value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_DOUBLE,
+                                 ::google::protobuf::internal::kVisitSingular, &DoubleValue::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.DoubleValue)
  private:
   class _Internal;
@@ -1609,6 +1665,14 @@ class PROTOBUF_EXPORT BytesValue final : public ::google::protobuf::Message
   ::std::string* PROTOBUF_NONNULL _internal_mutable_value();
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BYTES,
+                                 ::google::protobuf::internal::kVisitSingular, &BytesValue::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.BytesValue)
  private:
   class _Internal;
@@ -1801,6 +1865,14 @@ class PROTOBUF_EXPORT BoolValue final : public ::google::protobuf::Message
   void _internal_set_value(bool value);
 
   public:
+  template <typename MessageT, typename VisitorT>
+  static void _InternalVisitFields(MessageT& msg, VisitorT& visitor) {
+    if (::google::protobuf::internal::IsImplicitPresenceFieldSet(msg.value())) {
+      ::google::protobuf::internal::VisitGeneratedField<1, ::google::protobuf::internal::WireFormatLite::TYPE_BOOL,
+                                 ::google::protobuf::internal::kVisitSingular, &BoolValue::clear_value>(
+          msg, "value", msg.value(), visitor);
+    }
+  }
   // @@protoc_insertion_point(class_scope:google.protobuf.BoolValue)
  private:
   class _Internal;
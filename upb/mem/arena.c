@@ -779,12 +779,18 @@ static upb_ArenaInternal* _upb_Arena_DoFuse(upb_ArenaInternal** ai1,
   // different node, during a previous and failed DoFuse() attempt. But we will
   // not lose track of these refs because we always add them to our overall
   // delta.
+  //
+  // When many threads fuse short-lived arenas into one long-lived arena, `r1`'s
+  // refcount is changing constantly, but `r1` almost always remains a root.
+  // So we retry the increment in place for as long as `r1` is a root, instead
+  // of abandoning the attempt and walking both trees again.  Each failed CAS
+  // has already reloaded the current count for us.
   uintptr_t r2_untagged_count = r2.tagged_count & ~1;
-  uintptr_t with_r2_refs = r1.tagged_count + r2_untagged_count;
-  if (!upb_Atomic_CompareExchangeStrong(
-          &r1.root->parent_or_count, &r1.tagged_count, with_r2_refs,
-          memory_order_release, memory_order_acquire)) {
-    return NULL;
+  while (!upb_Atomic_CompareExchangeWeak(
+      &r1.root->parent_or_count, &r1.tagged_count,
+      r1.tagged_count + r2_untagged_count, memory_order_release,
+      memory_order_acquire)) {
+    if (_upb_Arena_IsTaggedPointer(r1.tagged_count)) return NULL;
   }
 
   // Perform the actual fuse by removing the refs from `r2` and swapping in the
@@ -882,22 +888,24 @@ bool upb_Arena_IncRefFor(const upb_Arena* a, const void* owner) {
 
 retry:
   r = _upb_Arena_FindRoot(r.root);
-  if (upb_Atomic_CompareExchangeWeak(
-          &r.root->parent_or_count, &r.tagged_count,
-          _upb_Arena_TaggedFromRefcount(
-              _upb_Arena_RefCountFromTagged(r.tagged_count) + 1),
-          // Relaxed order is safe on success, incrementing the refcount
-          // need not perform any synchronization with the eventual free of the
-          // arena - that's provided by decrements.
-          memory_order_relaxed,
-          // Relaxed order is safe on failure as r.tagged_count is immediately
-          // overwritten by retrying the find root operation.
-          memory_order_relaxed)) {
-    // We incremented it successfully, so we are done.
-    return true;
+  while (!upb_Atomic_CompareExchangeWeak(
+      &r.root->parent_or_count, &r.tagged_count,
+      _upb_Arena_TaggedFromRefcount(
+          _upb_Arena_RefCountFromTagged(r.tagged_count) + 1),
+      // Relaxed order is safe on success, incrementing the refcount
+      // need not perform any synchronization with the eventual free of the
+      // arena - that's provided by decrements.
+      memory_order_relaxed,
+      // Relaxed order is safe on failure as we only inspect the tag bit of
+      // r.tagged_count before either retrying or re-finding the root.
+      memory_order_relaxed)) {
+    // A racing ref or unref only changed the count; try again right away.
+    if (_upb_Arena_IsTaggedPointer(r.tagged_count)) {
+      // We failed update due to parent switching on the arena.
+      goto retry;
+    }
   }
-  // We failed update due to parent switching on the arena.
-  goto retry;
+  return true;
 }
 
 void upb_Arena_DecRefFor(const upb_Arena* a, const void* owner) {
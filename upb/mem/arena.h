@@ -14,9 +14,9 @@
  * A upb_Arena is *not* thread-safe, although some functions related to its
  * managing its lifetime are, and are documented as such.
  *
- * You could write a thread-safe arena allocator that satisfies the
- * upb_alloc interface, but it would not be as efficient for the
- * single-threaded case. */
+ * For allocating from many threads at once, see upb_ThreadSafeArena in
+ * upb/mem/thread_safe_arena.h, which gives each thread its own upb_Arena and
+ * fuses them together. */
 
 #ifndef UPB_MEM_ARENA_H_
 #define UPB_MEM_ARENA_H_
@@ -0,0 +1,134 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2025 Google LLC.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "upb/mem/thread_safe_arena.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "upb/mem/alloc.h"
+#include "upb/mem/arena.h"
+#include "upb/port/atomic.h"
+
+// Must be last.
+#include "upb/port/def.inc"
+
+// One of these exists for every thread that has allocated from a given
+// upb_ThreadSafeArena.  It is allocated from the thread's own arena, so it
+// lives exactly as long as the fused group does.
+typedef struct upb_ThreadSafeArena_Thread {
+  upb_Arena* arena;
+  // Identifies the owning thread; see _upb_ThreadSafeArena_ThreadKey().
+  const void* owner;
+  struct upb_ThreadSafeArena_Thread* next;
+} upb_ThreadSafeArena_Thread;
+
+struct upb_ThreadSafeArena {
+  // Holds this struct and a ref on the fused group.  It is never allocated
+  // from after creation; threads only fuse into it, which is thread-safe.
+  upb_Arena* root;
+  upb_alloc* alloc;
+  // Never reused, so a stale thread-local cache entry can not match a new
+  // arena that happens to live at the same address as a freed one.
+  int64_t id;
+  // Lock-free list of per-thread arenas, pushed to with CAS.
+  UPB_ATOMIC(upb_ThreadSafeArena_Thread*) threads;
+};
+
+static UPB_ATOMIC(int64_t) g_next_id = 1;
+
+// Each thread remembers the last arena it used, like the C++ ThreadCache.
+typedef struct {
+  int64_t id;
+  upb_Arena* arena;
+} upb_ThreadSafeArena_Cache;
+
+static UPB_THREAD_LOCAL upb_ThreadSafeArena_Cache g_cache;
+
+// The address of a thread-local is unique among live threads.  A new thread
+// may reuse the key of one that has exited, in which case it adopts that
+// thread's arena, which is safe because the old thread can no longer use it.
+static const void* _upb_ThreadSafeArena_ThreadKey(void) { return &g_cache; }
+
+upb_ThreadSafeArena* upb_ThreadSafeArena_New(upb_alloc* alloc) {
+  upb_Arena* root = upb_Arena_Init(NULL, 0, alloc);
+  if (!root) return NULL;
+  upb_ThreadSafeArena* a = upb_Arena_Malloc(root, sizeof(*a));
+  if (!a) {
+    upb_Arena_Free(root);
+    return NULL;
+  }
+  a->root = root;
+  a->alloc = alloc;
+  a->id = upb_Atomic_Add(&g_next_id, 1, memory_order_relaxed);
+  upb_Atomic_Init(&a->threads, NULL);
+  return a;
+}
+
+void upb_ThreadSafeArena_Free(upb_ThreadSafeArena* a) {
+  upb_Arena* root = a->root;
+  upb_ThreadSafeArena_Thread* t =
+      upb_Atomic_Load(&a->threads, memory_order_acquire);
+  while (t) {
+    // `root` still holds a ref on the group, so `t` stays valid until the
+    // final free below.
+    upb_ThreadSafeArena_Thread* next = t->next;
+    upb_Arena_Free(t->arena);
+    t = next;
+  }
+  upb_Arena_Free(root);
+}
+
+static upb_Arena* _upb_ThreadSafeArena_FindThread(upb_ThreadSafeArena* a,
+                                                  const void* owner) {
+  upb_ThreadSafeArena_Thread* t =
+      upb_Atomic_Load(&a->threads, memory_order_acquire);
+  for (; t; t = t->next) {
+    if (t->owner == owner) return t->arena;
+  }
+  return NULL;
+}
+
+static upb_Arena* _upb_ThreadSafeArena_AddThread(upb_ThreadSafeArena* a,
+                                                 const void* owner) {
+  upb_Arena* arena = upb_Arena_Init(NULL, 0, a->alloc);
+  if (!arena) return NULL;
+  upb_ThreadSafeArena_Thread* t = upb_Arena_Malloc(arena, sizeof(*t));
+  if (!t || !upb_Arena_Fuse(a->root, arena)) {
+    upb_Arena_Free(arena);
+    return NULL;
+  }
+  t->arena = arena;
+  t->owner = owner;
+  t->next = upb_Atomic_Load(&a->threads, memory_order_relaxed);
+  while (!upb_Atomic_CompareExchangeWeak(&a->threads, &t->next, t,
+                                         memory_order_release,
+                                         memory_order_relaxed)) {
+  }
+  return arena;
+}
+
+upb_Arena* upb_ThreadSafeArena_ThreadArena(upb_ThreadSafeArena* a) {
+  upb_ThreadSafeArena_Cache* cache = &g_cache;
+  if (UPB_LIKELY(cache->id == a->id)) return cache->arena;
+
+  // Slow path: this thread last used a different arena.  Only the owning
+  // thread ever adds an entry for itself, so there is no race between the
+  // lookup and the insertion below.
+  const void* owner = _upb_ThreadSafeArena_ThreadKey();
+  upb_Arena* arena = _upb_ThreadSafeArena_FindThread(a, owner);
+  if (!arena) arena = _upb_ThreadSafeArena_AddThread(a, owner);
+  if (!arena) return NULL;
+
+  cache->id = a->id;
+  cache->arena = arena;
+  return arena;
+}
+
+uintptr_t upb_ThreadSafeArena_SpaceAllocated(upb_ThreadSafeArena* a) {
+  return upb_Arena_SpaceAllocated(a->root, NULL);
+}
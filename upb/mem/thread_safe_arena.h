@@ -0,0 +1,71 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2025 Google LLC.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+/* upb_ThreadSafeArena is an arena that many threads may allocate from at the
+ * same time, without locks and without calling upb_Arena_Fuse() themselves.
+ *
+ * Each thread that allocates gets its own upb_Arena (a bump allocator that is
+ * only ever touched by that thread), found through a thread-local cache.  All
+ * of the per-thread arenas are fused together, so they share one lifetime and
+ * messages built on different threads may freely point at each other.
+ *
+ * This mirrors the ThreadSafeArena/SerialArena split in the C++ runtime. */
+
+#ifndef UPB_MEM_THREAD_SAFE_ARENA_H_
+#define UPB_MEM_THREAD_SAFE_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "upb/mem/alloc.h"
+#include "upb/mem/arena.h"
+
+// Must be last.
+#include "upb/port/def.inc"
+
+typedef struct upb_ThreadSafeArena upb_ThreadSafeArena;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Creates a thread-safe arena whose blocks are allocated from |alloc|, which
+// must itself be thread-safe.  Returns NULL on allocation failure.
+UPB_API upb_ThreadSafeArena* upb_ThreadSafeArena_New(upb_alloc* alloc);
+
+// Frees the arena and everything allocated from it on any thread.  No other
+// thread may be using the arena, or any of its per-thread arenas, when this is
+// called.
+UPB_API void upb_ThreadSafeArena_Free(upb_ThreadSafeArena* a);
+
+// Returns the calling thread's arena, creating it on first use.  The returned
+// arena must only be used by the calling thread, and lives until
+// upb_ThreadSafeArena_Free() is called.  It is fused with the arenas of all
+// other threads.  Returns NULL on allocation failure.
+//
+// This operation is safe to use concurrently from multiple threads.
+UPB_API upb_Arena* upb_ThreadSafeArena_ThreadArena(upb_ThreadSafeArena* a);
+
+// Returns the total space allocated by all threads.
+//
+// This operation is safe to use concurrently from multiple threads.
+UPB_API uintptr_t upb_ThreadSafeArena_SpaceAllocated(upb_ThreadSafeArena* a);
+
+// This operation is safe to use concurrently from multiple threads.
+UPB_API_INLINE void* upb_ThreadSafeArena_Malloc(upb_ThreadSafeArena* a,
+                                                size_t size) {
+  upb_Arena* arena = upb_ThreadSafeArena_ThreadArena(a);
+  return arena ? upb_Arena_Malloc(arena, size) : NULL;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#include "upb/port/undef.inc"
+
+#endif /* UPB_MEM_THREAD_SAFE_ARENA_H_ */
@@ -0,0 +1,110 @@
+// Protocol Buffers - Google's data interchange format
+// Copyright 2025 Google LLC.  All rights reserved.
+//
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file or at
+// https://developers.google.com/open-source/licenses/bsd
+
+#include "upb/mem/thread_safe_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "upb/mem/alloc.h"
+#include "upb/mem/arena.h"
+
+// Must be last.
+#include "upb/port/def.inc"
+
+namespace {
+
+TEST(ThreadSafeArenaTest, SameThreadGetsSameArena) {
+  upb_ThreadSafeArena* a = upb_ThreadSafeArena_New(&upb_alloc_global);
+  ASSERT_NE(a, nullptr);
+  upb_Arena* arena = upb_ThreadSafeArena_ThreadArena(a);
+  ASSERT_NE(arena, nullptr);
+  EXPECT_EQ(upb_ThreadSafeArena_ThreadArena(a), arena);
+  EXPECT_NE(upb_ThreadSafeArena_Malloc(a, 16), nullptr);
+  upb_ThreadSafeArena_Free(a);
+}
+
+TEST(ThreadSafeArenaTest, SwitchingBetweenArenas) {
+  upb_ThreadSafeArena* a = upb_ThreadSafeArena_New(&upb_alloc_global);
+  upb_ThreadSafeArena* b = upb_ThreadSafeArena_New(&upb_alloc_global);
+  upb_Arena* arena_a = upb_ThreadSafeArena_ThreadArena(a);
+  upb_Arena* arena_b = upb_ThreadSafeArena_ThreadArena(b);
+  EXPECT_NE(arena_a, arena_b);
+  EXPECT_FALSE(upb_Arena_IsFused(arena_a, arena_b));
+  // Coming back to `a` finds this thread's existing arena rather than making
+  // a new one.
+  EXPECT_EQ(upb_ThreadSafeArena_ThreadArena(a), arena_a);
+  EXPECT_EQ(upb_ThreadSafeArena_ThreadArena(b), arena_b);
+  upb_ThreadSafeArena_Free(a);
+  upb_ThreadSafeArena_Free(b);
+}
+
+TEST(ThreadSafeArenaTest, FreedArenaIsNotReused) {
+  // A new arena may be allocated at the same address as a freed one; the
+  // thread-local cache must not hand out the old thread arena.
+  for (int i = 0; i < 10; ++i) {
+    upb_ThreadSafeArena* a = upb_ThreadSafeArena_New(&upb_alloc_global);
+    upb_Arena* arena = upb_ThreadSafeArena_ThreadArena(a);
+    char* p = static_cast<char*>(upb_Arena_Malloc(arena, 64));
+    ASSERT_NE(p, nullptr);
+    memset(p, i, 64);
+    upb_ThreadSafeArena_Free(a);
+  }
+}
+
+TEST(ThreadSafeArenaTest, ManyThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kAllocsPerThread = 1000;
+  upb_ThreadSafeArena* a = upb_ThreadSafeArena_New(&upb_alloc_global);
+  std::vector<upb_Arena*> arenas(kThreads);
+  std::vector<std::vector<uint64_t*>> allocs(kThreads);
+  // Keep every thread alive until all of them have their arena, so thread
+  // local storage cannot be reused by a later thread.
+  absl::BlockingCounter recorded(kThreads);
+  absl::Notification all_recorded;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      arenas[i] = upb_ThreadSafeArena_ThreadArena(a);
+      recorded.DecrementCount();
+      all_recorded.WaitForNotification();
+      for (int j = 0; j < kAllocsPerThread; ++j) {
+        uint64_t* p = static_cast<uint64_t*>(
+            upb_ThreadSafeArena_Malloc(a, sizeof(uint64_t)));
+        ASSERT_NE(p, nullptr);
+        *p = (uint64_t{static_cast<uint32_t>(i)} << 32) | j;
+        allocs[i].push_back(p);
+      }
+      EXPECT_EQ(upb_ThreadSafeArena_ThreadArena(a), arenas[i]);
+    });
+  }
+  recorded.Wait();
+  all_recorded.Notify();
+  for (auto& t : threads) t.join();
+
+  for (int i = 0; i < kThreads; ++i) {
+    ASSERT_NE(arenas[i], nullptr);
+    for (int k = 0; k < i; ++k) {
+      EXPECT_NE(arenas[i], arenas[k]);
+      EXPECT_TRUE(upb_Arena_IsFused(arenas[i], arenas[k]));
+    }
+    ASSERT_EQ(allocs[i].size(), kAllocsPerThread);
+    for (int j = 0; j < kAllocsPerThread; ++j) {
+      EXPECT_EQ(*allocs[i][j], (uint64_t{static_cast<uint32_t>(i)} << 32) | j);
+    }
+  }
+  EXPECT_GT(upb_ThreadSafeArena_SpaceAllocated(a),
+            kThreads * kAllocsPerThread * sizeof(uint64_t));
+  upb_ThreadSafeArena_Free(a);
+}
+
+}  // namespace
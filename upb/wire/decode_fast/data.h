@@ -26,7 +26,9 @@
 //   (or 0 if not a oneof field).
 // - `presence` is either hasbit index or field number for oneofs.
 // - `submsg_index` is the index of the submessage in the mini table's
-//   subs array (or 0 if not a submessage field).
+//   subs array.  For closed enum fields it is instead the index of the field
+//   in the mini table, so the enum table can be found at parse time.  It is
+//   0 for all other fields.
 // - `expected_tag` is the expected value of the tag for this field.
 
 UPB_INLINE bool upb_DecodeFast_MakeData(uint64_t offset, uint64_t case_offset,
@@ -11,9 +11,13 @@
 
 #include "upb/base/internal/endian.h"
 #include "upb/message/message.h"
+#include "upb/mini_table/enum.h"
+#include "upb/mini_table/field.h"
+#include "upb/mini_table/message.h"
 #include "upb/wire/decode.h"
 #include "upb/wire/decode_fast/cardinality.h"
 #include "upb/wire/decode_fast/combinations.h"
+#include "upb/wire/decode_fast/data.h"
 #include "upb/wire/decode_fast/dispatch.h"
 #include "upb/wire/decode_fast/field_parsers.h"
 #include "upb/wire/eps_copy_input_stream.h"
@@ -147,6 +151,162 @@ void upb_DecodeFast_Varint(upb_Decoder* d, const char** ptr, upb_Message* msg,
   }
 }
 
+// Closed enums //////////////////////////////////////////////////////////////
+
+// Closed enum values that are not in the enum must be stored as unknown
+// fields.  The fast parser never does this itself: it validates each value
+// before committing anything, and falls back to the MiniTable decoder (which
+// re-parses from the tag) as soon as it sees a value that is not in the enum.
+
+UPB_FORCEINLINE
+const upb_MiniTableEnum* upb_DecodeFast_GetEnumTable(intptr_t table,
+                                                     uint64_t data) {
+  const upb_MiniTableField* field = upb_MiniTable_GetFieldByIndex(
+      decode_totablep(table), upb_DecodeFastData_GetSubmsgIndex(data));
+  UPB_ASSERT(upb_MiniTableField_IsClosedEnum(field));
+  return upb_MiniTable_GetSubEnumTable(field);
+}
+
+// Reads a single closed enum value.  On success, advances `*ptr` past the
+// value.  If the value is not in the enum, leaves `*ptr` untouched and
+// signals a fallback to the MiniTable decoder.
+UPB_FORCEINLINE
+bool upb_DecodeFast_ReadClosedEnum(upb_Decoder* d, const char** ptr,
+                                   const upb_MiniTableEnum* e, uint32_t* out,
+                                   upb_DecodeFastNext* next) {
+  uint64_t val;
+  const char* p = upb_WireReader_ReadVarint(*ptr, &val, &d->input);
+  if (!p) {
+    return UPB_DECODEFAST_ERROR(d, kUpb_DecodeStatus_Malformed, next);
+  }
+
+  if (UPB_UNLIKELY(!upb_MiniTableEnum_CheckValue(e, val))) {
+    return UPB_DECODEFAST_EXIT(kUpb_DecodeFastNext_FallbackToMiniTable, next);
+  }
+
+  *out = val;
+  *ptr = p;
+  return true;
+}
+
+// Returns true if [ptr, end) is a well-formed sequence of varints that are all
+// members of the enum.  Anything else (including malformed input) is left for
+// the MiniTable decoder to handle.
+static bool upb_DecodeFast_PackedClosedEnumIsValid(const char* ptr,
+                                                   const char* end,
+                                                   const upb_MiniTableEnum* e) {
+  while (ptr < end) {
+    uint64_t val = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      if (ptr == end || shift >= 64) return false;
+      byte = *ptr++;
+      val |= (uint64_t)(byte & 0x7f) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    if (!upb_MiniTableEnum_CheckValue(e, val)) return false;
+  }
+  return true;
+}
+
+UPB_FORCEINLINE
+void upb_DecodeFast_PackedClosedEnum(upb_Decoder* d, const char** ptr,
+                                     upb_Message* msg, intptr_t table,
+                                     uint64_t* hasbits, uint64_t* data,
+                                     upb_DecodeFastNext* ret,
+                                     upb_DecodeFast_Cardinality card,
+                                     upb_DecodeFast_TagSize tagsize) {
+  const upb_DecodeFast_Type type = kUpb_DecodeFast_ClosedEnum;
+  const char* p = *ptr;
+  int size;
+
+  if (!upb_DecodeFast_CheckTag(&p, type, card, tagsize, data,
+                               kUpb_DecodeFastNext_TailCallUnpacked, ret) ||
+      !upb_DecodeFast_DecodeSize(d, &p, &size, ret)) {
+    return;
+  }
+
+  // Once the packed parser has started appending to the array we can no
+  // longer fall back, so every value has to be checked up front.
+  const upb_MiniTableEnum* e = upb_DecodeFast_GetEnumTable(table, *data);
+  if (!upb_EpsCopyInputStream_CheckDataSizeAvailable(&d->input, p, size) ||
+      !upb_DecodeFast_PackedClosedEnumIsValid(p, p + size, e)) {
+    UPB_DECODEFAST_EXIT(kUpb_DecodeFastNext_FallbackToMiniTable, ret);
+    return;
+  }
+
+  upb_DecodeFast_PackedVarintContext ctx = {
+      .decoder = d,
+      .type = type,
+      .msg = msg,
+      .data = data,
+      .hasbits = hasbits,
+      .ret = ret,
+  };
+  upb_DecodeFast_Delimited(d, ptr, type, card, tagsize, data,
+                           &upb_DecodeFast_PackedVarint, ret, &ctx);
+}
+
+UPB_FORCEINLINE
+void upb_DecodeFast_ClosedEnum(upb_Decoder* d, const char** ptr,
+                               upb_Message* msg, intptr_t table,
+                               uint64_t* hasbits, uint64_t* data,
+                               upb_DecodeFastNext* ret,
+                               upb_DecodeFast_Cardinality card,
+                               upb_DecodeFast_TagSize tagsize) {
+  const upb_DecodeFast_Type type = kUpb_DecodeFast_ClosedEnum;
+
+  if (card == kUpb_DecodeFast_Packed) {
+    upb_DecodeFast_PackedClosedEnum(d, ptr, msg, table, hasbits, data, ret,
+                                    card, tagsize);
+    return;
+  }
+
+  const char* p = *ptr;
+  if (!upb_DecodeFast_CheckTag(&p, type, card, tagsize, data,
+                               kUpb_DecodeFastNext_TailCallPacked, ret)) {
+    return;
+  }
+
+  const upb_MiniTableEnum* e = upb_DecodeFast_GetEnumTable(table, *data);
+  uint32_t val;
+  if (!upb_DecodeFast_ReadClosedEnum(d, &p, e, &val, ret)) return;
+
+  void* dst;
+  if (upb_DecodeFast_GetScalarField(d, p, msg, *data, hasbits, ret, &dst,
+                                    card)) {
+    memcpy(dst, &val, sizeof(val));
+    *ptr = p;
+    _upb_Decoder_Trace(d, 'F');
+    return;
+  }
+
+  upb_DecodeFastArray arr;
+  if (!upb_DecodeFast_GetArrayForAppend(d, *ptr, msg, *data, hasbits, &arr,
+                                        type, 1, ret)) {
+    return;
+  }
+
+  while (true) {
+    memcpy(arr.dst, &val, sizeof(val));
+    *ptr = p;
+    _upb_Decoder_Trace(d, 'F');
+    bool next_tag_matches =
+        upb_DecodeFast_TryMatchTag(d, p, arr.expected_tag, ret, tagsize);
+    if (!upb_DecodeFast_NextRepeated(d, &p, ret, &arr, next_tag_matches, type,
+                                     tagsize)) {
+      return;
+    }
+    if (!upb_DecodeFast_ReadClosedEnum(d, &p, e, &val, ret)) {
+      // Keep the values we already stored; the MiniTable decoder resumes at
+      // the tag of the rejected value.
+      upb_DecodeFastField_SetArraySize(&arr, type);
+      return;
+    }
+  }
+}
+
 /* Generate all combinations:
  * {s,o,r,p} x {b1,v4,z4,v8,z8} x {1bt,2bt} */
 
@@ -169,3 +329,19 @@ UPB_DECODEFAST_CARDINALITIES(UPB_DECODEFAST_TAGSIZES, F, ZigZag32)
 UPB_DECODEFAST_CARDINALITIES(UPB_DECODEFAST_TAGSIZES, F, ZigZag64)
 
 #undef F
+
+#define F(type, card, tagsize)                                             \
+  UPB_NOINLINE UPB_PRESERVE_NONE const char* UPB_DECODEFAST_FUNCNAME(      \
+      type, card, tagsize)(UPB_PARSE_PARAMS) {                             \
+    upb_DecodeFastNext next = kUpb_DecodeFastNext_Dispatch;                \
+    upb_DecodeFast_ClosedEnum(d, &ptr, msg, table, &hasbits, &data, &next, \
+                              kUpb_DecodeFast_##card,                      \
+                              kUpb_DecodeFast_##tagsize);                  \
+    UPB_DECODEFAST_NEXTMAYBEPACKED(                                        \
+        next, UPB_DECODEFAST_FUNCNAME(type, Repeated, tagsize),            \
+        UPB_DECODEFAST_FUNCNAME(type, Packed, tagsize));                   \
+  }
+
+UPB_DECODEFAST_CARDINALITIES(UPB_DECODEFAST_TAGSIZES, F, ClosedEnum)
+
+#undef F
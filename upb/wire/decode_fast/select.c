@@ -102,10 +102,15 @@ static bool upb_DecodeFast_GetFieldType(const upb_MiniTable* m,
   //  - kUpb_FieldType_Enum -> kUpb_FieldType_Int32 if the enum is open.
   upb_FieldType type = field->UPB_PRIVATE(descriptortype);
 
-  if (type == kUpb_FieldType_Group || upb_MiniTableField_IsClosedEnum(field)) {
+  if (type == kUpb_FieldType_Group) {
     return false;  // Currently not supported.
   }
 
+  if (upb_MiniTableField_IsClosedEnum(field)) {
+    *out_type = kUpb_DecodeFast_ClosedEnum;
+    return true;
+  }
+
   static const int8_t types[] = {
       [kUpb_FieldType_Bool] = kUpb_DecodeFast_Bool,
       [kUpb_FieldType_Enum] = kUpb_DecodeFast_Varint32,
@@ -160,16 +165,27 @@ static uint64_t upb_DecodeFast_GetPresence(const upb_MiniTableField* field,
   }
 }
 
-static bool upb_DecodeFast_GetFunctionData(const upb_MiniTableField* field,
+static uint64_t upb_DecodeFast_GetSubIndex(const upb_MiniTable* m,
+                                           const upb_MiniTableField* field) {
+  if (upb_MiniTableField_IsSubMessage(field)) {
+    return field->UPB_PRIVATE(submsg_ofs);
+  } else if (upb_MiniTableField_IsClosedEnum(field)) {
+    // The parser needs the field itself to find the enum table.
+    return field - upb_MiniTable_GetFieldByIndex(m, 0);
+  } else {
+    return 0;
+  }
+}
+
+static bool upb_DecodeFast_GetFunctionData(const upb_MiniTable* m,
+                                           const upb_MiniTableField* field,
                                            uint16_t tag, uint64_t* out_data) {
   uint64_t offset = UPB_PRIVATE(_upb_MiniTableField_Offset)(field);
   uint64_t case_offset =
       upb_MiniTableField_IsInOneof(field)
           ? UPB_PRIVATE(_upb_MiniTableField_OneofOffset)(field)
           : 0;
-  uint64_t submsg_index = upb_MiniTableField_IsSubMessage(field)
-                              ? field->UPB_PRIVATE(submsg_ofs)
-                              : 0;
+  uint64_t submsg_index = upb_DecodeFast_GetSubIndex(m, field);
 
   uint64_t presence;
 
@@ -191,7 +207,7 @@ static bool upb_DecodeFast_TryFillEntry(const upb_MiniTable* m,
              upb_DecodeFast_GetType(entry->function_idx),
              upb_DecodeFast_GetCardinality(entry->function_idx),
              upb_DecodeFast_GetTagSize(entry->function_idx)) &&
-         upb_DecodeFast_GetFunctionData(field, tag, &entry->function_data);
+         upb_DecodeFast_GetFunctionData(m, field, tag, &entry->function_data);
 }
 
 int upb_DecodeFast_BuildTable(const upb_MiniTable* m,
@@ -293,6 +293,74 @@ TYPED_TEST(PackedTest, DecodeUnpackedDataForPackedField) {
             ExpectedRepeatedFieldTrace(mt, field, 3));
 }
 
+std::string GetUnknownFields(const upb_Message* msg) {
+  std::string ret;
+  upb_StringView data;
+  uintptr_t iter = kUpb_Message_UnknownBegin;
+  while (upb_Message_NextUnknown(msg, &data, &iter)) {
+    ret.append(data.data, data.size);
+  }
+  return ret;
+}
+
+TEST(ClosedEnumTest, UnknownScalarValueGoesToUnknownFields) {
+  using TypeParam = field_types::ClosedEnum;
+  upb::Arena arena;
+  auto [mt, field] = MiniTable::MakeSingleFieldTable<TypeParam>(
+      1, kUpb_DecodeFast_Scalar, arena.ptr());
+  upb_Message* msg = upb_Message_New(mt, arena.ptr());
+  std::string unknown =
+      ToBinaryPayload(wire_types::WireMessage{{1, TypeParam::WireValue(3)}});
+  upb_DecodeStatus result = upb_Decode(unknown.data(), unknown.size(), msg, mt,
+                                       nullptr, 0, arena.ptr());
+  ASSERT_EQ(result, kUpb_DecodeStatus_Ok) << upb_DecodeStatus_String(result);
+  EXPECT_EQ(GetOptionalField<int32_t>(msg, field), std::nullopt);
+  EXPECT_EQ(GetUnknownFields(msg), unknown);
+}
+
+TEST(ClosedEnumTest, UnknownRepeatedValueGoesToUnknownFields) {
+  using TypeParam = field_types::ClosedEnum;
+  upb::Arena msg_arena;
+  upb::Arena mt_arena;
+  auto [mt, field] = MiniTable::MakeSingleFieldTable<TypeParam>(
+      1, kUpb_DecodeFast_Repeated, mt_arena.ptr());
+  upb_Message* msg = upb_Message_New(mt, msg_arena.ptr());
+  std::string payload = ToBinaryPayload(wire_types::WireMessage{
+      {1, TypeParam::WireValue(1)},
+      {1, TypeParam::WireValue(2)},
+      {1, TypeParam::WireValue(-1)},
+      {1, TypeParam::WireValue(1 << 10)},
+  });
+  upb_DecodeStatus result = upb_Decode(payload.data(), payload.size(), msg, mt,
+                                       nullptr, 0, msg_arena.ptr());
+  ASSERT_EQ(result, kUpb_DecodeStatus_Ok) << upb_DecodeStatus_String(result);
+  EXPECT_EQ(GetRepeatedField<int32_t>(msg, field),
+            (std::vector<int32_t>{1, 2, 1 << 10}));
+  EXPECT_EQ(GetUnknownFields(msg), ToBinaryPayload(wire_types::WireMessage{
+                                       {1, TypeParam::WireValue(-1)}}));
+}
+
+TEST(ClosedEnumTest, UnknownPackedValueGoesToUnknownFields) {
+  using TypeParam = field_types::ClosedEnum;
+  upb::Arena msg_arena;
+  upb::Arena mt_arena;
+  auto [mt, field] = MiniTable::MakeSingleFieldTable<TypeParam>(
+      1, kUpb_DecodeFast_Packed, mt_arena.ptr());
+  upb_Message* msg = upb_Message_New(mt, msg_arena.ptr());
+  std::string packed_value = ToBinaryPayload(TypeParam::WireValue(1)) +
+                             ToBinaryPayload(TypeParam::WireValue(7)) +
+                             ToBinaryPayload(TypeParam::WireValue(1 << 20));
+  std::string payload = ToBinaryPayload(
+      wire_types::WireMessage{{1, wire_types::Delimited{packed_value}}});
+  upb_DecodeStatus result = upb_Decode(payload.data(), payload.size(), msg, mt,
+                                       nullptr, 0, msg_arena.ptr());
+  ASSERT_EQ(result, kUpb_DecodeStatus_Ok) << upb_DecodeStatus_String(result);
+  EXPECT_EQ(GetRepeatedField<int32_t>(msg, field),
+            (std::vector<int32_t>{1, 1 << 20}));
+  EXPECT_EQ(GetUnknownFields(msg), ToBinaryPayload(wire_types::WireMessage{
+                                       {1, TypeParam::WireValue(7)}}));
+}
+
 TEST(RepeatedFieldTest, LongRepeatedField) {
   auto trace_buf = std::make_unique<std::array<char, 1024>>();
   using TypeParam = field_types::Fixed64;
@@ -224,7 +224,23 @@ struct Bytes {
   }
 };
 
-// TODO: Message, Group, ClosedEnum
+// Closed enum fields are linked to an enum containing kClosedEnumValues (see
+// make_mini_table.h).
+struct ClosedEnum {
+  using Value = int32_t;
+  inline static constexpr upb_FieldType kFieldType = kUpb_FieldType_Enum;
+  inline static constexpr absl::string_view kName = "ClosedEnum";
+  inline static constexpr upb_DecodeFast_Type kFastType =
+      kUpb_DecodeFast_ClosedEnum;
+
+  template <class T>
+  static wire_types::WireValue WireValue(T value) {
+    // Need to sign-extend to 64-bit varint.
+    return wire_types::Varint(static_cast<int64_t>(static_cast<Value>(value)));
+  }
+};
+
+// TODO: Message, Group
 
 }  // namespace field_types
 
@@ -233,7 +249,8 @@ using PackableFieldTypes =
                    field_types::SFixed32, field_types::SFixed64,
                    field_types::Float, field_types::Double, field_types::Int32,
                    field_types::Int64, field_types::UInt32, field_types::UInt64,
-                   field_types::SInt32, field_types::SInt64, field_types::Bool>;
+                   field_types::SInt32, field_types::SInt64, field_types::Bool,
+                   field_types::ClosedEnum>;
 
 using FieldTypes =
     testing::Types<field_types::Fixed32, field_types::Fixed64,
@@ -14,9 +14,12 @@
 #include "absl/log/log.h"
 #include "upb/base/status.hpp"
 #include "upb/mem/arena.h"
+#include "upb/mini_descriptor/build_enum.h"
 #include "upb/mini_descriptor/decode.h"
 #include "upb/mini_descriptor/internal/encode.hpp"
 #include "upb/mini_descriptor/internal/modifiers.h"
+#include "upb/mini_descriptor/link.h"
+#include "upb/mini_table/enum.h"
 #include "upb/mini_table/field.h"
 #include "upb/mini_table/message.h"
 #include "upb/wire/decode_fast/combinations.h"
@@ -36,6 +39,9 @@ int FieldModifiers(upb_DecodeFast_Type type,
     case kUpb_DecodeFast_String:
       modifiers |= kUpb_FieldModifier_ValidateUtf8;
       break;
+    case kUpb_DecodeFast_ClosedEnum:
+      modifiers |= kUpb_FieldModifier_IsClosedEnum;
+      break;
     default:
       break;
   }
@@ -47,11 +53,27 @@ int FieldModifiers(upb_DecodeFast_Type type,
       modifiers |= kUpb_FieldModifier_IsRepeated | kUpb_FieldModifier_IsPacked;
       break;
     default:
-      return 0;
+      // Of the type modifiers, singular fields only take IsClosedEnum.
+      return modifiers & kUpb_FieldModifier_IsClosedEnum;
   }
   return modifiers;
 }
 
+const upb_MiniTableEnum* MakeClosedEnum(upb_Arena* arena) {
+  MtDataEncoder encoder;
+  encoder.StartEnum();
+  for (int32_t value : kClosedEnumValues) {
+    encoder.PutEnumValue(value);
+  }
+  encoder.EndEnum();
+  const std::string& data = encoder.data();
+  upb::Status status;
+  const upb_MiniTableEnum* e =
+      upb_MiniTableEnum_Build(data.data(), data.size(), arena, status.ptr());
+  ABSL_CHECK(status.ok()) << status.error_message();
+  return e;
+}
+
 std::pair<const upb_MiniTable*, const upb_MiniTableField*>
 MiniTable::MakeSingleFieldTable(int field_number, upb_FieldType type,
                                 upb_DecodeFast_Type fast_type,
@@ -66,11 +88,15 @@ MiniTable::MakeSingleFieldTable(int field_number, upb_FieldType type,
   }
   const std::string& data = encoder.data();
   upb::Status status;
-  const upb_MiniTable* table =
+  upb_MiniTable* table =
       upb_MiniTable_Build(data.data(), data.size(), arena, status.ptr());
   ABSL_CHECK(status.ok()) << status.error_message();
   const upb_MiniTableField* field = upb_MiniTable_GetFieldByIndex(table, 0);
   ABSL_CHECK(field != nullptr);
+  if (fast_type == kUpb_DecodeFast_ClosedEnum) {
+    ABSL_CHECK(upb_MiniTable_SetSubEnum(
+        table, const_cast<upb_MiniTableField*>(field), MakeClosedEnum(arena)));
+  }
 #if UPB_FASTTABLE
   if (field_number < (1 << 11)) {
     ABSL_CHECK_EQ(HasFastTableEntry(table, field),
@@ -8,6 +8,7 @@
 #ifndef UPB_MINI_TABLE_TEST_UTIL_MAKE_MINI_TABLE_H_
 #define UPB_MINI_TABLE_TEST_UTIL_MAKE_MINI_TABLE_H_
 
+#include <cstdint>
 #include <utility>
 
 #include "upb/base/descriptor_constants.h"
@@ -19,6 +20,10 @@
 namespace upb {
 namespace test {
 
+// The values of the enum that closed enum fields are linked to.  The packed
+// tests rely on 0, 1 << 10 and 1 << 20 being members.
+inline constexpr int32_t kClosedEnumValues[] = {0, 1, 2, 1 << 10, 1 << 20};
+
 class MiniTable {
  public:
   template <typename Field>